@@ -27,6 +27,7 @@ sudo apt-get update
 sudo apt-get install libiw-dev libsqlite3-dev libffi-dev -y # lib dependencies
 sudo apt-get install python3-full python3-dev python3-pip python3-requests -y # python package dependencies
 sudo apt-get install sqlite3 wireless-tools net-tools -y # sys bin tool dependencies
+sudo apt-get install ieee-data -y # OUI vendor registry
 
 
 # Python3 modules
@@ -45,11 +46,15 @@ title "Building dev libraries"
 
 cd wipy
 
+# Also generates src/wipi_oui_db.h, which the daemon needs too
 python3 setup.py build
 python3 setup.py install
 
 cd ..
 
+gcc -O2 -o src/wipi-sensord src/wipi_sensord.c src/wipi_shm.c src/wipi_enc.c src/wipi_oui.c src/wipi_cadence.c \
+	src/wipi_group.c src/wipi_aptable.c src/wipi.c src/wipi_stats.c src/wipi_ie.c -liw -lpthread -lm -lrt
+
 
 # API setup
 
@@ -61,7 +66,7 @@ mkdir www/keys
 rm www/db/wiapi.db 2>/dev/null
 touch www/db/wiapi.db
 sqlite3 www/db/wiapi.db "CREATE TABLE users(id INTEGER PRIMARY KEY AUTOINCREMENT, username TEXT NOT NULL UNIQUE, password TEXT NOT NULL, admin INTEGER)"
-sqlite3 www/db/wiapi.db "CREATE TABLE jobs(id INTEGER PRIMARY KEY AUTOINCREMENT, interface TEXT NOT NULL, bssid TEXT NOT NULL, start INTEGER, packets INTEGER NOT NULL, delay INTEGER NOT NULL, complete INTEGER)"
+sqlite3 www/db/wiapi.db "CREATE TABLE jobs(id INTEGER PRIMARY KEY AUTOINCREMENT, interface TEXT NOT NULL, bssid TEXT NOT NULL, start INTEGER, packets INTEGER NOT NULL, delay INTEGER NOT NULL, complete INTEGER, sent INTEGER DEFAULT 0, state TEXT)"
 
 python3 -c "import sqlite3, hashlib; conn = sqlite3.connect('www/db/wiapi.db'); p = hashlib.sha256('${DEFAULT_API_ADMIN_PASSWORD}'.encode()).digest(); cur = conn.cursor(); cur.execute('INSERT INTO users(username, password, admin) VALUES(?, ?, ?)', ('${DEFAULT_API_ADMIN_USERNAME}', p, 1,)); conn.commit()"
 
@@ -28,17 +28,35 @@
 #endif
 
 /*    EXTERNS    */
-WIPI_STATUS WIPI_ERRNO = WIPI_ERR_OK;
+__thread WIPI_STATUS WIPI_ERRNO = WIPI_ERR_OK;
 
 /*    FUNCTION DEFINITIONS    */
+int wipi_mac_aton(const char* __restrict__ str, uint8_t* mac)
+{
+    int n;
+
+    n = 0;
+
+    if (str == NULL ||
+        sscanf(str, "%2hhx:%2hhx:%2hhx:%2hhx:%2hhx:%2hhx%n",
+               &mac[0], &mac[1], &mac[2], &mac[3], &mac[4], &mac[5], &n) != 6 ||
+        str[n] != '\0')
+        return -1;
+
+    return 0;
+}
+
 __attribute__((__pure__))
 __wur
 struct __wipi_interface_t* wipi_get_interfaces(uint32_t sa_family)
 {
     struct ifaddrs*             ifa, *ifp;
     struct __wipi_interface_t*  wiface, *wifh;
+    uint64_t                    t0;
+
+    t0 = wipi_stats_now();
 
-    wifh = (struct __wipi_interface_t*)malloc( sizeof(struct __wipi_interface_t) );
+    wifh = (struct __wipi_interface_t*)WIPI_ALLOC( sizeof(struct __wipi_interface_t) );
     assert(wifh != NULL);
 
     wiface = wifh;
@@ -60,7 +78,7 @@ struct __wipi_interface_t* wipi_get_interfaces(uint32_t sa_family)
         wiface->if_flags = ifp->ifa_flags; 
         wiface->if_mon   = wipi_interface_monitor_mode(wiface);
 
-        wiface->next = (struct __wipi_interface_t*)malloc( sizeof(struct __wipi_interface_t) );
+        wiface->next = (struct __wipi_interface_t*)WIPI_ALLOC( sizeof(struct __wipi_interface_t) );
         assert(wiface->next != NULL);
 
         wiface = wiface->next;
@@ -70,6 +88,8 @@ struct __wipi_interface_t* wipi_get_interfaces(uint32_t sa_family)
 
     freeifaddrs(ifa);
 
+    wipi_stats_observe(WIPI_HIST_IFACE, wipi_stats_now() - t0);
+
     return wifh;
 }
 
@@ -116,7 +136,7 @@ struct __wipi_scanner_t* wipi_scanner_init(const char* __restrict__ iface)
 {
     struct __wipi_scanner_t*    ws;
 
-    ws = (struct __wipi_scanner_t*)malloc( sizeof(struct __wipi_scanner_t) );
+    ws = (struct __wipi_scanner_t*)WIPI_ALLOC( sizeof(struct __wipi_scanner_t) );
 
     assert(ws != NULL);
 
@@ -146,37 +166,44 @@ struct __wipi_scanner_t* wipi_scanner_init(const char* __restrict__ iface)
 void wipi_populate_beacon(struct __wipi_beacon_t* wb,
                           struct __wipi_scanner_t* ws)
 {
-    char*   tok;
-    double  dref;
+    struct __wipi_scan_res_t*   sr;
 
     memset( wb, 0, sizeof(struct __wipi_beacon_t) );
 
     strncpy(wb->ssid, ws->res->b.essid, WIPI_MAX_SSID);
 
     if (ws->res->has_ap_addr)
+    {
         iw_sawap_ntop(&ws->res->ap_addr, wb->bssid);
+        memcpy(wb->addr, ws->res->ap_addr.sa_data, WIPI_MAC_LEN);
+    }
+
+    wb->seen = wipi_stats_now();
 
     if (ws->res->b.has_freq)
     {
-        iw_print_freq_value(wb->cfreq, WIPI_MAX_FREQ, ws->res->b.freq);
-
-        tok = strtok(wb->cfreq, " ");
+        /* Either Hz, or a bare channel number if that's all the driver gave */
+        if (ws->res->b.freq >= 1000)
+            wb->freq_mhz = (uint16_t)lround(ws->res->b.freq / 1000000);
+        else
+            wb->freq_mhz = wipi_channel_freq((int)ws->res->b.freq,
+                                             ws->res->b.freq <= 14 ? WIPI_BAND_2G : WIPI_BAND_5G);
+
+        wb->channel = wipi_freq_channel(wb->freq_mhz);
+        wb->band = wipi_freq_band(wb->freq_mhz);
+        wb->freq = (double)wb->freq_mhz / 1000; /* MHz to GHz */
+    }
 
-        if (tok)
-        {
-            wb->freq = strtod(tok, NULL);
-            wb->freq = wb->freq;
+    sr = (struct __wipi_scan_res_t*)ws->res;
 
-            for (int i = 0; i < ws->iwr.num_frequency; i++)
-            {
-                dref = iw_freq2float(&(ws->iwr.freq[i]));
-                dref /= 1000000000; /* Hz to GHz */
+    wb->ie = sr->ie;
+    wb->ie_len = sr->ie_len;
 
-                if (wb->freq == dref)
-                    wb->channel = ws->iwr.freq[i].i;
-            }
-        }
-    }
+    /* WEXT has no capability field, but the encode flag is the privacy bit */
+    wipi_ie_parse(wb->ie,
+                  wb->ie_len,
+                  ws->res->b.has_key && !(ws->res->b.key_flags & IW_ENCODE_DISABLED) ? WIPI_CAPAB_PRIVACY : 0,
+                  &wb->caps);
 
     if (ws->res->has_stats)
     {
@@ -191,48 +218,276 @@ void wipi_populate_beacon(struct __wipi_beacon_t* wb,
     }
 }
 
+int wipi_scanner_trigger(struct __wipi_scanner_t* ws,
+                         const int* freqs,
+                         int nfreqs)
+{
+    struct iwreq        wrq;
+    struct iw_scan_req  req;
+
+    assert(ws != NULL);
+
+    memset( &wrq, 0, sizeof(wrq) );
+    memset( &req, 0, sizeof(req) );
+
+    if (freqs && nfreqs > 0)
+    {
+        req.num_channels = nfreqs < IW_MAX_FREQUENCIES ? nfreqs : IW_MAX_FREQUENCIES;
+
+        for (int i = 0; i < req.num_channels; i++)
+            iw_float2freq((double)freqs[i] * 1e6, &req.channel_list[i]);
+
+        wrq.u.data.pointer = (caddr_t)&req;
+        wrq.u.data.length  = sizeof(req);
+        wrq.u.data.flags   = IW_SCAN_THIS_FREQ;
+    }
+
+    /* Unprivileged callers can't trigger, but can still read cached results */
+    if (iw_set_ext(ws->sockets, ws->iface, SIOCSIWSCAN, &wrq) < 0 && errno != EPERM)
+    {
+        WIPI_ERRNO = ws->status = WIPI_ERR_SCAN;
+
+        return -1;
+    }
+
+    ws->triggered = wipi_stats_now();
+    ws->status = WIPI_ERR_OK;
+
+    return 0;
+}
+
+static void wipi_scanner_results_free(struct __wipi_scanner_t* ws)
+{
+    wireless_scan*  res, *next;
+
+    for (res = ws->wsh.result; res; res = next)
+    {
+        next = res->next;
+
+        free( ((struct __wipi_scan_res_t*)res)->ie );
+        free(res);
+    }
+
+    ws->wsh.result = NULL;
+    ws->res = NULL;
+}
+
+static void wipi_scanner_parse(struct __wipi_scanner_t* ws, int len)
+{
+    struct stream_descr         stream;
+    struct iw_event             iwe;
+    struct __wipi_scan_res_t*   sr;
+    wireless_scan*              res, **tail;
+    double                      freq;
+
+    res = NULL;
+    tail = &ws->wsh.result;
+
+    iw_init_event_stream(&stream, ws->scan_buf, len);
+
+    while (iw_extract_event_stream(&stream, &iwe, ws->iwr.we_version_compiled) > 0)
+    {
+        /* Every cell starts with its BSSID */
+        if (iwe.cmd == SIOCGIWAP)
+        {
+            res = (wireless_scan*)WIPI_ALLOC( sizeof(struct __wipi_scan_res_t) );
+            assert(res != NULL);
+
+            memset( res, 0, sizeof(struct __wipi_scan_res_t) );
+            memcpy( &res->ap_addr, &iwe.u.ap_addr, sizeof(res->ap_addr) );
+
+            res->has_ap_addr = 1;
+
+            *tail = res;
+            tail = &res->next;
+
+            continue;
+        }
+
+        if (res == NULL)
+            continue;
+
+        switch (iwe.cmd)
+        {
+            case SIOCGIWFREQ:
+                freq = iw_freq2float(&iwe.u.freq);
+
+                /* Drivers report the channel number first, then the frequency */
+                if (!res->b.has_freq || freq >= 1000)
+                {
+                    res->b.has_freq = 1;
+                    res->b.freq = freq;
+                    res->b.freq_flags = iwe.u.freq.flags;
+                }
+
+                break;
+
+            case SIOCGIWESSID:
+                res->b.has_essid = 1;
+                res->b.essid_on = iwe.u.essid.flags;
+
+                if (iwe.u.essid.pointer && iwe.u.essid.length)
+                    memcpy( res->b.essid,
+                            iwe.u.essid.pointer,
+                            iwe.u.essid.length < IW_ESSID_MAX_SIZE ? iwe.u.essid.length : IW_ESSID_MAX_SIZE );
+
+                break;
+
+            case SIOCGIWMODE:
+                res->b.has_mode = 1;
+                res->b.mode = iwe.u.mode;
+
+                break;
+
+            case SIOCGIWENCODE:
+                res->b.has_key = 1;
+                res->b.key_flags = iwe.u.data.flags;
+
+                break;
+
+            case IWEVQUAL:
+                res->has_stats = 1;
+                memcpy( &res->stats.qual, &iwe.u.qual, sizeof(iwqual) );
+
+                break;
+
+            case IWEVGENIE:
+                /* The kernel splits long IE lists across several events */
+                sr = (struct __wipi_scan_res_t*)res;
+
+                if (iwe.u.data.pointer == NULL || iwe.u.data.length == 0 ||
+                    sr->ie_len + iwe.u.data.length > 0xFFFF)
+                    break;
+
+                sr->ie = (uint8_t*)realloc(sr->ie, sr->ie_len + iwe.u.data.length);
+                assert(sr->ie != NULL);
+
+                memcpy(sr->ie + sr->ie_len, iwe.u.data.pointer, iwe.u.data.length);
+                sr->ie_len += iwe.u.data.length;
+
+                break;
+
+            case SIOCGIWRATE:
+                res->has_maxbitrate = 1;
+
+                if (iwe.u.bitrate.value > res->maxbitrate.value)
+                    res->maxbitrate.value = iwe.u.bitrate.value;
+
+                break;
+        }
+    }
+}
+
+int wipi_scanner_collect(struct __wipi_scanner_t* ws)
+{
+    struct iwreq    wrq;
+
+    assert(ws != NULL);
+
+    if (ws->scan_buf == NULL)
+    {
+        ws->scan_buflen = WIPI_SCAN_BUFLEN;
+        ws->scan_buf = (char*)WIPI_ALLOC(ws->scan_buflen);
+
+        assert(ws->scan_buf != NULL);
+    }
+
+    for (;;)
+    {
+        memset( &wrq, 0, sizeof(wrq) );
+
+        wrq.u.data.pointer = ws->scan_buf;
+        wrq.u.data.length  = ws->scan_buflen > 0xFFFF ? 0xFFFF : ws->scan_buflen;
+
+        if (iw_get_ext(ws->sockets, ws->iface, SIOCGIWSCAN, &wrq) == 0)
+            break;
+
+        if (errno == EAGAIN)
+            return 0;
+
+        /* Results don't fit - the kernel may tell us how much it needs */
+        if (errno == E2BIG && ws->scan_buflen < 0xFFFF)
+        {
+            ws->scan_buflen = wrq.u.data.length > ws->scan_buflen ? wrq.u.data.length : ws->scan_buflen * 2;
+            ws->scan_buf = (char*)realloc(ws->scan_buf, ws->scan_buflen);
+
+            assert(ws->scan_buf != NULL);
+
+            continue;
+        }
+
+        WIPI_ERRNO = ws->status = WIPI_ERR_SCAN;
+
+        return -1;
+    }
+
+    wipi_scanner_results_free(ws);
+    wipi_scanner_parse(ws, wrq.u.data.length);
+
+    return 1;
+}
+
 __wur
 struct __wipi_beacon_t* wipi_scanner_scan(struct __wipi_scanner_t* ws)
 {
     struct __wipi_beacon_t* wb, *wbh;
+    uint64_t                t0;
+    int                     done;
 
-    wb = (struct __wipi_beacon_t*)malloc( sizeof(struct __wipi_beacon_t) );
+    t0 = wipi_stats_now();
 
-    assert(wb != NULL);
+    if (wipi_scanner_trigger(ws, NULL, 0) < 0)
+    {
+        wipi_stats_add(WIPI_STAT_SCAN_ERRORS, 1);
+
+        return NULL;
+    }
+
+    while ((done = wipi_scanner_collect(ws)) == 0)
+    {
+        if (wipi_stats_now() - t0 > WIPI_SCAN_TIMEOUT_MS * 1000000ULL)
+        {
+            WIPI_ERRNO = ws->status = WIPI_ERR_SCAN;
+            done = -1;
+
+            break;
+        }
+
+        usleep(WIPI_SCAN_POLL_US);
+    }
 
-    if (iw_scan(ws->sockets,
-                ws->iface,
-                ws->iwr.we_version_compiled,
-                &ws->wsh) < 0)
+    if (done < 0)
     {
-        WIPI_ERRNO = WIPI_ERR_SCAN;
+        wipi_stats_add(WIPI_STAT_SCAN_ERRORS, 1);
 
         return NULL;
     }
 
-    // iw_sockets_close(ws->sockets);
+    wipi_stats_observe(WIPI_HIST_SCAN, wipi_stats_now() - t0);
+    wipi_stats_add(WIPI_STAT_SCANS, 1);
 
-    wbh = wb;
-    ws->res = ws->wsh.result;
+    wb = wbh = (struct __wipi_beacon_t*)WIPI_ALLOC( sizeof(struct __wipi_beacon_t) );
+    assert(wb != NULL);
 
-    do
+    /* The list always ends with an empty node, so callers can walk ->next */
+    for (ws->res = ws->wsh.result; ws->res; ws->res = ws->res->next)
     {
-        wipi_populate_beacon(wb, ws);
+        t0 = wipi_stats_now();
 
-        wb->next = NULL;
+        wipi_populate_beacon(wb, ws);
 
-        if (ws->res->next != NULL)
-        {
-            wb->next = (struct __wipi_beacon_t*)malloc( sizeof(struct __wipi_beacon_t) );
+        wipi_stats_observe(WIPI_HIST_PARSE, wipi_stats_now() - t0);
+        wipi_stats_add(WIPI_STAT_SCAN_APS, 1);
 
-            wb = wb->next;
+        wb->head = wbh;
+        wb->next = (struct __wipi_beacon_t*)WIPI_ALLOC( sizeof(struct __wipi_beacon_t) );
+        assert(wb->next != NULL);
 
-            wb->head = wbh;
-            wb->next = NULL;
+        wb = wb->next;
+    }
 
-            ws->res = ws->res->next;
-        }
-    } while (ws->res->next != NULL);
+    memset( wb, 0, sizeof(struct __wipi_beacon_t) );
+    wb->head = wbh;
 
     return wbh;
 }
@@ -276,6 +531,7 @@ int wipi_mon_socket(struct __wipi_interface_t* wi)
     if (ioctl(sockfd, SIOCGIFINDEX, &ifr) < 0)
     {
         WIPI_ERRNO = WIPI_ERR_SOCKFD;
+        close(sockfd);
 
         return -1;
     }
@@ -289,6 +545,7 @@ int wipi_mon_socket(struct __wipi_interface_t* wi)
     if (bind( sockfd, (struct sockaddr*)&ll, sizeof(ll) ) < 0)
     {
         WIPI_ERRNO = WIPI_ERR_SOCKFD;
+        close(sockfd);
 
         return -1;
     }
@@ -296,16 +553,67 @@ int wipi_mon_socket(struct __wipi_interface_t* wi)
     return sockfd;
 }
 
+int wipi_mon_socket_stats(int sockfd)
+{
+    struct tpacket_stats    tps;
+    socklen_t               len;
+
+    len = sizeof(tps);
+
+    /* Reading PACKET_STATISTICS resets the kernel counters, so fold them in */
+    if (getsockopt(sockfd, SOL_PACKET, PACKET_STATISTICS, &tps, &len) < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_SOCKFD;
+
+        return -1;
+    }
+
+    wipi_stats_add(WIPI_STAT_CAP_FRAMES, tps.tp_packets - tps.tp_drops); /* tp_packets includes drops */
+    wipi_stats_add(WIPI_STAT_CAP_DROPS, tps.tp_drops);
+
+    return (int)tps.tp_drops;
+}
+
+void wipi_deauth_frame(uint8_t* packet,
+                       const uint8_t* bssid)
+{
+    packet[0]  = 0x00;
+    packet[1]  = 0x00;
+    packet[2]  = 0x0C;
+    packet[3]  = 0x00;
+    packet[4]  = 0x04;
+    packet[5]  = 0x80;
+    packet[6]  = 0x00;
+    packet[7]  = 0x00;
+    packet[8]  = 0x02;
+    packet[9]  = 0x00;
+    packet[10] = 0x18;
+    packet[11] = 0x00;
+    packet[12] = 0xC0;
+    packet[13] = 0x00;
+    packet[14] = 0x3A;
+    packet[15] = 0x01;
+
+    memset(packet + 16, 0xFF, 6);
+    memcpy(packet + 22, bssid, 6);
+    memcpy(packet + 28, bssid, 6);
+
+    packet[34] = 0xF0;
+    packet[35] = 0x3F;
+    packet[36] = 0x07;
+    packet[37] = 0x00;
+}
+
 int wipi_deauth(struct __wipi_interface_t* wi,
                 const char* __restrict__ bssid,
                 int packets,
                 int delay)
 {
     int     sockfd, sent;
-    uint8_t packet[38], b[6], tmp[3];
+    uint8_t packet[WIPI_DEAUTH_LEN], b[6], tmp[3];
 
     assert(wi != NULL);
-    assert(wb != NULL);
+    assert(bssid != NULL);
 
     if (!wi->if_mon)
     {
@@ -334,46 +642,28 @@ int wipi_deauth(struct __wipi_interface_t* wi,
         b[i] = strtoul((char*)tmp, NULL, 16);
     }
 
-    packet[0]  = 0x00;
-    packet[1]  = 0x00;
-    packet[2]  = 0x0C;
-    packet[3]  = 0x00;
-    packet[4]  = 0x04;
-    packet[5]  = 0x80;
-    packet[6]  = 0x00;
-    packet[7]  = 0x00;
-    packet[8]  = 0x02;
-    packet[9]  = 0x00;
-    packet[10] = 0x18;
-    packet[11] = 0x00;
-    packet[12] = 0xC0;
-    packet[13] = 0x00;
-    packet[14] = 0x3A;
-    packet[15] = 0x01;
-
-    memset(packet + 16, 0xFF, 6);
-    memcpy(packet + 22, b, 6);
-    memcpy(packet + 28, b, 6);
-
-    packet[34] = 0xF0;
-    packet[35] = 0x3F;
-    packet[36] = 0x07;
-    packet[37] = 0x00;
+    wipi_deauth_frame(packet, b);
 
     sent = 0;
 
     for (int i = 0; i < packets; i++)
     {
-        sent += send(sockfd, packet, 38, 0) < 0 ? 0 : 1;
+        sent += send(sockfd, packet, WIPI_DEAUTH_LEN, 0) < 0 ? 0 : 1;
 
         usleep(delay * 1000);
     }
 
+    close(sockfd);
+
     return sent;
 }
 
 void wipi_scanner_free(struct __wipi_scanner_t* ws)
 {
+    wipi_scanner_results_free(ws);
+    free(ws->scan_buf);
+    free(ws->iface);
+
     memset( &ws->iwr, 0, sizeof(ws->iwr) );
     memset( &ws->wsh, 0, sizeof(ws->wsh) );
 
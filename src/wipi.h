@@ -34,13 +34,23 @@
 #include <arpa/inet.h>
 #include <linux/if_packet.h>
 #include <linux/if_ether.h>
+#include <math.h>
 #include <iwlib.h>
 
+#include "wipi_stats.h"
+#include "wipi_ie.h"
+#include "wipi_freq.h"
+
 /*    MACRO DEFS    */
 #define WIPI_MAX_SSID   32
 #define WIPI_MAX_BSSID  32
-#define WIPI_MAX_FREQ   32
 #define WIPI_MAX_STATS  64
+#define WIPI_MAC_LEN    6
+#define WIPI_DEAUTH_LEN 38  /* radiotap + deauth frame */
+
+#define WIPI_SCAN_BUFLEN        IW_SCAN_MAX_DATA
+#define WIPI_SCAN_POLL_US       100000  /* 100ms */
+#define WIPI_SCAN_TIMEOUT_MS    15000
 
 /*    TYPEDEFS    */
 typedef enum
@@ -50,7 +60,10 @@ typedef enum
     WIPI_ERR_SOCKFD,
     WIPI_ERR_SCAN,
     WIPI_ERR_NOMON,
-    WIPI_ERR_SEND
+    WIPI_ERR_SEND,
+    WIPI_ERR_FILTER,
+    WIPI_ERR_IO,
+    WIPI_ERR_BUSY
 } WIPI_STATUS;
 
 typedef struct __wipi_beacon_t
@@ -60,13 +73,30 @@ typedef struct __wipi_beacon_t
 
     char                    ssid[WIPI_MAX_SSID];
     char                    bssid[WIPI_MAX_BSSID];
-    char                    cfreq[WIPI_MAX_FREQ];
     char                    stats[WIPI_MAX_STATS];
+    uint8_t                 addr[WIPI_MAC_LEN];
 
-    double                  freq;
+    double                  freq;       /* GHz */
     float                   qual;
     int8_t                  db;
     int                     channel;
+    uint16_t                freq_mhz;
+    uint8_t                 band;       /* WIPI_BAND */
+
+    struct __wipi_caps_t    caps;
+    const uint8_t*          ie;         /* raw IEs, valid until next scan */
+    uint16_t                ie_len;
+
+    uint8_t                 radio;      /* group index of the radio kept  */
+    uint32_t                radios;     /* bitmask of radios that saw it  */
+    uint64_t                seen;       /* monotonic ns of the observation */
+
+    uint64_t                tsf;        /* AP timer, us - captured frames only */
+    uint16_t                beacon_int; /* TU (1024us)  - captured frames only */
+
+    float                   airtime;    /* share of the channel the BSS used, 10s */
+    float                   utilization;/* busy fraction of its channel, 10s      */
+    const char*             vendor;     /* OUI registry name, see wipi_beacon_vendor() */
 
     uint8_t                 valid;
 } wipi_beacon_t;
@@ -84,6 +114,14 @@ typedef struct __wipi_interface_t
     uint8_t                     if_mon;
 } wipi_interface_t;
 
+typedef struct __wipi_scan_res_t
+{
+    wireless_scan   r;      /* must stay first, results link through r.next */
+
+    uint8_t*        ie;
+    uint16_t        ie_len;
+} wipi_scan_res_t;
+
 typedef struct __wipi_scanner_t
 {
     iwrange             iwr;
@@ -93,13 +131,18 @@ typedef struct __wipi_scanner_t
 
     int                 sockets;
 
+    char*               scan_buf;
+    int                 scan_buflen;
+    uint64_t            triggered;
+
     char*               iface;
 
     WIPI_STATUS         status;
 } wipi_scanner_t;
 
 /*    STATIC DEFS    */
-extern WIPI_STATUS WIPI_ERRNO;
+/* Per thread, like errno - scans, jobs and captures fail on threads of their own */
+extern __thread WIPI_STATUS WIPI_ERRNO;
 
 static const char* WIPI_STRERRS[] = {
     "WIPI_ERR_OK",
@@ -107,10 +150,30 @@ static const char* WIPI_STRERRS[] = {
     "WIPI_ERR_SOCKFD",
     "WIPI_ERR_SCAN",
     "WIPI_ERR_NOMON",
-    "WIPI_ERR_SEND"
+    "WIPI_ERR_SEND",
+    "WIPI_ERR_FILTER",
+    "WIPI_ERR_IO",
+    "WIPI_ERR_BUSY"
 };
 
 /*    FUNCTION DECLS    */
+static inline uint64_t wipi_mac_key(const uint8_t* mac)
+{
+    return (uint64_t)mac[0] << 40 | (uint64_t)mac[1] << 32 | (uint64_t)mac[2] << 24 |
+           (uint64_t)mac[3] << 16 | (uint64_t)mac[4] << 8  | (uint64_t)mac[5];
+}
+
+static inline uint32_t wipi_mac_hash(uint64_t key)
+{
+    key ^= key >> 29;
+    key *= 0xBF58476D1CE4E5B9ULL;
+    key ^= key >> 32;
+
+    return (uint32_t)key;
+}
+
+int wipi_mac_aton(const char* __restrict__ str, uint8_t* mac);
+
 #define WIPI_PERROR() fprintf(stderr, \
                               "%s#%d -> %s()\n%s (%d): %s\n", \
                               __FILE__, \
@@ -137,6 +200,15 @@ struct __wipi_beacon_t* wipi_beacon_get(struct __wipi_beacon_t* wb,
 __wur
 struct __wipi_scanner_t* wipi_scanner_init(const char* __restrict__ iface);
 
+int wipi_scanner_trigger(struct __wipi_scanner_t* ws,
+                         const int* freqs,
+                         int nfreqs);
+
+int wipi_scanner_collect(struct __wipi_scanner_t* ws);
+
+void wipi_populate_beacon(struct __wipi_beacon_t* wb,
+                          struct __wipi_scanner_t* ws);
+
 __wur
 struct __wipi_beacon_t* wipi_scanner_scan(struct __wipi_scanner_t* ws);
 
@@ -144,6 +216,11 @@ uint8_t wipi_interface_monitor_mode(struct __wipi_interface_t* wi);
 
 int wipi_mon_socket(struct __wipi_interface_t* wi);
 
+int wipi_mon_socket_stats(int sockfd);
+
+void wipi_deauth_frame(uint8_t* packet,
+                       const uint8_t* bssid);
+
 int wipi_deauth(struct __wipi_interface_t* wi,
                 const char* __restrict__ bssid,
                 int packets,
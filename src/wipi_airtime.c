@@ -0,0 +1,599 @@
+/*    wipi_airtime.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Channel airtime and utilization estimation definitions for WiPi.
+ * See wipi_airtime.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <math.h>
+#include <sched.h>
+#include <stddef.h>
+#include <unistd.h>
+
+#ifndef _WIPI_AIRTIME_H_
+    #include "wipi_airtime.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_AIRTIME_USED   (1ULL << 63)
+#define WIPI_AIRTIME_GONE   1ULL            /* an evicted slot, never a key */
+
+/*    STATIC DEFS    */
+/* Per stream kbps for MCS 0-9, long guard interval */
+static const uint32_t WIPI_RATE_20[]  = { 6500,  13000, 19500, 26000, 39000,  52000,  58500,  65000,  78000,  86700  };
+static const uint32_t WIPI_RATE_40[]  = { 13500, 27000, 40500, 54000, 81000,  108000, 121500, 135000, 162000, 180000 };
+static const uint32_t WIPI_RATE_80[]  = { 29300, 58500, 87800, 117000, 175500, 234000, 263300, 292500, 351000, 390000 };
+
+/*    FUNCTION DEFINITIONS    */
+static uint32_t wipi_airtime_mcs_kbps(uint8_t mcs, uint8_t nss, int width, int sgi)
+{
+    uint64_t    kbps;
+
+    switch (width)
+    {
+        case 40:
+            kbps = WIPI_RATE_40[mcs];
+            break;
+
+        case 80:
+            kbps = WIPI_RATE_80[mcs];
+            break;
+
+        case 160:
+            kbps = WIPI_RATE_80[mcs] * 2;
+            break;
+
+        default:
+            kbps = WIPI_RATE_20[mcs];
+            break;
+    }
+
+    kbps *= nss;
+
+    return (uint32_t)(sgi ? kbps * 10 / 9 : kbps);
+}
+
+uint32_t wipi_airtime_duration(const struct __wipi_frame_t* f)
+{
+    uint64_t    bits, kbps, sym_ns, nsym;
+    uint8_t     mcs, nss;
+    int         width;
+
+    /* The FCS goes over the air even when the driver strips it */
+    bits = (uint64_t)(f->len + 4) * 8;
+
+    if ((f->vht_mcs & 0x0F) && (f->vht_mcs >> 4) <= 9)
+    {
+        mcs = f->vht_mcs >> 4;
+        nss = f->vht_mcs & 0x0F;
+        width = f->vht_bw == 0 ? 20 : f->vht_bw <= 3 ? 40 : f->vht_bw <= 10 ? 80 : 160;
+        sym_ns = f->vht_flags & 0x04 ? 3600 : 4000;
+        kbps = wipi_airtime_mcs_kbps(mcs, nss, width, sym_ns == 3600);
+    }
+    else if (f->mcs < 32)
+    {
+        mcs = f->mcs % 8;
+        nss = f->mcs / 8 + 1;
+        width = (f->mcs_flags & 0x03) == 1 ? 40 : 20;
+        sym_ns = f->mcs_flags & 0x04 ? 3600 : 4000;
+        kbps = wipi_airtime_mcs_kbps(mcs, nss, width, sym_ns == 3600);
+    }
+    else
+    {
+        kbps = f->rate ? f->rate * 500 : (wipi_freq_band(f->freq) == WIPI_BAND_2G ? 1000 : 6000);
+
+        /* DSSS/CCK: long or short PLCP preamble, then the payload */
+        if (kbps == 1000 || kbps == 2000 || kbps == 5500 || kbps == 11000)
+            return (uint32_t)(((f->rt_flags & WIPI_RT_F_SHORTPRE) && kbps > 1000 ? 96000 : 192000) +
+                              bits * 1000000 / kbps);
+
+        /* OFDM: 20us preamble, 4us symbols, 16 service + 6 tail bits */
+        nsym = ((bits + 22) * 1000 + kbps * 4 - 1) / (kbps * 4);
+
+        return (uint32_t)(20000 + nsym * 4000);
+    }
+
+    /* HT/VHT mixed format preamble, one training field per stream */
+    nsym = ((bits + 22) * 1000000 + kbps * sym_ns - 1) / (kbps * sym_ns);
+
+    return (uint32_t)(32000 + 4000 * nss + nsym * sym_ns);
+}
+
+static const uint8_t* wipi_airtime_bssid(const struct __wipi_frame_t* f)
+{
+    if (f->len < WIPI_MGMT_HDR_LEN)
+        return NULL;
+
+    switch (WIPI_FC_TYPE(f->fc))
+    {
+        case WIPI_FT_MGMT:
+            return f->hdr + 16;
+
+        case WIPI_FT_DATA:
+            switch (f->fc & (WIPI_FC_TODS | WIPI_FC_FROMDS))
+            {
+                case 0:
+                    return f->hdr + 16;
+
+                case WIPI_FC_TODS:
+                    return f->hdr + 4;
+
+                case WIPI_FC_FROMDS:
+                    return f->hdr + 10;
+            }
+    }
+
+    return NULL;    /* control frames, WDS */
+}
+
+static int wipi_airtime_chan_slot(struct __wipi_airtime_t* wa, uint16_t freq)
+{
+    uint16_t    cur;
+    int         i;
+
+    i = freq % WIPI_AIRTIME_CHANNELS;
+
+    for (int n = 0; n < WIPI_AIRTIME_CHANNELS; n++, i = (i + 1) % WIPI_AIRTIME_CHANNELS)
+    {
+        cur = __atomic_load_n(&wa->freqs[i], __ATOMIC_ACQUIRE);
+
+        if (cur == 0 && __atomic_compare_exchange_n(&wa->freqs[i], &cur, freq, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return i;
+
+        if (cur == freq)
+            return i;
+    }
+
+    return -1;
+}
+
+static int wipi_airtime_bss_slot(struct __wipi_airtime_t* wa, uint64_t key, int insert)
+{
+    uint64_t    cur;
+    size_t      i;
+    int         slot;
+
+    /* Losing a claim to another new BSSID means looking again */
+    for (int tries = 0; tries < 4; tries++)
+    {
+        slot = -1;
+        i = wipi_mac_hash(key) % WIPI_AIRTIME_BSS;
+
+        for (int n = 0; n < WIPI_AIRTIME_BSS; n++, i = (i + 1) % WIPI_AIRTIME_BSS)
+        {
+            cur = __atomic_load_n(&wa->keys[i], __ATOMIC_ACQUIRE);
+
+            if (cur == key)
+                return (int)i;
+
+            /* Keep probing past evicted slots, the first one is where the key goes */
+            if (cur == WIPI_AIRTIME_GONE && slot < 0)
+                slot = (int)i;
+
+            if (cur == 0)
+            {
+                slot = slot < 0 ? (int)i : slot;
+                break;
+            }
+        }
+
+        if (!insert || slot < 0)
+            return -1;
+
+        /* Writers racing on the same new BSSID all pick the same slot */
+        cur = __atomic_load_n(&wa->keys[slot], __ATOMIC_ACQUIRE);
+
+        if ((cur == 0 || cur == WIPI_AIRTIME_GONE) &&
+            __atomic_compare_exchange_n(&wa->keys[slot], &cur, key, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            __atomic_fetch_add(&wa->nbss, 1, __ATOMIC_RELAXED);
+
+            return slot;
+        }
+
+        if (cur == key)
+            return slot;
+    }
+
+    return -1;
+}
+
+/* Counters, history and all, go back to zero for whoever takes the slot
+ * next. A writer that found the slot just before may still add a frame.
+ */
+static void wipi_airtime_bss_free(struct __wipi_airtime_t* wa, int bs)
+{
+    for (int c = 0; c < wa->ncpus; c++)
+        for (int k = 0; k < 2; k++)
+            __atomic_store_n(&wa->cpus[c].bss[bs][k], 0, __ATOMIC_RELAXED);
+
+    for (int s = 0; s < WIPI_AIRTIME_HISTORY; s++)
+        memset( wa->history[s].bss[bs], 0, sizeof(wa->history[s].bss[bs]) );
+
+    __atomic_store_n(&wa->bss_chan[bs], 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&wa->seen[bs], 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&wa->keys[bs], WIPI_AIRTIME_GONE, __ATOMIC_RELEASE);
+    __atomic_fetch_sub(&wa->nbss, 1, __ATOMIC_RELAXED);
+
+    wa->evicted++;
+}
+
+static int wipi_airtime_oldest(const void* a, const void* b)
+{
+    uint64_t    ra, rb;
+
+    ra = *(const uint64_t*)a;
+    rb = *(const uint64_t*)b;
+
+    return ra < rb ? -1 : ra > rb;
+}
+
+/* Forget BSSIDs idle for WIPI_AIRTIME_BSS_AGE, then past 3/4 full roughly
+ * the quarter heard from longest ago. The cut off comes from a sample of
+ * last frame times.
+ */
+static void wipi_airtime_age(struct __wipi_airtime_t* wa, uint64_t second)
+{
+    uint64_t    sample[WIPI_AIRTIME_SAMPLE], cutoff, seen;
+    size_t      n, step;
+
+    cutoff = second > WIPI_AIRTIME_BSS_AGE ? (second - WIPI_AIRTIME_BSS_AGE) * 1000000000ULL : 0;
+
+    for (int i = 0; i < WIPI_AIRTIME_BSS; i++)
+    {
+        if ((wa->keys[i] & WIPI_AIRTIME_USED) && __atomic_load_n(&wa->seen[i], __ATOMIC_RELAXED) < cutoff)
+            wipi_airtime_bss_free(wa, i);
+    }
+
+    if (__atomic_load_n(&wa->nbss, __ATOMIC_RELAXED) * 4 <= WIPI_AIRTIME_BSS * 3)
+        return;
+
+    step = WIPI_AIRTIME_BSS / WIPI_AIRTIME_SAMPLE;
+    n = 0;
+
+    for (size_t i = 0; i < WIPI_AIRTIME_BSS && n < WIPI_AIRTIME_SAMPLE; i += step)
+    {
+        for (size_t k = i; k < WIPI_AIRTIME_BSS && k < i + step; k++)
+        {
+            if (wa->keys[k] & WIPI_AIRTIME_USED)
+            {
+                sample[n++] = __atomic_load_n(&wa->seen[k], __ATOMIC_RELAXED);
+                break;
+            }
+        }
+    }
+
+    if (n == 0)
+        return;
+
+    qsort(sample, n, sizeof(uint64_t), wipi_airtime_oldest);
+    cutoff = sample[n / 4];
+
+    for (int i = 0; i < WIPI_AIRTIME_BSS; i++)
+    {
+        seen = __atomic_load_n(&wa->seen[i], __ATOMIC_RELAXED);
+
+        if ((wa->keys[i] & WIPI_AIRTIME_USED) && seen <= cutoff)
+            wipi_airtime_bss_free(wa, i);
+    }
+}
+
+/* Fold the per-CPU counters into the history, once per second */
+static void wipi_airtime_roll(struct __wipi_airtime_t* wa, uint64_t second)
+{
+    struct __wipi_airtime_snap_t*   snap;
+    uint64_t                        from;
+
+    snap = &wa->history[second % WIPI_AIRTIME_HISTORY];
+    memset( snap, 0, sizeof(struct __wipi_airtime_snap_t) );
+
+    for (int c = 0; c < wa->ncpus; c++)
+    {
+        for (int i = 0; i < WIPI_AIRTIME_CHANNELS; i++)
+            for (int k = 0; k < WIPI_AIR_COUNTERS; k++)
+                snap->chan[i][k] += __atomic_load_n(&wa->cpus[c].chan[i][k], __ATOMIC_RELAXED);
+
+        for (int i = 0; i < WIPI_AIRTIME_BSS; i++)
+            for (int k = 0; k < 2; k++)
+                snap->bss[i][k] += __atomic_load_n(&wa->cpus[c].bss[i][k], __ATOMIC_RELAXED);
+    }
+
+    if (wa->first == 0)
+        wa->first = second;
+
+    /* Nothing was counted during seconds with no frames */
+    from = second - wa->second < WIPI_AIRTIME_HISTORY ? wa->second + 1 : second - WIPI_AIRTIME_HISTORY + 1;
+
+    for (uint64_t s = from; wa->second && s < second; s++)
+        memcpy( &wa->history[s % WIPI_AIRTIME_HISTORY], snap, sizeof(struct __wipi_airtime_snap_t) );
+
+    __atomic_store_n(&wa->second, second, __ATOMIC_RELEASE);
+
+    wipi_airtime_age(wa, second);
+}
+
+__wur
+struct __wipi_airtime_t* wipi_airtime_init(void)
+{
+    struct __wipi_airtime_t*    wa;
+    long                        ncpus;
+
+    wa = (struct __wipi_airtime_t*)WIPI_ALLOC( sizeof(struct __wipi_airtime_t) );
+    assert(wa != NULL);
+
+    memset( wa, 0, sizeof(struct __wipi_airtime_t) );
+
+    ncpus = sysconf(_SC_NPROCESSORS_CONF);
+    wa->ncpus = ncpus > 0 ? (int)ncpus : 1;
+
+    wa->cpus = (struct __wipi_airtime_cpu_t*)aligned_alloc( 64, wa->ncpus * sizeof(struct __wipi_airtime_cpu_t) );
+    wa->history = (struct __wipi_airtime_snap_t*)calloc( WIPI_AIRTIME_HISTORY, sizeof(struct __wipi_airtime_snap_t) );
+
+    assert(wa->cpus != NULL && wa->history != NULL);
+
+    memset( wa->cpus, 0, wa->ncpus * sizeof(struct __wipi_airtime_cpu_t) );
+
+    wipi_stats_add(WIPI_STAT_ALLOC_BYTES, wa->ncpus * sizeof(struct __wipi_airtime_cpu_t));
+
+    pthread_mutex_init(&wa->lock, NULL);
+
+    return wa;
+}
+
+void wipi_airtime_update(struct __wipi_airtime_t* wa,
+                         const struct __wipi_frame_t* f,
+                         uint64_t ts_ns)
+{
+    struct __wipi_airtime_cpu_t*    c;
+    const uint8_t*                  bssid;
+    uint64_t                        second, ns;
+    int                             cpu, ch, bs;
+
+    if (f->freq == 0)
+        return;
+
+    second = ts_ns / 1000000000ULL;
+
+    /* Whoever gets the lock rolls, nobody waits for it */
+    if (second > __atomic_load_n(&wa->second, __ATOMIC_ACQUIRE) && pthread_mutex_trylock(&wa->lock) == 0)
+    {
+        if (second > wa->second)
+        {
+            wipi_airtime_roll(wa, second);
+            wa->rolled = wipi_stats_now();
+        }
+
+        pthread_mutex_unlock(&wa->lock);
+    }
+
+    if ((ch = wipi_airtime_chan_slot(wa, f->freq)) < 0)
+    {
+        __atomic_fetch_add(&wa->untracked, 1, __ATOMIC_RELAXED);
+
+        return;
+    }
+
+    cpu = sched_getcpu();
+    c = &wa->cpus[(unsigned int)(cpu < 0 ? 0 : cpu) % wa->ncpus];
+
+    ns = wipi_airtime_duration(f);
+
+    __atomic_fetch_add(&c->chan[ch][WIPI_AIR_BUSY], ns, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&c->chan[ch][WIPI_AIR_FRAMES], 1, __ATOMIC_RELAXED);
+
+    if (f->fc & WIPI_FC_RETRY)
+        __atomic_fetch_add(&c->chan[ch][WIPI_AIR_RETRY], ns, __ATOMIC_RELAXED);
+
+    if (WIPI_FC_TYPE(f->fc) == WIPI_FT_MGMT && WIPI_FC_SUBTYPE(f->fc) == WIPI_ST_BEACON)
+        __atomic_fetch_add(&c->chan[ch][WIPI_AIR_BEACON], ns, __ATOMIC_RELAXED);
+
+    if ((bssid = wipi_airtime_bssid(f)) == NULL || (bssid[0] & 0x01))
+        return;
+
+    if ((bs = wipi_airtime_bss_slot(wa, wipi_mac_key(bssid) | WIPI_AIRTIME_USED, 1)) < 0)
+    {
+        __atomic_fetch_add(&wa->untracked, 1, __ATOMIC_RELAXED);
+
+        return;
+    }
+
+    if (wa->bss_chan[bs] != ch + 1)
+        __atomic_store_n(&wa->bss_chan[bs], ch + 1, __ATOMIC_RELAXED);
+
+    if (wa->seen[bs] < ts_ns)
+        __atomic_store_n(&wa->seen[bs], ts_ns, __ATOMIC_RELAXED);
+
+    __atomic_fetch_add(&c->bss[bs][0], ns, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&c->bss[bs][1], 1, __ATOMIC_RELAXED);
+}
+
+void wipi_airtime_frame(void* ctx,
+                        const struct __wipi_frame_t* f,
+                        uint64_t ts_ns)
+{
+    wipi_airtime_update((struct __wipi_airtime_t*)ctx, f, ts_ns);
+}
+
+/* Seconds with no frames are only rolled by the next frame, roll them now
+ * by the time passed since the last roll. Called with the lock held.
+ */
+static void wipi_airtime_catch_up(struct __wipi_airtime_t* wa)
+{
+    uint64_t    now, behind;
+
+    if (wa->second == 0)
+        return;
+
+    now = wipi_stats_now();
+    behind = now > wa->rolled ? (now - wa->rolled) / 1000000000ULL : 0;
+
+    if (behind == 0)
+        return;
+
+    /* Whole seconds only, so the clock never drifts from the frames' */
+    wipi_airtime_roll(wa, wa->second + behind);
+    wa->rolled += behind * 1000000000ULL;
+}
+
+/* Fraction of each window spent on a counter, oldest history permitting */
+static void wipi_airtime_windows(struct __wipi_airtime_t* wa,
+                                 size_t off,
+                                 float* out)
+{
+    const uint64_t* now, *then;
+    uint64_t        span;
+
+    now = (const uint64_t*)&wa->history[wa->second % WIPI_AIRTIME_HISTORY] + off;
+
+    for (int w = 0; w < WIPI_AIRTIME_WINDOWS; w++)
+    {
+        span = wa->second - wa->first;
+        span = span < (uint64_t)WIPI_AIRTIME_SECONDS[w] ? span : (uint64_t)WIPI_AIRTIME_SECONDS[w];
+
+        if (span == 0)
+        {
+            out[w] = 0;
+            continue;
+        }
+
+        /* Frames missing a rate can add up past a whole second */
+        then = (const uint64_t*)&wa->history[(wa->second - span) % WIPI_AIRTIME_HISTORY] + off;
+        out[w] = (float)fmin((double)(*now - *then) / (span * 1e9), 1.0);
+    }
+}
+
+int wipi_airtime_channels(struct __wipi_airtime_t* wa,
+                          struct __wipi_airtime_report_t* out,
+                          int max)
+{
+    struct __wipi_airtime_snap_t*   snap;
+    int                             n;
+
+    n = 0;
+
+    pthread_mutex_lock(&wa->lock);
+    wipi_airtime_catch_up(wa);
+
+    snap = &wa->history[wa->second % WIPI_AIRTIME_HISTORY];
+
+    for (int i = 0; i < WIPI_AIRTIME_CHANNELS && n < max; i++)
+    {
+        if (wa->freqs[i] == 0 || wa->second == 0)
+            continue;
+
+        memset( &out[n], 0, sizeof(struct __wipi_airtime_report_t) );
+
+        out[n].freq = wa->freqs[i];
+        out[n].frames = snap->chan[i][WIPI_AIR_FRAMES];
+
+        wipi_airtime_windows(wa, offsetof(wipi_airtime_snap_t, chan[i][WIPI_AIR_BUSY]) / 8, out[n].busy);
+        wipi_airtime_windows(wa, offsetof(wipi_airtime_snap_t, chan[i][WIPI_AIR_RETRY]) / 8, out[n].retry);
+        wipi_airtime_windows(wa, offsetof(wipi_airtime_snap_t, chan[i][WIPI_AIR_BEACON]) / 8, out[n].beacon);
+
+        n++;
+    }
+
+    pthread_mutex_unlock(&wa->lock);
+
+    return n;
+}
+
+static void wipi_airtime_bss_report(struct __wipi_airtime_t* wa,
+                                    int bs,
+                                    struct __wipi_airtime_report_t* r)
+{
+    uint64_t    key;
+    uint8_t     ch;
+
+    memset( r, 0, sizeof(struct __wipi_airtime_report_t) );
+
+    key = wa->keys[bs];
+    ch = wa->bss_chan[bs];
+
+    for (int b = 0; b < WIPI_MAC_LEN; b++)
+        r->addr[b] = (uint8_t)(key >> (8 * (WIPI_MAC_LEN - 1 - b)));
+
+    r->freq = ch ? wa->freqs[ch - 1] : 0;
+    r->frames = wa->history[wa->second % WIPI_AIRTIME_HISTORY].bss[bs][1];
+
+    wipi_airtime_windows(wa, offsetof(wipi_airtime_snap_t, bss[bs][0]) / 8, r->busy);
+}
+
+int wipi_airtime_bss(struct __wipi_airtime_t* wa,
+                     struct __wipi_airtime_report_t* out,
+                     int max)
+{
+    int n;
+
+    n = 0;
+
+    pthread_mutex_lock(&wa->lock);
+    wipi_airtime_catch_up(wa);
+
+    for (int i = 0; i < WIPI_AIRTIME_BSS && n < max && wa->second; i++)
+    {
+        if (wa->keys[i] & WIPI_AIRTIME_USED)
+            wipi_airtime_bss_report(wa, i, &out[n++]);
+    }
+
+    pthread_mutex_unlock(&wa->lock);
+
+    return n;
+}
+
+int wipi_airtime_beacon(struct __wipi_airtime_t* wa,
+                        struct __wipi_beacon_t* wb)
+{
+    struct __wipi_airtime_report_t  r;
+    float                           busy[WIPI_AIRTIME_WINDOWS];
+    int                             bs, ch;
+
+    pthread_mutex_lock(&wa->lock);
+    wipi_airtime_catch_up(wa);
+
+    bs = wa->second ? wipi_airtime_bss_slot(wa, wipi_mac_key(wb->addr) | WIPI_AIRTIME_USED, 0) : -1;
+
+    if (bs >= 0)
+    {
+        wipi_airtime_bss_report(wa, bs, &r);
+        wb->airtime = r.busy[1];
+    }
+
+    /* Channel the AP is on, which may not be the one it was captured on */
+    ch = -1;
+
+    for (int i = 0; wb->freq_mhz && i < WIPI_AIRTIME_CHANNELS && ch < 0; i++)
+        ch = wa->freqs[i] == wb->freq_mhz ? i : -1;
+
+    if (ch >= 0 && wa->second)
+    {
+        wipi_airtime_windows(wa, offsetof(wipi_airtime_snap_t, chan[ch][WIPI_AIR_BUSY]) / 8, busy);
+        wb->utilization = busy[1];
+    }
+
+    pthread_mutex_unlock(&wa->lock);
+
+    return bs >= 0 || ch >= 0 ? 0 : -1;
+}
+
+void wipi_airtime_free(struct __wipi_airtime_t* wa)
+{
+    if (wa == NULL)
+        return;
+
+    pthread_mutex_destroy(&wa->lock);
+
+    free(wa->cpus);
+    free(wa->history);
+    free(wa);
+}
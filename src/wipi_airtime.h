@@ -0,0 +1,137 @@
+/*    wipi_airtime.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Channel airtime and utilization estimation for WiPi.
+ * See wipi_airtime.c for source definitions.
+ *
+ * Each captured frame's time on air is worked out from its radiotap
+ * rate (legacy, HT MCS or VHT MCS/NSS) and length, and added to its
+ * channel and BSSID. Retransmissions and beacons are also tracked
+ * separately, so their share of the channel can be reported.
+ *
+ * Writers never lock: counters are per CPU and only ever atomically
+ * added to, and channel/BSSID slots are claimed with a CAS. Once a
+ * second the totals are folded into a 60 second history that the
+ * 1s/10s/60s windows are read from. Reads roll the history on by the
+ * time passed since, so a channel gone quiet reads as idle rather
+ * than as it was at its last frame.
+ *
+ * A BSSID slot not heard from for WIPI_AIRTIME_BSS_AGE seconds is
+ * freed as the history rolls, and past 3/4 full about a quarter of
+ * them, those heard from longest ago, is freed too. A freed slot is
+ * left marked so lookups keep probing past it, and the next new BSSID
+ * along its chain takes it over.
+ *
+ * Only frames the capture sees are counted - filtering out control
+ * frames also hides the ACKs, RTS and CTS that took up the air.
+ */
+
+#ifndef _WIPI_AIRTIME_H_
+#define _WIPI_AIRTIME_H_
+
+#ifndef _WIPI_FRAME_H_
+    #include "wipi_frame.h"
+#endif
+
+/*    INCLUDES    */
+#include <pthread.h>
+
+/*    MACRO DEFS    */
+#define WIPI_AIRTIME_CHANNELS   64
+#define WIPI_AIRTIME_BSS        512
+#define WIPI_AIRTIME_HISTORY    61      /* seconds, one more than the longest window */
+#define WIPI_AIRTIME_WINDOWS    3
+#define WIPI_AIRTIME_BSS_AGE    300     /* seconds idle before a BSSID is forgotten */
+#define WIPI_AIRTIME_SAMPLE     64      /* ages sampled to pick what to evict       */
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_AIR_BUSY,      /* ns on air   */
+    WIPI_AIR_RETRY,     /* ns retrying */
+    WIPI_AIR_BEACON,    /* ns beaconing */
+    WIPI_AIR_FRAMES,
+    WIPI_AIR_COUNTERS
+} WIPI_AIR_COUNTER;
+
+typedef struct __wipi_airtime_cpu_t
+{
+    uint64_t    chan[WIPI_AIRTIME_CHANNELS][WIPI_AIR_COUNTERS];
+    uint64_t    bss[WIPI_AIRTIME_BSS][2];   /* ns on air, frames */
+} __attribute__((aligned(64))) wipi_airtime_cpu_t;
+
+typedef struct __wipi_airtime_snap_t
+{
+    uint64_t    chan[WIPI_AIRTIME_CHANNELS][WIPI_AIR_COUNTERS];
+    uint64_t    bss[WIPI_AIRTIME_BSS][2];
+} wipi_airtime_snap_t;
+
+typedef struct __wipi_airtime_report_t
+{
+    uint16_t    freq;
+    uint8_t     addr[WIPI_MAC_LEN];         /* BSSID reports only */
+
+    uint64_t    frames;                     /* since start */
+    float       busy[WIPI_AIRTIME_WINDOWS]; /* fraction of each window on air */
+    float       retry[WIPI_AIRTIME_WINDOWS];
+    float       beacon[WIPI_AIRTIME_WINDOWS];
+} wipi_airtime_report_t;
+
+typedef struct __wipi_airtime_t
+{
+    uint16_t                        freqs[WIPI_AIRTIME_CHANNELS];   /* MHz, 0 = free */
+    uint64_t                        keys[WIPI_AIRTIME_BSS];         /* mac key | used bit */
+    uint8_t                         bss_chan[WIPI_AIRTIME_BSS];     /* channel slot + 1 */
+    uint64_t                        seen[WIPI_AIRTIME_BSS];         /* ns, last frame   */
+    int                             nbss;
+
+    struct __wipi_airtime_cpu_t*    cpus;
+    int                             ncpus;
+
+    struct __wipi_airtime_snap_t*   history;
+    uint64_t                        first;      /* first rolled second */
+    uint64_t                        second;     /* last rolled second  */
+    uint64_t                        rolled;     /* monotonic ns when second began */
+
+    uint64_t                        untracked;  /* frames with no free slot */
+    uint64_t                        evicted;
+
+    pthread_mutex_t                 lock;       /* history, never taken by writers */
+} wipi_airtime_t;
+
+/*    STATIC DEFS    */
+static const int WIPI_AIRTIME_SECONDS[WIPI_AIRTIME_WINDOWS] = { 1, 10, 60 };
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_airtime_t* wipi_airtime_init(void);
+
+uint32_t wipi_airtime_duration(const struct __wipi_frame_t* f);
+
+void wipi_airtime_update(struct __wipi_airtime_t* wa,
+                         const struct __wipi_frame_t* f,
+                         uint64_t ts_ns);
+
+void wipi_airtime_frame(void* ctx,
+                        const struct __wipi_frame_t* f,
+                        uint64_t ts_ns);
+
+int wipi_airtime_channels(struct __wipi_airtime_t* wa,
+                          struct __wipi_airtime_report_t* out,
+                          int max);
+
+int wipi_airtime_bss(struct __wipi_airtime_t* wa,
+                     struct __wipi_airtime_report_t* out,
+                     int max);
+
+int wipi_airtime_beacon(struct __wipi_airtime_t* wa,
+                        struct __wipi_beacon_t* wb);
+
+void wipi_airtime_free(struct __wipi_airtime_t* wa);
+
+#endif
@@ -0,0 +1,555 @@
+/*    wipi_aptable.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Access point table definitions for WiPi.
+ * See wipi_aptable.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#ifndef _WIPI_APTABLE_H_
+    #include "wipi_aptable.h"
+#endif
+
+/*    FUNCTION DEFINITIONS    */
+static size_t wipi_aptable_probe(struct __wipi_aptable_t* t, uint64_t key)
+{
+    size_t  i, mask;
+
+    mask = t->nslots - 1;
+
+    for (i = wipi_mac_hash(key) & mask; t->slots[i]; i = (i + 1) & mask)
+    {
+        if (wipi_mac_key(t->aps[t->slots[i] - 1].addr) == key)
+            break;
+    }
+
+    return i;
+}
+
+static void wipi_aptable_grow(struct __wipi_aptable_t* t)
+{
+    size_t  i;
+
+    t->cap *= 2;
+    t->aps = (struct __wipi_beacon_t*)realloc( t->aps, t->cap * sizeof(struct __wipi_beacon_t) );
+    assert(t->aps != NULL);
+
+    wipi_stats_add(WIPI_STAT_ALLOCS, 1);
+
+    t->nslots = t->cap * 2;
+    t->slots = (uint32_t*)realloc( t->slots, t->nslots * sizeof(uint32_t) );
+    assert(t->slots != NULL);
+
+    memset( t->slots, 0, t->nslots * sizeof(uint32_t) );
+
+    for (size_t n = 0; n < t->count; n++)
+    {
+        i = wipi_aptable_probe( t, wipi_mac_key(t->aps[n].addr) );
+        t->slots[i] = n + 1;
+    }
+}
+
+__wur
+struct __wipi_aptable_t* wipi_aptable_init(size_t hint)
+{
+    struct __wipi_aptable_t*    t;
+
+    t = (struct __wipi_aptable_t*)WIPI_ALLOC( sizeof(struct __wipi_aptable_t) );
+    assert(t != NULL);
+
+    memset( t, 0, sizeof(struct __wipi_aptable_t) );
+
+    for (t->cap = WIPI_APTABLE_MIN; t->cap <= hint; t->cap *= 2)
+        ;
+
+    t->nslots = t->cap * 2;
+
+    t->aps = (struct __wipi_beacon_t*)WIPI_ALLOC( t->cap * sizeof(struct __wipi_beacon_t) );
+    t->slots = (uint32_t*)calloc( t->nslots, sizeof(uint32_t) );
+
+    assert(t->aps != NULL && t->slots != NULL);
+
+    return t;
+}
+
+__attribute__((__pure__))
+struct __wipi_beacon_t* wipi_aptable_find(struct __wipi_aptable_t* t,
+                                          const uint8_t* addr)
+{
+    size_t  i;
+
+    if (t == NULL || addr == NULL)
+        return NULL;
+
+    i = wipi_aptable_probe( t, wipi_mac_key(addr) );
+
+    return t->slots[i] ? &t->aps[t->slots[i] - 1] : NULL;
+}
+
+struct __wipi_beacon_t* wipi_aptable_merge(struct __wipi_aptable_t* t,
+                                           const struct __wipi_beacon_t* wb,
+                                           WIPI_MERGE policy)
+{
+    struct __wipi_beacon_t* ap;
+    uint32_t                radios;
+    size_t                  i;
+
+    assert(t != NULL && wb != NULL);
+
+    i = wipi_aptable_probe( t, wipi_mac_key(wb->addr) );
+
+    if (t->slots[i])
+    {
+        ap = &t->aps[t->slots[i] - 1];
+        radios = ap->radios | wb->radios;
+
+        if (policy == WIPI_MERGE_RECENT ? wb->seen >= ap->seen : wb->db > ap->db)
+            *ap = *wb;
+
+        ap->radios = radios;
+    }
+    else
+    {
+        /* Keep one spare record for the list terminator */
+        if (t->count + 1 >= t->cap)
+        {
+            wipi_aptable_grow(t);
+
+            i = wipi_aptable_probe( t, wipi_mac_key(wb->addr) );
+        }
+
+        ap = &t->aps[t->count];
+        *ap = *wb;
+
+        t->slots[i] = ++t->count;
+    }
+
+    ap->head = NULL;
+    ap->next = NULL;
+
+    t->version++;
+
+    return ap;
+}
+
+struct __wipi_beacon_t* wipi_aptable_list(struct __wipi_aptable_t* t)
+{
+    assert(t != NULL);
+
+    for (size_t n = 0; n < t->count; n++)
+    {
+        t->aps[n].head = t->aps;
+        t->aps[n].next = &t->aps[n + 1];
+    }
+
+    memset( &t->aps[t->count], 0, sizeof(struct __wipi_beacon_t) );
+    t->aps[t->count].head = t->aps;
+
+    return t->aps;
+}
+
+static int wipi_apindex_cmp(const void* a, const void* b, void* arg)
+{
+    const struct __wipi_beacon_t*   aps, *x, *y;
+    uint32_t                        i, j;
+    int                             sort, d;
+    uint64_t                        kx, ky;
+
+    aps = ((struct __wipi_aptable_t*)((uintptr_t*)arg)[0])->aps;
+    sort = (int)((uintptr_t*)arg)[1];
+
+    i = *(const uint32_t*)a;
+    j = *(const uint32_t*)b;
+    x = &aps[i];
+    y = &aps[j];
+    d = 0;
+
+    switch (sort)
+    {
+        case WIPI_SORT_SSID:
+            d = strncmp(x->ssid, y->ssid, WIPI_MAX_SSID);
+            break;
+        case WIPI_SORT_BSSID:
+            kx = wipi_mac_key(x->addr);
+            ky = wipi_mac_key(y->addr);
+            d = (kx > ky) - (kx < ky);
+            break;
+        case WIPI_SORT_DB:
+            d = (int)x->db - (int)y->db;
+            break;
+        case WIPI_SORT_CHANNEL:
+            d = x->band != y->band ? (int)x->band - (int)y->band : x->channel - y->channel;
+            break;
+    }
+
+    /* Ties keep table order so pages are stable */
+    return d ? d : (i > j) - (i < j);
+}
+
+static inline void wipi_apindex_set(uint64_t* bm, size_t n)
+{
+    bm[n >> 6] |= 1ULL << (n & 63);
+}
+
+static inline int wipi_apindex_test(const uint64_t* bm, size_t n)
+{
+    return (bm[n >> 6] >> (n & 63)) & 1;
+}
+
+static void wipi_apindex_build(struct __wipi_aptable_t* t)
+{
+    struct __wipi_apindex_t*    x;
+    struct __wipi_beacon_t*     ap;
+    uintptr_t                   arg[2];
+    int                         ch;
+
+    x = &t->index;
+
+    if (x->cap < t->cap)
+    {
+        x->cap = t->cap;
+        x->words = (x->cap + 63) / 64;
+
+        for (int s = WIPI_SORT_SSID; s < WIPI_SORTS; s++)
+        {
+            x->order[s] = (uint32_t*)realloc( x->order[s], x->cap * sizeof(uint32_t) );
+            assert(x->order[s] != NULL);
+        }
+
+        x->bands = (uint64_t*)realloc( x->bands, WIPI_APTABLE_BANDS * x->words * sizeof(uint64_t) );
+        x->secs = (uint64_t*)realloc( x->secs, WIPI_APTABLE_SECS * x->words * sizeof(uint64_t) );
+        x->match = (uint64_t*)realloc( x->match, x->words * sizeof(uint64_t) );
+        x->range = (uint64_t*)realloc( x->range, x->words * sizeof(uint64_t) );
+
+        /* Sized for the worst case, every record on its own channel */
+        free(x->chans);
+        x->chans = NULL;
+
+        assert(x->bands != NULL && x->secs != NULL && x->match != NULL && x->range != NULL);
+
+        wipi_stats_add(WIPI_STAT_ALLOCS, 1);
+    }
+
+    memset( x->bands, 0, WIPI_APTABLE_BANDS * x->words * sizeof(uint64_t) );
+    memset( x->secs, 0, WIPI_APTABLE_SECS * x->words * sizeof(uint64_t) );
+    memset( x->chan_slot, 0xFF, sizeof(x->chan_slot) );
+
+    x->nchans = 0;
+
+    for (size_t n = 0; n < t->count; n++)
+    {
+        ap = &t->aps[n];
+        ch = ap->channel;
+
+        wipi_apindex_set(&x->bands[(ap->band < WIPI_APTABLE_BANDS ? ap->band : 0) * x->words], n);
+        wipi_apindex_set(&x->secs[ap->caps.security * x->words], n);
+
+        if (ch <= 0 || ch >= WIPI_APTABLE_CHANS)
+            continue;
+
+        if (x->chan_slot[ch] < 0)
+        {
+            x->chan_slot[ch] = x->nchans++;
+            x->chans = (uint64_t*)realloc( x->chans, x->nchans * x->words * sizeof(uint64_t) );
+            assert(x->chans != NULL);
+
+            memset( &x->chans[x->chan_slot[ch] * x->words], 0, x->words * sizeof(uint64_t) );
+        }
+
+        wipi_apindex_set(&x->chans[x->chan_slot[ch] * x->words], n);
+    }
+
+    arg[0] = (uintptr_t)t;
+
+    for (int s = WIPI_SORT_SSID; s < WIPI_SORTS; s++)
+    {
+        for (size_t n = 0; n < t->count; n++)
+            x->order[s][n] = (uint32_t)n;
+
+        arg[1] = (uintptr_t)s;
+
+        qsort_r(x->order[s], t->count, sizeof(uint32_t), wipi_apindex_cmp, arg);
+    }
+
+    x->version = t->version;
+    x->valid = 1;
+}
+
+/* First position in order[sort] whose key is not below the probe */
+static size_t wipi_apindex_lower(struct __wipi_aptable_t* t,
+                                 WIPI_SORT sort,
+                                 const char* ssid,
+                                 int64_t key)
+{
+    const uint32_t* order;
+    size_t          lo, hi, mid;
+    int             below;
+
+    order = t->index.order[sort];
+    lo = 0;
+    hi = t->count;
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (sort == WIPI_SORT_SSID)
+            below = strncmp(t->aps[order[mid]].ssid, ssid, WIPI_MAX_SSID) < 0;
+        else if (sort == WIPI_SORT_DB)
+            below = t->aps[order[mid]].db < key;
+        else
+            below = (int64_t)wipi_mac_key(t->aps[order[mid]].addr) < key;
+
+        if (below)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/* Narrow match to the records between lo and hi in order[sort] */
+static void wipi_apindex_range(struct __wipi_aptable_t* t,
+                               WIPI_SORT sort,
+                               size_t lo,
+                               size_t hi)
+{
+    struct __wipi_apindex_t*    x;
+
+    x = &t->index;
+
+    memset( x->range, 0, x->words * sizeof(uint64_t) );
+
+    for (size_t i = lo; i < hi; i++)
+        wipi_apindex_set(x->range, x->order[sort][i]);
+
+    for (size_t w = 0; w < x->words; w++)
+        x->match[w] &= x->range[w];
+}
+
+static void wipi_apindex_any(struct __wipi_apindex_t* x,
+                             const uint64_t* bitmaps,
+                             uint8_t mask)
+{
+    for (size_t w = 0; w < x->words; w++)
+    {
+        uint64_t    any;
+
+        any = 0;
+
+        for (int b = 0; b < 8; b++)
+        {
+            if (mask & (1 << b))
+                any |= bitmaps[b * x->words + w];
+        }
+
+        x->match[w] &= any;
+    }
+}
+
+static int64_t wipi_apindex_next(const struct __wipi_apindex_t* x,
+                                 uint8_t desc,
+                                 size_t* w,
+                                 uint64_t* word)
+{
+    int b;
+
+    while (*word == 0)
+    {
+        if (desc ? *w == 0 : *w + 1 >= x->words)
+            return -1;
+
+        *w = desc ? *w - 1 : *w + 1;
+        *word = x->match[*w];
+    }
+
+    b = desc ? 63 - __builtin_clzll(*word) : __builtin_ctzll(*word);
+    *word &= ~(1ULL << b);
+
+    return (int64_t)(*w * 64 + b);
+}
+
+int wipi_aptable_query(struct __wipi_aptable_t* t,
+                       const struct __wipi_query_t* q,
+                       uint32_t* out,
+                       size_t max,
+                       size_t* total)
+{
+    struct __wipi_apindex_t*    x;
+    struct __wipi_beacon_t*     ap;
+    uint64_t                    t0, lo_key, word;
+    size_t                      lo, hi, len, matched, seen, end, n, i, w;
+    int64_t                     next;
+    uint32_t                    rec;
+    uint8_t                     residual;
+
+    assert(t != NULL && q != NULL);
+
+    t0 = wipi_stats_now();
+    x = &t->index;
+
+    if (q->sort >= WIPI_SORTS || q->bssid_bits > 48)
+    {
+        WIPI_ERRNO = WIPI_ERR_RANGE;
+
+        return -1;
+    }
+
+    if (!x->valid || x->version != t->version || x->cap < t->cap)
+        wipi_apindex_build(t);
+
+    /* Start from every record, then AND in each indexed predicate */
+    memset( x->match, 0xFF, x->words * sizeof(uint64_t) );
+
+    if (t->count % 64)
+        x->match[t->count / 64] = (1ULL << (t->count % 64)) - 1;
+
+    for (w = (t->count + 63) / 64; w < x->words; w++)
+        x->match[w] = 0;
+
+    if (q->bands)
+        wipi_apindex_any(x, x->bands, q->bands & ((1 << WIPI_APTABLE_BANDS) - 1));
+
+    if (q->security)
+        wipi_apindex_any(x, x->secs, q->security);
+
+    if (q->channel)
+    {
+        if (q->channel < 0 || q->channel >= WIPI_APTABLE_CHANS || x->chan_slot[q->channel] < 0)
+            memset( x->match, 0, x->words * sizeof(uint64_t) );
+        else
+            for (w = 0; w < x->words; w++)
+                x->match[w] &= x->chans[x->chan_slot[q->channel] * x->words + w];
+    }
+
+    if (q->ssid && !q->substring && q->ssid[0])
+    {
+        len = strnlen(q->ssid, WIPI_MAX_SSID);
+        lo = wipi_apindex_lower(t, WIPI_SORT_SSID, q->ssid, 0);
+
+        for (hi = lo; hi < t->count && strncmp(t->aps[x->order[WIPI_SORT_SSID][hi]].ssid, q->ssid, len) == 0; hi++)
+            ;
+
+        wipi_apindex_range(t, WIPI_SORT_SSID, lo, hi);
+    }
+
+    if (q->bssid_bits)
+    {
+        lo_key = q->bssid & ~((1ULL << (48 - q->bssid_bits)) - 1) & 0xFFFFFFFFFFFFULL;
+
+        lo = wipi_apindex_lower(t, WIPI_SORT_BSSID, NULL, lo_key);
+        hi = wipi_apindex_lower(t, WIPI_SORT_BSSID, NULL, lo_key + (1ULL << (48 - q->bssid_bits)));
+
+        wipi_apindex_range(t, WIPI_SORT_BSSID, lo, hi);
+    }
+
+    if (q->min_db > INT8_MIN)
+        wipi_apindex_range(t, WIPI_SORT_DB, wipi_apindex_lower(t, WIPI_SORT_DB, NULL, q->min_db), t->count);
+
+    /* Without a substring or radio filter every remaining match is final,
+     * so count them here and stop walking once the page is full */
+    residual = (q->ssid && q->substring && q->ssid[0]) || q->radios;
+    matched = n = 0;
+
+    if (!residual)
+        for (w = 0; w < x->words; w++)
+            matched += __builtin_popcountll(x->match[w]);
+
+    end = q->limit ? q->offset + q->limit : SIZE_MAX;
+
+    if (end > q->offset + max)
+        end = q->offset + max;
+
+    seen = 0;
+    w = q->desc ? x->words - 1 : 0;
+    word = x->match[w];
+
+    /* Walk the requested order, checking what the bitmaps cannot answer */
+    for (i = 0; ; i++)
+    {
+        if (q->sort == WIPI_SORT_NONE)
+        {
+            /* Table order, jump straight between set bits */
+            if ((next = wipi_apindex_next(x, q->desc, &w, &word)) < 0)
+                break;
+
+            rec = (uint32_t)next;
+        }
+        else
+        {
+            if (i >= t->count)
+                break;
+
+            rec = x->order[q->sort][q->desc ? t->count - 1 - i : i];
+
+            if (!wipi_apindex_test(x->match, rec))
+                continue;
+        }
+
+        ap = &t->aps[rec];
+
+        if (q->radios && !(ap->radios & q->radios))
+            continue;
+
+        /* A 32 byte SSID fills the field with no NUL after it */
+        if (q->ssid && q->substring && !memmem(ap->ssid, strnlen(ap->ssid, WIPI_MAX_SSID), q->ssid, strlen(q->ssid)))
+            continue;
+
+        if (seen >= q->offset && seen < end)
+            out[n++] = rec;
+
+        seen++;
+
+        if (!residual && seen >= end)
+            break;
+    }
+
+    if (residual)
+        matched = seen;
+
+    if (total)
+        *total = matched;
+
+    wipi_stats_observe(WIPI_HIST_QUERY, wipi_stats_now() - t0);
+
+    return (int)n;
+}
+
+void wipi_aptable_clear(struct __wipi_aptable_t* t)
+{
+    assert(t != NULL);
+
+    memset( t->slots, 0, t->nslots * sizeof(uint32_t) );
+
+    t->count = 0;
+    t->version++;
+}
+
+void wipi_aptable_free(struct __wipi_aptable_t* t)
+{
+    if (t == NULL)
+        return;
+
+    for (int s = WIPI_SORT_SSID; s < WIPI_SORTS; s++)
+        free(t->index.order[s]);
+
+    free(t->index.bands);
+    free(t->index.secs);
+    free(t->index.chans);
+    free(t->index.match);
+    free(t->index.range);
+
+    free(t->aps);
+    free(t->slots);
+    free(t);
+}
@@ -0,0 +1,140 @@
+/*    wipi_aptable.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Access point table for WiPi, keyed by BSSID.
+ * See wipi_aptable.c for source definitions.
+ *
+ * Records live in one dense array (so the table can be handed out
+ * as a regular wipi_beacon_t list) with an open addressing index
+ * on top for O(1) lookup and merge.
+ *
+ * Queries are answered from secondary indexes rebuilt lazily the
+ * first time the table is queried after it changed: SSID, BSSID,
+ * signal and channel orderings (prefix lookups are a binary search
+ * over the first two) and band/security/channel bitmaps, so a query
+ * is a few bitmap ANDs and one pass over a sorted order.
+ */
+
+#ifndef _WIPI_APTABLE_H_
+#define _WIPI_APTABLE_H_
+
+#ifndef _WIPI_H_
+    #include "wipi.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_APTABLE_MIN    64
+#define WIPI_APTABLE_CHANS  256     /* channel numbers indexed */
+#define WIPI_APTABLE_BANDS  (WIPI_BAND_6G + 1)
+#define WIPI_APTABLE_SECS   8       /* WIPI_SECURITY values    */
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_MERGE_STRONGEST,
+    WIPI_MERGE_RECENT
+} WIPI_MERGE;
+
+typedef enum
+{
+    WIPI_SORT_NONE,     /* table order */
+    WIPI_SORT_SSID,
+    WIPI_SORT_BSSID,
+    WIPI_SORT_DB,
+    WIPI_SORT_CHANNEL,
+    WIPI_SORTS
+} WIPI_SORT;
+
+typedef struct __wipi_query_t
+{
+    const char* ssid;           /* NULL for any */
+    uint8_t     substring;      /* match ssid anywhere, not as a prefix */
+
+    uint64_t    bssid;          /* wipi_mac_key() of the prefix */
+    uint8_t     bssid_bits;     /* prefix length, 0 for any     */
+
+    uint8_t     bands;          /* 1 << WIPI_BAND, 0 for any     */
+    uint8_t     security;       /* 1 << WIPI_SECURITY, 0 for any */
+    int         channel;        /* 0 for any */
+    int         min_db;         /* INT8_MIN for any */
+    uint32_t    radios;         /* seen by any of, 0 for any     */
+
+    WIPI_SORT   sort;
+    uint8_t     desc;
+
+    size_t      offset;
+    size_t      limit;          /* 0 for no limit */
+} wipi_query_t;
+
+typedef struct __wipi_apindex_t
+{
+    uint64_t    version;                    /* table version indexed            */
+    uint8_t     valid;
+    size_t      cap;                        /* records the arrays can hold      */
+    size_t      words;                      /* 64 bit words per bitmap          */
+
+    uint32_t*   order[WIPI_SORTS];          /* record indices, ascending        */
+
+    uint64_t*   bands;                      /* WIPI_APTABLE_BANDS bitmaps       */
+    uint64_t*   secs;                       /* WIPI_APTABLE_SECS bitmaps        */
+    uint64_t*   chans;                      /* one per channel present          */
+    int16_t     chan_slot[WIPI_APTABLE_CHANS];
+    int         nchans;
+
+    uint64_t*   match;                      /* query scratch                    */
+    uint64_t*   range;
+} wipi_apindex_t;
+
+typedef struct __wipi_aptable_t
+{
+    struct __wipi_beacon_t* aps;
+    uint32_t*               slots;  /* index + 1 into aps, 0 = empty */
+
+    size_t                  count;
+    size_t                  cap;
+    size_t                  nslots;
+
+    uint64_t                version;
+
+    struct __wipi_apindex_t index;
+} wipi_aptable_t;
+
+/*    STATIC DEFS    */
+static const char* WIPI_SORT_NAMES[] = {
+    "none",
+    "ssid",
+    "bssid",
+    "rssi",
+    "channel"
+};
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_aptable_t* wipi_aptable_init(size_t hint);
+
+__attribute__((__pure__))
+struct __wipi_beacon_t* wipi_aptable_find(struct __wipi_aptable_t* t,
+                                          const uint8_t* addr);
+
+struct __wipi_beacon_t* wipi_aptable_merge(struct __wipi_aptable_t* t,
+                                           const struct __wipi_beacon_t* wb,
+                                           WIPI_MERGE policy);
+
+struct __wipi_beacon_t* wipi_aptable_list(struct __wipi_aptable_t* t);
+
+int wipi_aptable_query(struct __wipi_aptable_t* t,
+                       const struct __wipi_query_t* q,
+                       uint32_t* out,
+                       size_t max,
+                       size_t* total);
+
+void wipi_aptable_clear(struct __wipi_aptable_t* t);
+
+void wipi_aptable_free(struct __wipi_aptable_t* t);
+
+#endif
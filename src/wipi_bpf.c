@@ -0,0 +1,240 @@
+/*    wipi_bpf.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Kernel-side frame filtering definitions for WiPi.
+ * See wipi_bpf.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#ifndef _WIPI_BPF_H_
+    #include "wipi_bpf.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_BPF_STMT(bpf, code, k)         ( (bpf)->insns[(bpf)->ninsns++] = \
+                                              (struct sock_filter)BPF_STMT(code, k) )
+#define WIPI_BPF_JUMP(bpf, code, k, jt, jf) ( (bpf)->insns[(bpf)->ninsns++] = \
+                                              (struct sock_filter)BPF_JUMP(code, k, jt, jf) )
+
+#define WIPI_BPF_ACCEPT 0xFFFFFFFF
+#define WIPI_BPF_DROP   0
+
+/*    STATIC DEFS    */
+static const uint8_t WIPI_BPF_ADDRS[] = { 4, 10, 16 };  /* addr1, addr2, addr3 */
+
+/*    FUNCTION DEFINITIONS    */
+static int wipi_bpf_term(struct __wipi_bpf_t* bpf, const char* tok)
+{
+    if (strcmp(tok, "mgmt") == 0)
+        bpf->types |= 1 << WIPI_FT_MGMT;
+    else if (strcmp(tok, "ctrl") == 0)
+        bpf->types |= 1 << WIPI_FT_CTRL;
+    else if (strcmp(tok, "data") == 0)
+        bpf->types |= 1 << WIPI_FT_DATA;
+    else
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            if (WIPI_BPF_SUBTYPES[i] && strcmp(tok, WIPI_BPF_SUBTYPES[i]) == 0)
+            {
+                bpf->subtypes |= 1 << i;
+
+                return 0;
+            }
+        }
+
+        return -1;
+    }
+
+    return 0;
+}
+
+static int wipi_bpf_bssid(struct __wipi_bpf_t* bpf, const char* tok)
+{
+    if (bpf->nbssids >= WIPI_BPF_MAX_BSSIDS ||
+        wipi_mac_aton(tok, bpf->bssids[bpf->nbssids]) < 0)
+        return -1;
+
+    bpf->nbssids++;
+
+    return 0;
+}
+
+static void wipi_bpf_emit(struct __wipi_bpf_t* bpf)
+{
+    uint8_t     masks[3 + 16], values[3 + 16];
+    int         n;
+    uint32_t    hi;
+    uint16_t    lo;
+
+    bpf->ninsns = 0;
+
+    /* X = radiotap length (little endian, BPF loads are big endian) */
+    WIPI_BPF_STMT(bpf, BPF_LD  | BPF_B | BPF_ABS, 3);
+    WIPI_BPF_STMT(bpf, BPF_ALU | BPF_LSH | BPF_K, 8);
+    WIPI_BPF_STMT(bpf, BPF_MISC | BPF_TAX, 0);
+    WIPI_BPF_STMT(bpf, BPF_LD  | BPF_B | BPF_ABS, 2);
+    WIPI_BPF_STMT(bpf, BPF_ALU | BPF_OR | BPF_X, 0);
+    WIPI_BPF_STMT(bpf, BPF_MISC | BPF_TAX, 0);
+
+    /* Frame control byte 0: version (2), type (2), subtype (4) */
+    n = 0;
+
+    for (int t = WIPI_FT_MGMT; t <= WIPI_FT_DATA; t++)
+    {
+        if (!(bpf->types & (1 << t)))
+            continue;
+
+        masks[n] = 0x0C;
+        values[n++] = t << 2;
+    }
+
+    for (int s = 0; s < 16; s++)
+    {
+        /* Every subtype already matches when all management frames do */
+        if (!(bpf->subtypes & (1 << s)) || (bpf->types & (1 << WIPI_FT_MGMT)))
+            continue;
+
+        masks[n] = 0xFC;
+        values[n++] = (s << 4) | (WIPI_FT_MGMT << 2);
+    }
+
+    if (n > 0)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            WIPI_BPF_STMT(bpf, BPF_LD  | BPF_B | BPF_IND, 0);
+            WIPI_BPF_STMT(bpf, BPF_ALU | BPF_AND | BPF_K, masks[i]);
+            WIPI_BPF_JUMP(bpf, BPF_JMP | BPF_JEQ | BPF_K, values[i], 3 * (n - i) - 2, 0);
+        }
+
+        WIPI_BPF_STMT(bpf, BPF_RET | BPF_K, WIPI_BPF_DROP);
+    }
+
+    if (bpf->nbssids > 0)
+    {
+        for (int i = 0; i < bpf->nbssids; i++)
+        {
+            hi = (uint32_t)bpf->bssids[i][0] << 24 | bpf->bssids[i][1] << 16 |
+                 bpf->bssids[i][2] << 8 | bpf->bssids[i][3];
+            lo = (uint16_t)(bpf->bssids[i][4] << 8 | bpf->bssids[i][5]);
+
+            for (size_t a = 0; a < sizeof(WIPI_BPF_ADDRS); a++)
+            {
+                WIPI_BPF_STMT(bpf, BPF_LD  | BPF_W | BPF_IND, WIPI_BPF_ADDRS[a]);
+                WIPI_BPF_JUMP(bpf, BPF_JMP | BPF_JEQ | BPF_K, hi, 0, 3);
+                WIPI_BPF_STMT(bpf, BPF_LD  | BPF_H | BPF_IND, WIPI_BPF_ADDRS[a] + 4);
+                WIPI_BPF_JUMP(bpf, BPF_JMP | BPF_JEQ | BPF_K, lo, 0, 1);
+                WIPI_BPF_STMT(bpf, BPF_RET | BPF_K, WIPI_BPF_ACCEPT);
+            }
+        }
+
+        WIPI_BPF_STMT(bpf, BPF_RET | BPF_K, WIPI_BPF_DROP);
+    }
+
+    WIPI_BPF_STMT(bpf, BPF_RET | BPF_K, WIPI_BPF_ACCEPT);
+}
+
+int wipi_bpf_compile(struct __wipi_bpf_t* bpf,
+                     const char* __restrict__ expr)
+{
+    char*   copy, *tok, *save;
+    int     ret;
+
+    assert(bpf != NULL);
+
+    memset( bpf, 0, sizeof(struct __wipi_bpf_t) );
+
+    copy = strdup(expr ? expr : "");
+    assert(copy != NULL);
+
+    ret = 0;
+
+    for (tok = strtok_r(copy, " \t,|+", &save); tok && ret == 0; tok = strtok_r(NULL, " \t,|+", &save))
+    {
+        if (strcmp(tok, "or") == 0 || strcmp(tok, "and") == 0)
+            continue;
+
+        if (strcmp(tok, "bssid") == 0)
+            ret = wipi_bpf_bssid( bpf, strtok_r(NULL, " \t,|+", &save) );
+        else if (strncmp(tok, "bssid=", 6) == 0)
+            ret = wipi_bpf_bssid(bpf, tok + 6);
+        else
+            ret = wipi_bpf_term(bpf, tok);
+    }
+
+    free(copy);
+
+    if (ret < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_FILTER;
+
+        return -1;
+    }
+
+    wipi_bpf_emit(bpf);
+
+    return bpf->ninsns;
+}
+
+int wipi_bpf_attach(int sockfd,
+                    const struct __wipi_bpf_t* bpf)
+{
+    struct sock_filter  drop = BPF_STMT(BPF_RET | BPF_K, WIPI_BPF_DROP);
+    struct sock_fprog   prog;
+    char                c;
+
+    assert(bpf != NULL);
+
+    /* Frames queued before the filter went on would still be read, so
+     * block everything, drain the queue, then install the real program */
+    prog.len = 1;
+    prog.filter = &drop;
+
+    if (setsockopt(sockfd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_FILTER;
+
+        return -1;
+    }
+
+    while (recv(sockfd, &c, 1, MSG_DONTWAIT | MSG_TRUNC) >= 0)
+        ;
+
+    prog.len = bpf->ninsns;
+    prog.filter = (struct sock_filter*)bpf->insns;
+
+    if (setsockopt(sockfd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_FILTER;
+
+        return -1;
+    }
+
+    return 0;
+}
+
+int wipi_bpf_detach(int sockfd)
+{
+    int dummy;
+
+    dummy = 0;
+
+    if (setsockopt(sockfd, SOL_SOCKET, SO_DETACH_FILTER, &dummy, sizeof(dummy)) < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_FILTER;
+
+        return -1;
+    }
+
+    return 0;
+}
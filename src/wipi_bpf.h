@@ -0,0 +1,84 @@
+/*    wipi_bpf.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Kernel-side frame filtering for WiPi monitor sockets.
+ * See wipi_bpf.c for source definitions.
+ *
+ * wipi_bpf_compile() turns a small expression into classic BPF
+ * that skips the radiotap header and matches on the 802.11 frame
+ * control and address fields, so unwanted frames are dropped
+ * before they are ever copied to userspace.
+ *
+ * Expressions are space separated terms of two kinds:
+ *   mgmt | ctrl | data            - frame types
+ *   beacon | probe-resp | deauth  - management subtypes (see below)
+ *   bssid <aa:bb:cc:dd:ee:ff>     - addr1/2/3 match, repeatable
+ * Types and subtypes are both frame terms. Terms of one kind are OR'd
+ * together and the two kinds are AND'd, so
+ *   "data beacon bssid 00:11:22:33:44:55"
+ * keeps data frames and beacons to or from that BSSID. A subtype
+ * under a type already listed ("mgmt beacon") adds nothing.
+ */
+
+#ifndef _WIPI_BPF_H_
+#define _WIPI_BPF_H_
+
+#ifndef _WIPI_FRAME_H_
+    #include "wipi_frame.h"
+#endif
+
+/*    INCLUDES    */
+#include <linux/filter.h>
+
+/*    MACRO DEFS    */
+#define WIPI_BPF_MAX_BSSIDS 64
+#define WIPI_BPF_MAX_INSNS  (8 + 3 * 20 + 1 + 5 * 3 * WIPI_BPF_MAX_BSSIDS + 2)
+
+/*    TYPEDEFS    */
+typedef struct __wipi_bpf_t
+{
+    uint8_t             types;      /* 1 << WIPI_FT_*, 0 = any */
+    uint16_t            subtypes;   /* 1 << WIPI_ST_* (management) */
+
+    uint8_t             bssids[WIPI_BPF_MAX_BSSIDS][WIPI_MAC_LEN];
+    int                 nbssids;
+
+    struct sock_filter  insns[WIPI_BPF_MAX_INSNS];
+    unsigned short      ninsns;
+} wipi_bpf_t;
+
+/*    STATIC DEFS    */
+static const char* WIPI_BPF_SUBTYPES[] = {
+    "assoc-req",
+    "assoc-resp",
+    "reassoc-req",
+    "reassoc-resp",
+    "probe-req",
+    "probe-resp",
+    "timing-adv",
+    NULL,
+    "beacon",
+    "atim",
+    "disassoc",
+    "auth",
+    "deauth",
+    "action",
+    "action-noack",
+    NULL
+};
+
+/*    FUNCTION DECLS    */
+int wipi_bpf_compile(struct __wipi_bpf_t* bpf,
+                     const char* __restrict__ expr);
+
+int wipi_bpf_attach(int sockfd,
+                    const struct __wipi_bpf_t* bpf);
+
+int wipi_bpf_detach(int sockfd);
+
+#endif
@@ -0,0 +1,185 @@
+/*    wipi_cadence.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Adaptive scan cadence definitions for WiPi.
+ * See wipi_cadence.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <math.h>
+
+#ifndef _WIPI_CADENCE_H_
+    #include "wipi_cadence.h"
+#endif
+
+/*    FUNCTION DEFINITIONS    */
+__wur
+struct __wipi_cadence_t* wipi_cadence_init(uint32_t interval_ms,
+                                           uint32_t min_ms,
+                                           uint32_t max_ms)
+{
+    struct __wipi_cadence_t*    wc;
+
+    wc = (struct __wipi_cadence_t*)WIPI_ALLOC( sizeof(struct __wipi_cadence_t) );
+    assert(wc != NULL);
+
+    memset( wc, 0, sizeof(struct __wipi_cadence_t) );
+
+    wc->prev = wipi_aptable_init(0);
+    wc->next = wipi_aptable_init(0);
+
+    wc->stats.min_ms = min_ms > 0 ? min_ms : 1;
+    wc->stats.max_ms = max_ms > wc->stats.min_ms ? max_ms : wc->stats.min_ms;
+    wc->stats.interval_ms = interval_ms < wc->stats.min_ms ? wc->stats.min_ms :
+                            interval_ms > wc->stats.max_ms ? wc->stats.max_ms : interval_ms;
+
+    return wc;
+}
+
+/* Turnover plus scaled RMS signal change between table and the last sweep.
+ * ok is the bitmask of radios that returned this one.
+ */
+static double wipi_cadence_churn(struct __wipi_cadence_t* wc,
+                                 struct __wipi_aptable_t* table,
+                                 uint32_t ok)
+{
+    struct __wipi_beacon_t* wb, *old;
+    double                  sq, d;
+    size_t                  both;
+
+    sq = 0;
+    both = 0;
+
+    for (size_t i = 0; i < table->count; i++)
+    {
+        wb = &table->aps[i];
+
+        if ((old = wipi_aptable_find(wc->prev, wb->addr)) == NULL)
+            continue;
+
+        d = (double)wb->db - (double)old->db;
+        sq += d * d;
+        both++;
+    }
+
+    wc->stats.added = (uint32_t)(table->count - both);
+    wc->stats.lost = 0;
+
+    /* Only a radio that came back can say a BSSID has gone */
+    for (size_t i = 0; i < wc->prev->count; i++)
+    {
+        old = &wc->prev->aps[i];
+
+        if ((old->radios & ok) && wipi_aptable_find(table, old->addr) == NULL)
+            wc->stats.lost++;
+    }
+
+    wc->stats.rssi_rms = both ? (float)sqrt(sq / both) : 0;
+
+    if (both + wc->stats.added + wc->stats.lost == 0)
+        return 0;
+
+    return (double)(wc->stats.added + wc->stats.lost) / (both + wc->stats.added + wc->stats.lost)
+         + fmin(fmax(wc->stats.rssi_rms - WIPI_CADENCE_RSSI_NOISE, 0) / WIPI_CADENCE_RSSI_DB, 1.0);
+}
+
+/* The new sweep plus whatever only the failed radios had seen becomes the last good one */
+static void wipi_cadence_keep(struct __wipi_cadence_t* wc,
+                              struct __wipi_aptable_t* table,
+                              uint32_t ok)
+{
+    struct __wipi_aptable_t*    t;
+    struct __wipi_beacon_t*     old;
+
+    wipi_aptable_clear(wc->next);
+
+    for (size_t i = 0; i < table->count; i++)
+        wipi_aptable_merge(wc->next, &table->aps[i], WIPI_MERGE_RECENT);
+
+    for (size_t i = 0; i < wc->prev->count; i++)
+    {
+        old = &wc->prev->aps[i];
+
+        if (!(old->radios & ok) && wipi_aptable_find(table, old->addr) == NULL)
+            wipi_aptable_merge(wc->next, old, WIPI_MERGE_RECENT);
+    }
+
+    t = wc->prev;
+    wc->prev = wc->next;
+    wc->next = t;
+}
+
+uint32_t wipi_cadence_update(struct __wipi_cadence_t* wc,
+                             struct __wipi_aptable_t* table,
+                             uint32_t ok)
+{
+    struct __wipi_cadence_stats_t*  st;
+    uint64_t                        next;
+
+    assert(wc != NULL && table != NULL);
+
+    st = &wc->stats;
+    next = st->interval_ms;
+
+    if (!ok)
+    {
+        /* Keep the last good sweep to compare against, an empty one would read as all lost */
+        st->failures++;
+        st->decision = WIPI_CADENCE_BACKOFF;
+
+        next *= 2;
+    }
+    else
+    {
+        st->failures = 0;
+
+        st->decision = WIPI_CADENCE_HOLD;
+
+        /* The first sweep has nothing to compare with */
+        if (wc->primed)
+        {
+            st->churn = (float)(WIPI_CADENCE_ALPHA * wipi_cadence_churn(wc, table, ok)
+                              + (1 - WIPI_CADENCE_ALPHA) * st->churn);
+
+            if (st->churn > WIPI_CADENCE_HIGH)
+            {
+                st->decision = WIPI_CADENCE_FASTER;
+                next /= 2;
+            }
+            else if (st->churn < WIPI_CADENCE_LOW)
+            {
+                st->decision = WIPI_CADENCE_SLOWER;
+                next += next / 4 + 1;
+            }
+        }
+
+        wipi_cadence_keep(wc, table, ok);
+
+        wc->primed = 1;
+    }
+
+    st->interval_ms = next < st->min_ms ? st->min_ms :
+                      next > st->max_ms ? st->max_ms : (uint32_t)next;
+    st->decisions[st->decision]++;
+
+    return st->interval_ms;
+}
+
+void wipi_cadence_free(struct __wipi_cadence_t* wc)
+{
+    if (wc == NULL)
+        return;
+
+    wipi_aptable_free(wc->prev);
+    wipi_aptable_free(wc->next);
+    free(wc);
+}
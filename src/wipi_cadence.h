@@ -0,0 +1,99 @@
+/*    wipi_cadence.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Adaptive scan cadence for WiPi.
+ * See wipi_cadence.c for source definitions.
+ *
+ * Every active scan takes the radios off-channel, so the delay to
+ * the next one follows how much the environment is changing. Each
+ * sweep is compared with the last: BSSIDs that appeared or went
+ * away as a share of both, plus the RMS signal change (above the
+ * measurement noise) of the ones seen in both. That churn is
+ * smoothed, and the interval halves when it is high and grows by a
+ * quarter when it is low, kept within [min, max]. A failed sweep
+ * doubles the interval instead. When only some radios fail, the
+ * BSSIDs last seen by those alone are left out of the comparison and
+ * carried over to the next one, rather than read as lost.
+ *
+ * The stats record is plain data so it can be published alongside
+ * a snapshot (see wipi_shm.h) and scraped as metrics.
+ */
+
+#ifndef _WIPI_CADENCE_H_
+#define _WIPI_CADENCE_H_
+
+#ifndef _WIPI_APTABLE_H_
+    #include "wipi_aptable.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_CADENCE_MIN_MS     1000
+#define WIPI_CADENCE_MAX_MS     60000
+#define WIPI_CADENCE_HIGH       0.20    /* churn above which scans speed up   */
+#define WIPI_CADENCE_LOW        0.05    /* churn below which they slow down   */
+#define WIPI_CADENCE_RSSI_NOISE 3.0     /* RMS change (dB) that is just noise */
+#define WIPI_CADENCE_RSSI_DB    20.0    /* dB past the noise for full churn   */
+#define WIPI_CADENCE_ALPHA      0.5     /* weight of the latest sweep         */
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_CADENCE_HOLD,
+    WIPI_CADENCE_FASTER,
+    WIPI_CADENCE_SLOWER,
+    WIPI_CADENCE_BACKOFF,
+    WIPI_CADENCE_DECISIONS
+} WIPI_CADENCE_DECISION;
+
+typedef struct __wipi_cadence_stats_t
+{
+    uint32_t    interval_ms;    /* until the next sweep */
+    uint32_t    min_ms;
+    uint32_t    max_ms;
+
+    uint32_t    added;          /* BSSIDs new since the last good sweep */
+    uint32_t    lost;           /* and no longer seen                   */
+    float       rssi_rms;       /* dB, over BSSIDs in both              */
+    float       churn;          /* smoothed, 0 .. ~2                    */
+
+    uint32_t    failures;       /* consecutive failed sweeps */
+    uint32_t    decision;       /* WIPI_CADENCE_DECISION of the last one */
+
+    uint64_t    decisions[WIPI_CADENCE_DECISIONS];
+} wipi_cadence_stats_t;
+
+typedef struct __wipi_cadence_t
+{
+    struct __wipi_aptable_t*        prev;   /* last good sweep */
+    struct __wipi_aptable_t*        next;   /* built from it and the new one */
+    uint8_t                         primed;
+
+    struct __wipi_cadence_stats_t   stats;
+} wipi_cadence_t;
+
+/*    STATIC DEFS    */
+static const char* WIPI_CADENCE_NAMES[] = {
+    "hold",
+    "faster",
+    "slower",
+    "backoff"
+};
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_cadence_t* wipi_cadence_init(uint32_t interval_ms,
+                                           uint32_t min_ms,
+                                           uint32_t max_ms);
+
+uint32_t wipi_cadence_update(struct __wipi_cadence_t* wc,
+                             struct __wipi_aptable_t* table,
+                             uint32_t ok);
+
+void wipi_cadence_free(struct __wipi_cadence_t* wc);
+
+#endif
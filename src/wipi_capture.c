@@ -0,0 +1,588 @@
+/*    wipi_capture.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Passive monitor mode capture definitions for WiPi.
+ * See wipi_capture.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <net/if_arp.h>
+
+#ifndef _WIPI_CAPTURE_H_
+    #include "wipi_capture.h"
+#endif
+
+#ifndef _WIPI_BPF_H_
+    #include "wipi_bpf.h"
+#endif
+
+/*    MACRO DEFS    */
+#ifndef ARPHRD_IEEE80211_RADIOTAP
+    #define ARPHRD_IEEE80211_RADIOTAP 803
+#endif
+
+#define WIPI_PCAP_MAGIC_US  0xA1B2C3D4
+#define WIPI_PCAP_MAGIC_NS  0xA1B23C4D
+#define WIPI_PCAPNG_MAGIC   0x1A2B3C4D
+
+#define WIPI_REPLAY_IFACES  16
+
+/*    FUNCTION DEFINITIONS    */
+static int wipi_capture_socket(struct __wipi_capture_t* wc,
+                               const char* __restrict__ filter)
+{
+    struct ifreq        ifr;
+    struct tpacket_req3 req;
+    wipi_bpf_t*         bpf;
+    int                 version, ret;
+
+    /* Protocol 0 receives nothing until bind(), so the filter and ring
+     * are in place before the first frame arrives */
+    wc->sockfd = socket(AF_PACKET, SOCK_RAW, 0);
+
+    if (wc->sockfd < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_SOCKFD;
+
+        return -1;
+    }
+
+    memset( &ifr, 0, sizeof(ifr) );
+    strncpy(ifr.ifr_name, wc->iface, IFNAMSIZ - 1);
+
+    if (ioctl(wc->sockfd, SIOCGIFHWADDR, &ifr) < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_SOCKFD;
+
+        return -1;
+    }
+
+    if (ifr.ifr_hwaddr.sa_family != ARPHRD_IEEE80211_RADIOTAP)
+    {
+        WIPI_ERRNO = WIPI_ERR_NOMON;
+
+        return -1;
+    }
+
+    if (filter && *filter)
+    {
+        bpf = (wipi_bpf_t*)malloc( sizeof(wipi_bpf_t) );
+        assert(bpf != NULL);
+
+        ret = wipi_bpf_compile(bpf, filter) < 0 ? -1 : wipi_bpf_attach(wc->sockfd, bpf);
+
+        free(bpf);
+
+        if (ret < 0)
+            return -1;
+    }
+
+    version = TPACKET_V3;
+
+    if (setsockopt(wc->sockfd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_SOCKFD;
+
+        return -1;
+    }
+
+    memset( &req, 0, sizeof(req) );
+
+    req.tp_block_size = WIPI_CAPTURE_BLOCK_SIZE;
+    req.tp_block_nr = WIPI_CAPTURE_BLOCKS;
+    req.tp_frame_size = WIPI_CAPTURE_FRAME_SIZE;
+    req.tp_frame_nr = (WIPI_CAPTURE_BLOCK_SIZE / WIPI_CAPTURE_FRAME_SIZE) * WIPI_CAPTURE_BLOCKS;
+    req.tp_retire_blk_tov = WIPI_CAPTURE_BLOCK_TMO;
+
+    if (setsockopt(wc->sockfd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_SOCKFD;
+
+        return -1;
+    }
+
+    wc->ring_len = (size_t)req.tp_block_size * req.tp_block_nr;
+    wc->ring = (uint8_t*)mmap(NULL, wc->ring_len, PROT_READ | PROT_WRITE, MAP_SHARED, wc->sockfd, 0);
+
+    if (wc->ring == MAP_FAILED)
+    {
+        wc->ring = NULL;
+        WIPI_ERRNO = WIPI_ERR_SOCKFD;
+
+        return -1;
+    }
+
+    return 0;
+}
+
+static int wipi_capture_bind(struct __wipi_capture_t* wc)
+{
+    struct sockaddr_ll  ll;
+
+    memset( &ll, 0, sizeof(ll) );
+
+    ll.sll_family = AF_PACKET;
+    ll.sll_ifindex = (int)if_nametoindex(wc->iface);
+    ll.sll_protocol = htons(ETH_P_ALL);
+
+    if (ll.sll_ifindex == 0 || bind( wc->sockfd, (struct sockaddr*)&ll, sizeof(ll) ) < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_SOCKFD;
+
+        return -1;
+    }
+
+    return 0;
+}
+
+__wur
+struct __wipi_capture_t* wipi_capture_init(const char* __restrict__ iface,
+                                           const char* __restrict__ filter)
+{
+    struct __wipi_capture_t*    wc;
+
+    wc = (struct __wipi_capture_t*)WIPI_ALLOC( sizeof(struct __wipi_capture_t) );
+    assert(wc != NULL);
+
+    memset( wc, 0, sizeof(struct __wipi_capture_t) );
+
+    wc->sockfd = -1;
+    wc->iface = strdup(iface);
+    assert(wc->iface != NULL);
+
+    pthread_mutex_init(&wc->lock, NULL);
+
+    if (wipi_capture_socket(wc, filter) < 0 || wipi_capture_bind(wc) < 0)
+    {
+        wipi_capture_free(wc);
+
+        return NULL;
+    }
+
+    wc->polled = wipi_stats_now();
+
+    return wc;
+}
+
+int wipi_capture_hook(struct __wipi_capture_t* wc,
+                      wipi_capture_fn fn,
+                      void* ctx)
+{
+    int idx;
+
+    assert(wc != NULL && fn != NULL);
+
+    pthread_mutex_lock(&wc->lock);
+
+    idx = wc->nhooks < WIPI_CAPTURE_MAX_HOOKS ? wc->nhooks++ : -1;
+
+    if (idx >= 0)
+    {
+        wc->hooks[idx].fn = fn;
+        wc->hooks[idx].ctx = ctx;
+    }
+
+    pthread_mutex_unlock(&wc->lock);
+
+    if (idx < 0)
+        WIPI_ERRNO = WIPI_ERR_RANGE;
+
+    return idx;
+}
+
+int wipi_capture_record(struct __wipi_capture_t* wc,
+                        const char* __restrict__ dir,
+                        const char* __restrict__ prefix,
+                        uint64_t file_size,
+                        uint64_t file_time,
+                        uint64_t budget)
+{
+    struct __wipi_pcapng_t* wp, *old;
+
+    assert(wc != NULL);
+
+    /* A NULL directory stops recording */
+    wp = NULL;
+
+    if (dir && (wp = wipi_pcapng_open(dir, prefix, wc->iface, file_size, file_time, budget)) == NULL)
+        return -1;
+
+    pthread_mutex_lock(&wc->lock);
+
+    old = wc->writer;
+    wc->writer = wp;
+
+    pthread_mutex_unlock(&wc->lock);
+
+    wipi_pcapng_close(old);
+
+    return 0;
+}
+
+static int wipi_capture_block(struct __wipi_capture_t* wc,
+                              struct tpacket_block_desc* bd)
+{
+    struct tpacket3_hdr*    h;
+    wipi_frame_t            f;
+    const uint8_t*          pkt;
+    uint64_t                ts, bytes;
+    uint32_t                n;
+
+    n = bd->hdr.bh1.num_pkts;
+    h = (struct tpacket3_hdr*)((uint8_t*)bd + bd->hdr.bh1.offset_to_first_pkt);
+    bytes = 0;
+
+    pthread_mutex_lock(&wc->lock);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        pkt = (const uint8_t*)h + h->tp_mac;
+        ts = (uint64_t)h->tp_sec * 1000000000ULL + h->tp_nsec;
+        bytes += h->tp_snaplen;
+
+        if (wc->writer)
+            wipi_pcapng_frame(wc->writer, pkt, h->tp_snaplen, h->tp_len, ts);
+
+        if (wc->nhooks > 0 && wipi_frame_parse(&f, pkt, h->tp_snaplen) == 0)
+        {
+            for (int k = 0; k < wc->nhooks; k++)
+                wc->hooks[k].fn(wc->hooks[k].ctx, &f, ts);
+        }
+
+        h = (struct tpacket3_hdr*)((uint8_t*)h + h->tp_next_offset);
+    }
+
+    /* The writer points into this block, so it goes out before the kernel gets it back */
+    if (wc->writer && wipi_pcapng_flush(wc->writer) < 0)
+        wc->status = wc->writer->status;
+
+    pthread_mutex_unlock(&wc->lock);
+
+    wc->frames += n;
+    wc->bytes += bytes;
+
+    wipi_stats_add(WIPI_STAT_CAP_BYTES, bytes);
+
+    return (int)n;
+}
+
+int wipi_capture_poll(struct __wipi_capture_t* wc,
+                      int timeout_ms)
+{
+    struct tpacket_block_desc*  bd;
+    struct pollfd               pfd;
+    uint64_t                    now;
+    int                         total, drops;
+
+    assert(wc != NULL);
+
+    total = 0;
+
+    for (int i = 0; i < WIPI_CAPTURE_BLOCKS; i++)
+    {
+        bd = (struct tpacket_block_desc*)(wc->ring + (size_t)wc->block * WIPI_CAPTURE_BLOCK_SIZE);
+
+        if (!(__atomic_load_n(&bd->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER))
+        {
+            /* Only wait when there was nothing to do */
+            if (total > 0)
+                break;
+
+            pfd.fd = wc->sockfd;
+            pfd.events = POLLIN | POLLERR;
+            pfd.revents = 0;
+
+            if (poll(&pfd, 1, timeout_ms) < 0 && errno != EINTR)
+            {
+                WIPI_ERRNO = wc->status = WIPI_ERR_SOCKFD;
+
+                return -1;
+            }
+
+            if (!(__atomic_load_n(&bd->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER))
+                break;
+        }
+
+        total += wipi_capture_block(wc, bd);
+
+        __atomic_store_n(&bd->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+
+        wc->block = (wc->block + 1) % WIPI_CAPTURE_BLOCKS;
+    }
+
+    now = wipi_stats_now();
+
+    if (now - wc->polled >= WIPI_CAPTURE_STATS_NS)
+    {
+        wc->polled = now;
+
+        if ((drops = wipi_mon_socket_stats(wc->sockfd)) > 0)
+            wc->drops += drops;
+    }
+
+    return total;
+}
+
+static void* wipi_capture_thread(void* arg)
+{
+    struct __wipi_capture_t*    wc;
+
+    wc = (struct __wipi_capture_t*)arg;
+
+    while (wc->running)
+    {
+        if (wipi_capture_poll(wc, WIPI_CAPTURE_BLOCK_TMO * 2) < 0)
+            break;
+    }
+
+    return NULL;
+}
+
+int wipi_capture_start(struct __wipi_capture_t* wc)
+{
+    assert(wc != NULL);
+
+    if (wc->running)
+        return 0;
+
+    wc->running = 1;
+
+    if (pthread_create(&wc->thread, NULL, wipi_capture_thread, wc) != 0)
+    {
+        wc->running = 0;
+        WIPI_ERRNO = WIPI_ERR_SOCKFD;
+
+        return -1;
+    }
+
+    return 0;
+}
+
+void wipi_capture_stop(struct __wipi_capture_t* wc)
+{
+    assert(wc != NULL);
+
+    if (!wc->running)
+        return;
+
+    wc->running = 0;
+
+    pthread_join(wc->thread, NULL);
+}
+
+void wipi_capture_free(struct __wipi_capture_t* wc)
+{
+    if (wc == NULL)
+        return;
+
+    wipi_capture_stop(wc);
+    wipi_pcapng_close(wc->writer);
+
+    if (wc->ring)
+        munmap(wc->ring, wc->ring_len);
+
+    if (wc->sockfd >= 0)
+        close(wc->sockfd);
+
+    pthread_mutex_destroy(&wc->lock);
+
+    free(wc->iface);
+    free(wc);
+}
+
+static void wipi_capture_dispatch(const struct __wipi_capture_hook_t* hooks,
+                                  int nhooks,
+                                  const uint8_t* pkt,
+                                  uint32_t len,
+                                  uint64_t ts)
+{
+    wipi_frame_t    f;
+
+    if (wipi_frame_parse(&f, pkt, len) < 0)
+        return;
+
+    for (int k = 0; k < nhooks; k++)
+        hooks[k].fn(hooks[k].ctx, &f, ts);
+}
+
+static int64_t wipi_capture_replay_pcap(const uint8_t* p,
+                                        size_t len,
+                                        const struct __wipi_capture_hook_t* hooks,
+                                        int nhooks)
+{
+    uint32_t    caplen, scale;
+    int64_t     frames;
+    size_t      off;
+
+    if (len < 24 || wipi_get_le32(p + 20) != WIPI_PCAPNG_LINKTYPE)
+        return -1;
+
+    scale = wipi_get_le32(p) == WIPI_PCAP_MAGIC_NS ? 1 : 1000;
+    frames = 0;
+
+    for (off = 24; off + 16 <= len; off += 16 + caplen)
+    {
+        caplen = wipi_get_le32(p + off + 8);
+
+        if (off + 16 + caplen > len)
+            break;
+
+        wipi_capture_dispatch(hooks,
+                              nhooks,
+                              p + off + 16,
+                              caplen,
+                              (uint64_t)wipi_get_le32(p + off) * 1000000000ULL +
+                              (uint64_t)wipi_get_le32(p + off + 4) * scale);
+        frames++;
+    }
+
+    return frames;
+}
+
+static int64_t wipi_capture_replay_pcapng(const uint8_t* p,
+                                          size_t len,
+                                          const struct __wipi_capture_hook_t* hooks,
+                                          int nhooks)
+{
+    uint16_t    linktype[WIPI_REPLAY_IFACES];
+    uint8_t     tsresol[WIPI_REPLAY_IFACES];
+    uint32_t    type, blen, iface, caplen;
+    uint64_t    ts;
+    size_t      off, opt;
+    int         nifaces;
+    int64_t     frames;
+
+    nifaces = 0;
+    frames = 0;
+
+    for (off = 0; off + 12 <= len; off += blen)
+    {
+        type = wipi_get_le32(p + off);
+        blen = wipi_get_le32(p + off + 4);
+
+        if (blen < 12 || (blen & 3) || off + blen > len)
+            break;
+
+        switch (type)
+        {
+            case 0x0A0D0D0A:    /* section header - interface ids restart */
+                nifaces = 0;
+                break;
+
+            case 0x00000001:    /* interface description */
+                if (nifaces == WIPI_REPLAY_IFACES || blen < 20)
+                    break;
+
+                linktype[nifaces] = wipi_get_le16(p + off + 8);
+                tsresol[nifaces] = 6;
+
+                for (opt = off + 16; opt + 4 <= off + blen - 4; opt += 4 + ((wipi_get_le16(p + opt + 2) + 3) & ~3))
+                {
+                    if (wipi_get_le16(p + opt) == 0)
+                        break;
+
+                    if (wipi_get_le16(p + opt) == 9 && wipi_get_le16(p + opt + 2) == 1)
+                        tsresol[nifaces] = p[opt + 4];
+                }
+
+                nifaces++;
+                break;
+
+            case 0x00000006:    /* enhanced packet */
+                iface = wipi_get_le32(p + off + 8);
+                caplen = wipi_get_le32(p + off + 20);
+
+                if (iface >= (uint32_t)nifaces || linktype[iface] != WIPI_PCAPNG_LINKTYPE ||
+                    blen < 32 || caplen > blen - 32)
+                    break;
+
+                ts = (uint64_t)wipi_get_le32(p + off + 12) << 32 | wipi_get_le32(p + off + 16);
+
+                /* if_tsresol is a power of 10 (or 2 with the top bit set) */
+                if (tsresol[iface] & 0x80)
+                    ts = (uint64_t)((double)ts * 1e9 / (double)(1ULL << (tsresol[iface] & 0x7F)));
+                else
+                {
+                    for (int r = tsresol[iface]; r < 9; r++)
+                        ts *= 10;
+
+                    for (int r = tsresol[iface]; r > 9; r--)
+                        ts /= 10;
+                }
+
+                wipi_capture_dispatch(hooks, nhooks, p + off + 28, caplen, ts);
+                frames++;
+                break;
+        }
+    }
+
+    return frames;
+}
+
+int wipi_capture_replay(const char* __restrict__ path,
+                        const struct __wipi_capture_hook_t* hooks,
+                        int nhooks)
+{
+    struct stat     st;
+    const uint8_t*  p;
+    int64_t         frames;
+    uint32_t        magic;
+    int             fd;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0 || fstat(fd, &st) < 0 || st.st_size < 24)
+    {
+        if (fd >= 0)
+            close(fd);
+
+        WIPI_ERRNO = WIPI_ERR_IO;
+
+        return -1;
+    }
+
+    p = (const uint8_t*)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (p == MAP_FAILED)
+    {
+        WIPI_ERRNO = WIPI_ERR_IO;
+
+        return -1;
+    }
+
+    madvise((void*)p, st.st_size, MADV_SEQUENTIAL);
+
+    magic = wipi_get_le32(p);
+
+    if (magic == WIPI_PCAP_MAGIC_US || magic == WIPI_PCAP_MAGIC_NS)
+        frames = wipi_capture_replay_pcap(p, st.st_size, hooks, nhooks);
+    else if (magic == 0x0A0D0D0A && wipi_get_le32(p + 8) == WIPI_PCAPNG_MAGIC)
+        frames = wipi_capture_replay_pcapng(p, st.st_size, hooks, nhooks);
+    else
+        frames = -1;
+
+    munmap((void*)p, st.st_size);
+
+    if (frames < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_IO;
+
+        return -1;
+    }
+
+    return (int)frames;
+}
@@ -0,0 +1,112 @@
+/*    wipi_capture.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Passive monitor mode capture for WiPi.
+ * See wipi_capture.c for source definitions.
+ *
+ * Frames are read from a TPACKET_V3 ring shared with the kernel, a
+ * whole block at a time. Every frame in a block is handed to the
+ * registered hooks and, when recording, queued on the pcapng writer
+ * straight out of the ring. The block is only given back to the
+ * kernel once the writer has been flushed.
+ *
+ * Hooks run on the capture thread and must not block.
+ *
+ * wipi_capture_replay() feeds the radiotap frames of a pcap or pcapng
+ * file through the same hooks, for testing and benchmarking them.
+ */
+
+#ifndef _WIPI_CAPTURE_H_
+#define _WIPI_CAPTURE_H_
+
+#ifndef _WIPI_FRAME_H_
+    #include "wipi_frame.h"
+#endif
+
+#ifndef _WIPI_PCAPNG_H_
+    #include "wipi_pcapng.h"
+#endif
+
+/*    INCLUDES    */
+#include <pthread.h>
+
+/*    MACRO DEFS    */
+#define WIPI_CAPTURE_BLOCK_SIZE (1 << 20)
+#define WIPI_CAPTURE_BLOCKS     16
+#define WIPI_CAPTURE_FRAME_SIZE 4096
+#define WIPI_CAPTURE_BLOCK_TMO  64      /* ms, retire a part filled block */
+#define WIPI_CAPTURE_MAX_HOOKS  8
+#define WIPI_CAPTURE_STATS_NS   1000000000ULL
+
+/*    TYPEDEFS    */
+typedef void (*wipi_capture_fn)(void* ctx,
+                                const struct __wipi_frame_t* f,
+                                uint64_t ts_ns);
+
+typedef struct __wipi_capture_hook_t
+{
+    wipi_capture_fn fn;
+    void*           ctx;
+} wipi_capture_hook_t;
+
+typedef struct __wipi_capture_t
+{
+    int                             sockfd;
+    char*                           iface;
+
+    uint8_t*                        ring;
+    size_t                          ring_len;
+    unsigned int                    block;
+
+    struct __wipi_capture_hook_t    hooks[WIPI_CAPTURE_MAX_HOOKS];
+    int                             nhooks;
+
+    struct __wipi_pcapng_t*         writer;
+
+    pthread_mutex_t                 lock;       /* hooks + writer vs. the capture thread */
+    pthread_t                       thread;
+    volatile uint8_t                running;
+
+    uint64_t                        frames;
+    uint64_t                        bytes;
+    uint64_t                        drops;
+    uint64_t                        polled;     /* monotonic ns of last socket stats */
+
+    WIPI_STATUS                     status;
+} wipi_capture_t;
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_capture_t* wipi_capture_init(const char* __restrict__ iface,
+                                           const char* __restrict__ filter);
+
+int wipi_capture_hook(struct __wipi_capture_t* wc,
+                      wipi_capture_fn fn,
+                      void* ctx);
+
+int wipi_capture_record(struct __wipi_capture_t* wc,
+                        const char* __restrict__ dir,
+                        const char* __restrict__ prefix,
+                        uint64_t file_size,
+                        uint64_t file_time,
+                        uint64_t budget);
+
+int wipi_capture_poll(struct __wipi_capture_t* wc,
+                      int timeout_ms);
+
+int wipi_capture_start(struct __wipi_capture_t* wc);
+
+void wipi_capture_stop(struct __wipi_capture_t* wc);
+
+void wipi_capture_free(struct __wipi_capture_t* wc);
+
+int wipi_capture_replay(const char* __restrict__ path,
+                        const struct __wipi_capture_hook_t* hooks,
+                        int nhooks);
+
+#endif
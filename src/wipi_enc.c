@@ -0,0 +1,328 @@
+/*    wipi_enc.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Response body encoder definitions for WiPi.
+ * See wipi_enc.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef _WIPI_ENC_H_
+    #include "wipi_enc.h"
+#endif
+
+/*    FUNCTION DEFINITIONS    */
+static void wipi_enc_put(struct __wipi_enc_t* e, const void* p, size_t n)
+{
+    if (e->overflow || e->len + n > e->cap)
+    {
+        e->overflow = 1;
+
+        return;
+    }
+
+    memcpy(e->buf + e->len, p, n);
+    e->len += n;
+}
+
+static inline void wipi_enc_byte(struct __wipi_enc_t* e, uint8_t b)
+{
+    wipi_enc_put(e, &b, 1);
+}
+
+/* Big endian, as MessagePack wants it */
+static void wipi_enc_be(struct __wipi_enc_t* e, uint8_t tag, uint64_t v, int bytes)
+{
+    uint8_t b[9];
+
+    b[0] = tag;
+
+    for (int i = 0; i < bytes; i++)
+        b[1 + i] = (uint8_t)(v >> (8 * (bytes - 1 - i)));
+
+    wipi_enc_put(e, b, 1 + bytes);
+}
+
+/* JSON separators before a value, values after a key need none */
+static void wipi_enc_item(struct __wipi_enc_t* e)
+{
+    if (e->key)
+    {
+        e->key = 0;
+
+        return;
+    }
+
+    if (e->depth > 0 && e->items[e->depth - 1]++ && e->fmt == WIPI_ENC_JSON)
+        wipi_enc_byte(e, ',');
+}
+
+/* Length of the next valid UTF-8 sequence at s, or minus the length of
+ * the invalid run to replace (the maximal subpart, as Python does) */
+static int wipi_enc_utf8(const uint8_t* s, size_t left)
+{
+    uint8_t lo, hi;
+    int     n;
+
+    if (s[0] < 0x80)
+        return 1;
+    else if (s[0] >= 0xC2 && s[0] <= 0xDF)
+        n = 2;
+    else if (s[0] >= 0xE0 && s[0] <= 0xEF)
+        n = 3;
+    else if (s[0] >= 0xF0 && s[0] <= 0xF4)
+        n = 4;
+    else
+        return -1;
+
+    for (int i = 1; i < n; i++)
+    {
+        lo = 0x80;
+        hi = 0xBF;
+
+        /* No overlongs, surrogates or code points past U+10FFFF */
+        if (i == 1)
+        {
+            if (s[0] == 0xE0)
+                lo = 0xA0;
+            else if (s[0] == 0xED)
+                hi = 0x9F;
+            else if (s[0] == 0xF0)
+                lo = 0x90;
+            else if (s[0] == 0xF4)
+                hi = 0x8F;
+        }
+
+        if ((size_t)i >= left || s[i] < lo || s[i] > hi)
+            return -i;
+    }
+
+    return n;
+}
+
+void wipi_enc_init(struct __wipi_enc_t* e,
+                   WIPI_ENC fmt,
+                   uint8_t* buf,
+                   size_t cap)
+{
+    memset( e, 0, sizeof(struct __wipi_enc_t) );
+
+    e->buf = buf;
+    e->cap = cap;
+    e->fmt = fmt;
+}
+
+static void wipi_enc_open(struct __wipi_enc_t* e, uint32_t n, uint8_t map)
+{
+    wipi_enc_item(e);
+
+    if (e->fmt == WIPI_ENC_JSON)
+        wipi_enc_byte(e, map ? '{' : '[');
+    else if (n < 16)
+        wipi_enc_byte(e, (map ? 0x80 : 0x90) | n);
+    else if (n <= 0xFFFF)
+        wipi_enc_be(e, map ? 0xDE : 0xDC, n, 2);
+    else
+        wipi_enc_be(e, map ? 0xDF : 0xDD, n, 4);
+
+    if (e->depth >= WIPI_ENC_DEPTH)
+    {
+        e->overflow = 1;
+
+        return;
+    }
+
+    e->items[e->depth] = 0;
+    e->map[e->depth] = map;
+    e->depth++;
+}
+
+void wipi_enc_map(struct __wipi_enc_t* e,
+                  uint32_t n)
+{
+    wipi_enc_open(e, n, 1);
+}
+
+void wipi_enc_array(struct __wipi_enc_t* e,
+                    uint32_t n)
+{
+    wipi_enc_open(e, n, 0);
+}
+
+void wipi_enc_end(struct __wipi_enc_t* e)
+{
+    if (e->depth == 0)
+        return;
+
+    e->depth--;
+
+    if (e->fmt == WIPI_ENC_JSON)
+        wipi_enc_byte(e, e->map[e->depth] ? '}' : ']');
+}
+
+void wipi_enc_str(struct __wipi_enc_t* e,
+                  const char* s,
+                  size_t max)
+{
+    static const uint8_t    fffd[] = { 0xEF, 0xBF, 0xBD };
+    const uint8_t*          p;
+    size_t                  len, out;
+    char                    esc[8];
+    int                     n;
+
+    wipi_enc_item(e);
+
+    p = (const uint8_t*)s;
+    len = strnlen(s, max);
+
+    if (e->fmt == WIPI_ENC_MSGPACK)
+    {
+        /* The header carries the length, so measure the cleaned string first */
+        for (size_t i = out = 0; i < len; i += abs(n))
+            out += (n = wipi_enc_utf8(p + i, len - i)) > 0 ? (size_t)n : sizeof(fffd);
+
+        if (out < 32)
+            wipi_enc_byte(e, 0xA0 | out);
+        else if (out <= 0xFF)
+            wipi_enc_be(e, 0xD9, out, 1);
+        else if (out <= 0xFFFF)
+            wipi_enc_be(e, 0xDA, out, 2);
+        else
+            wipi_enc_be(e, 0xDB, out, 4);
+    }
+    else
+        wipi_enc_byte(e, '"');
+
+    for (size_t i = 0; i < len; i += abs(n))
+    {
+        if ((n = wipi_enc_utf8(p + i, len - i)) < 0)
+        {
+            wipi_enc_put(e, fffd, sizeof(fffd));
+            continue;
+        }
+
+        if (e->fmt == WIPI_ENC_JSON && n == 1 && (p[i] < 0x20 || p[i] == '"' || p[i] == '\\'))
+        {
+            if (p[i] == '"' || p[i] == '\\')
+                snprintf(esc, sizeof(esc), "\\%c", p[i]);
+            else if (p[i] >= '\b' && p[i] <= '\r' && p[i] != '\v')
+                snprintf(esc, sizeof(esc), "\\%c", "btn_fr"[p[i] - '\b']);    /* as json.dumps() */
+            else
+                snprintf(esc, sizeof(esc), "\\u%04x", p[i]);
+
+            wipi_enc_put(e, esc, strlen(esc));
+            continue;
+        }
+
+        wipi_enc_put(e, p + i, n);
+    }
+
+    if (e->fmt == WIPI_ENC_JSON)
+        wipi_enc_byte(e, '"');
+}
+
+void wipi_enc_key(struct __wipi_enc_t* e,
+                  const char* key)
+{
+    wipi_enc_str(e, key, (size_t)-1);
+
+    if (e->fmt == WIPI_ENC_JSON)
+        wipi_enc_byte(e, ':');
+
+    e->key = 1;
+}
+
+void wipi_enc_int(struct __wipi_enc_t* e,
+                  int64_t v)
+{
+    char    num[24];
+
+    wipi_enc_item(e);
+
+    if (e->fmt == WIPI_ENC_JSON)
+        wipi_enc_put(e, num, snprintf(num, sizeof(num), "%lld", (long long)v));
+    else if (v >= -32 && v <= 127)
+        wipi_enc_byte(e, (uint8_t)(int8_t)v);
+    else if (v >= 0)
+        wipi_enc_be(e, v <= 0xFF ? 0xCC : v <= 0xFFFF ? 0xCD : v <= 0xFFFFFFFFLL ? 0xCE : 0xCF,
+                    (uint64_t)v, v <= 0xFF ? 1 : v <= 0xFFFF ? 2 : v <= 0xFFFFFFFFLL ? 4 : 8);
+    else
+        wipi_enc_be(e, v >= INT8_MIN ? 0xD0 : v >= INT16_MIN ? 0xD1 : v >= INT32_MIN ? 0xD2 : 0xD3,
+                    (uint64_t)v, v >= INT8_MIN ? 1 : v >= INT16_MIN ? 2 : v >= INT32_MIN ? 4 : 8);
+}
+
+void wipi_enc_float(struct __wipi_enc_t* e,
+                    double v)
+{
+    char    num[32];
+    int     len;
+
+    if (e->fmt == WIPI_ENC_MSGPACK)
+    {
+        uint64_t    bits;
+
+        wipi_enc_item(e);
+        memcpy(&bits, &v, sizeof(bits));
+        wipi_enc_be(e, 0xCB, bits, 8);
+
+        return;
+    }
+
+    if (!isfinite(v))
+    {
+        wipi_enc_null(e);
+
+        return;
+    }
+
+    wipi_enc_item(e);
+
+    /* Shortest form that reads back exactly, like Python's repr() */
+    for (int prec = 15; prec <= 17; prec++)
+    {
+        len = snprintf(num, sizeof(num), "%.*g", prec, v);
+
+        if (strtod(num, NULL) == v)
+            break;
+    }
+
+    /* Keep it a JSON float, 2 -> 2.0 */
+    if (strpbrk(num, ".eEn") == NULL)
+        len += snprintf(num + len, sizeof(num) - len, ".0");
+
+    wipi_enc_put(e, num, len);
+}
+
+void wipi_enc_bool(struct __wipi_enc_t* e,
+                   int v)
+{
+    wipi_enc_item(e);
+
+    if (e->fmt == WIPI_ENC_JSON)
+        wipi_enc_put(e, v ? "true" : "false", v ? 4 : 5);
+    else
+        wipi_enc_byte(e, v ? 0xC3 : 0xC2);
+}
+
+void wipi_enc_null(struct __wipi_enc_t* e)
+{
+    wipi_enc_item(e);
+
+    if (e->fmt == WIPI_ENC_JSON)
+        wipi_enc_put(e, "null", 4);
+    else
+        wipi_enc_byte(e, 0xC0);
+}
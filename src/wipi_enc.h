@@ -0,0 +1,103 @@
+/*    wipi_enc.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Response body encoders for WiPi.
+ * See wipi_enc.c for source definitions.
+ *
+ * One writer emits either compact JSON or MessagePack into a caller
+ * owned buffer, so a structure is described once and encoded twice.
+ * Maps and arrays take their element count up front (MessagePack
+ * needs it) and are closed with wipi_enc_end() (JSON needs that).
+ *
+ * Strings are written as UTF-8 with invalid sequences replaced by
+ * U+FFFD, the same as Python's "replace" error handler. Running out
+ * of room sets overflow and drops the rest, the caller checks it once.
+ */
+
+#ifndef _WIPI_ENC_H_
+#define _WIPI_ENC_H_
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <stdint.h>
+#include <stddef.h>
+
+/*    MACRO DEFS    */
+#define WIPI_ENC_DEPTH  8
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_ENC_JSON,
+    WIPI_ENC_MSGPACK,
+    WIPI_ENCS
+} WIPI_ENC;
+
+typedef struct __wipi_enc_t
+{
+    uint8_t*    buf;
+    size_t      len;
+    size_t      cap;
+
+    WIPI_ENC    fmt;
+
+    int         depth;
+    uint32_t    items[WIPI_ENC_DEPTH];  /* written so far at each level */
+    uint8_t     map[WIPI_ENC_DEPTH];
+    uint8_t     key;                    /* a key was written, its value is next */
+
+    uint8_t     overflow;
+} wipi_enc_t;
+
+/*    STATIC DEFS    */
+static const char* WIPI_ENC_NAMES[] = {
+    "json",
+    "msgpack"
+};
+
+static const char* WIPI_ENC_TYPES[] = {
+    "application/json",
+    "application/msgpack"
+};
+
+/*    FUNCTION DECLS    */
+void wipi_enc_init(struct __wipi_enc_t* e,
+                   WIPI_ENC fmt,
+                   uint8_t* buf,
+                   size_t cap);
+
+void wipi_enc_map(struct __wipi_enc_t* e,
+                  uint32_t n);
+
+void wipi_enc_array(struct __wipi_enc_t* e,
+                    uint32_t n);
+
+void wipi_enc_end(struct __wipi_enc_t* e);
+
+void wipi_enc_key(struct __wipi_enc_t* e,
+                  const char* key);
+
+void wipi_enc_str(struct __wipi_enc_t* e,
+                  const char* s,
+                  size_t max);
+
+void wipi_enc_int(struct __wipi_enc_t* e,
+                  int64_t v);
+
+void wipi_enc_float(struct __wipi_enc_t* e,
+                    double v);
+
+void wipi_enc_bool(struct __wipi_enc_t* e,
+                   int v);
+
+void wipi_enc_null(struct __wipi_enc_t* e);
+
+#endif
@@ -0,0 +1,249 @@
+/*    wipi_flood.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Deauthentication / disassociation flood detection definitions for WiPi.
+ * See wipi_flood.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#ifndef _WIPI_FLOOD_H_
+    #include "wipi_flood.h"
+#endif
+
+/*    FUNCTION DEFINITIONS    */
+static inline uint64_t wipi_flood_mix(uint64_t x)
+{
+    /* splitmix64 finalizer */
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+
+    return x;
+}
+
+/* One 64 bit hash gives a 16 bit column for each of the 4 rows */
+static uint32_t wipi_flood_add(struct __wipi_flood_t* wd, uint64_t h)
+{
+    uint32_t    est, v;
+    size_t      col;
+
+    est = UINT32_MAX;
+
+    for (int r = 0; r < WIPI_FLOOD_DEPTH; r++)
+    {
+        col = (h >> (r * 16)) & (WIPI_FLOOD_WIDTH - 1);
+
+        wd->slots[wd->slot % WIPI_FLOOD_SLOTS][r][col]++;
+        v = ++wd->total[r][col];
+
+        est = v < est ? v : est;
+    }
+
+    return est;
+}
+
+static void wipi_flood_advance(struct __wipi_flood_t* wd, uint64_t slot)
+{
+    uint32_t*   total, *old;
+    uint64_t    n;
+
+    /* Out of order timestamps count toward the current slot */
+    if (slot <= wd->slot)
+        return;
+
+    n = slot - wd->slot < WIPI_FLOOD_SLOTS ? slot - wd->slot : WIPI_FLOOD_SLOTS;
+
+    for (uint64_t s = 1; s <= n; s++)
+    {
+        old = &wd->slots[(wd->slot + s) % WIPI_FLOOD_SLOTS][0][0];
+        total = &wd->total[0][0];
+
+        for (size_t i = 0; i < WIPI_FLOOD_DEPTH * WIPI_FLOOD_WIDTH; i++)
+            total[i] -= old[i];
+
+        memset( old, 0, sizeof(wipi_flood_sketch_t) );
+    }
+
+    wd->slot = slot;
+}
+
+__wur
+struct __wipi_flood_t* wipi_flood_init(int window,
+                                       uint32_t threshold,
+                                       uint32_t bssid_threshold)
+{
+    struct __wipi_flood_t*  wd;
+
+    wd = (struct __wipi_flood_t*)WIPI_ALLOC( sizeof(struct __wipi_flood_t) );
+    assert(wd != NULL);
+
+    memset( wd, 0, sizeof(struct __wipi_flood_t) );
+
+    wd->slot_ns = (uint64_t)(window > 0 ? window : WIPI_FLOOD_WINDOW) * 1000000000ULL / WIPI_FLOOD_SLOTS;
+    wd->threshold = threshold ? threshold : WIPI_FLOOD_THRESHOLD;
+    wd->bssid_threshold = bssid_threshold ? bssid_threshold : WIPI_FLOOD_BSSID_THRESHOLD;
+    wd->next_id = 1;
+
+    pthread_mutex_init(&wd->lock, NULL);
+
+    return wd;
+}
+
+void wipi_flood_callback(struct __wipi_flood_t* wd,
+                         wipi_flood_fn fn,
+                         void* ctx)
+{
+    pthread_mutex_lock(&wd->lock);
+
+    wd->fn = fn;
+    wd->ctx = ctx;
+
+    pthread_mutex_unlock(&wd->lock);
+}
+
+static int wipi_flood_held(struct __wipi_flood_t* wd, uint64_t h)
+{
+    uint64_t*   hold;
+
+    hold = wd->hold[h % WIPI_FLOOD_HOLD];
+
+    return hold[0] == h && wd->slot < hold[1];
+}
+
+static void wipi_flood_raise(struct __wipi_flood_t* wd,
+                             const struct __wipi_frame_t* f,
+                             uint64_t ts_ns,
+                             uint64_t h,
+                             WIPI_FLOOD_SCOPE scope,
+                             uint32_t count)
+{
+    struct __wipi_flood_alert_t*    a;
+    uint64_t*                       hold;
+
+    /* Called with wd->lock held */
+
+    /* Fixed size hold-off table, a collision just evicts the older entry */
+    hold = wd->hold[h % WIPI_FLOOD_HOLD];
+    hold[0] = h;
+    hold[1] = wd->slot + WIPI_FLOOD_SLOTS;
+
+    a = &wd->alerts[wd->next_id % WIPI_FLOOD_ALERTS];
+
+    a->id = wd->next_id++;
+    a->ts = ts_ns;
+    a->scope = scope;
+    a->subtype = WIPI_FC_SUBTYPE(f->fc);
+    a->reason = wipi_get_le16(f->hdr + WIPI_MGMT_HDR_LEN);
+    a->channel = wipi_freq_channel(f->freq);
+    a->count = count;
+
+    memcpy(a->dst, f->hdr + 4, WIPI_MAC_LEN);
+    memcpy(a->src, f->hdr + 10, WIPI_MAC_LEN);
+    memcpy(a->bssid, f->hdr + 16, WIPI_MAC_LEN);
+
+    if (wd->fn)
+        wd->fn(wd->ctx, a);
+}
+
+int wipi_flood_update(struct __wipi_flood_t* wd,
+                      const struct __wipi_frame_t* f,
+                      uint64_t ts_ns)
+{
+    uint64_t    bssid, sender;
+    uint32_t    count;
+    uint8_t     subtype;
+    int         raised;
+
+    /* Every frame from every capture passes here, only the ones counted take the lock */
+    __atomic_fetch_add(&wd->frames, 1, __ATOMIC_RELAXED);
+
+    subtype = WIPI_FC_SUBTYPE(f->fc);
+
+    if (WIPI_FC_TYPE(f->fc) != WIPI_FT_MGMT ||
+        (subtype != WIPI_ST_DEAUTH && subtype != WIPI_ST_DISASSOC) ||
+        f->len < WIPI_MGMT_HDR_LEN + 2)
+        return 0;
+
+    /* Captures on several radios (and replays) share one detector */
+    pthread_mutex_lock(&wd->lock);
+
+    if (subtype == WIPI_ST_DEAUTH)
+        wd->deauths++;
+    else
+        wd->disassocs++;
+
+    wipi_flood_advance(wd, ts_ns / wd->slot_ns);
+
+    bssid = wipi_flood_mix( wipi_mac_key(f->hdr + 16) );
+    sender = wipi_flood_mix( bssid ^ wipi_mac_key(f->hdr + 10) << 16 ^ wipi_get_le16(f->hdr + WIPI_MGMT_HDR_LEN) );
+    raised = 0;
+
+    if ((count = wipi_flood_add(wd, bssid)) >= wd->bssid_threshold && !wipi_flood_held(wd, bssid))
+    {
+        wipi_flood_raise(wd, f, ts_ns, bssid, WIPI_FLOOD_BSSID, count);
+        raised++;
+    }
+
+    /* Once the whole BSSID is reported, spoofed senders add nothing */
+    if ((count = wipi_flood_add(wd, sender)) >= wd->threshold &&
+        !wipi_flood_held(wd, sender) && !wipi_flood_held(wd, bssid))
+    {
+        wipi_flood_raise(wd, f, ts_ns, sender, WIPI_FLOOD_SENDER, count);
+        raised++;
+    }
+
+    pthread_mutex_unlock(&wd->lock);
+
+    return raised;
+}
+
+void wipi_flood_frame(void* ctx,
+                      const struct __wipi_frame_t* f,
+                      uint64_t ts_ns)
+{
+    wipi_flood_update((struct __wipi_flood_t*)ctx, f, ts_ns);
+}
+
+int wipi_flood_alerts(struct __wipi_flood_t* wd,
+                      uint64_t since,
+                      struct __wipi_flood_alert_t* out,
+                      int max)
+{
+    uint64_t    id;
+    int         n;
+
+    pthread_mutex_lock(&wd->lock);
+
+    id = since + 1;
+
+    if (wd->next_id > WIPI_FLOOD_ALERTS && id < wd->next_id - WIPI_FLOOD_ALERTS)
+        id = wd->next_id - WIPI_FLOOD_ALERTS;
+
+    for (n = 0; id < wd->next_id && n < max; id++)
+        out[n++] = wd->alerts[id % WIPI_FLOOD_ALERTS];
+
+    pthread_mutex_unlock(&wd->lock);
+
+    return n;
+}
+
+void wipi_flood_free(struct __wipi_flood_t* wd)
+{
+    if (wd == NULL)
+        return;
+
+    pthread_mutex_destroy(&wd->lock);
+
+    free(wd);
+}
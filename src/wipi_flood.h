@@ -0,0 +1,122 @@
+/*    wipi_flood.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Deauthentication / disassociation flood detection for WiPi.
+ * See wipi_flood.c for source definitions.
+ *
+ * Deauth and disassoc frames are counted per (BSSID, source, reason)
+ * and per BSSID in a count-min sketch over a sliding window. The
+ * window is split into slots, each with its own sketch, and a running
+ * total sketch has the oldest slot subtracted as it expires, so an
+ * estimate is a handful of reads and memory never grows however many
+ * (possibly spoofed) senders there are.
+ *
+ * An alert fires when an estimate crosses its threshold, and is then
+ * held off for a window so a flood raises one alert, not thousands.
+ */
+
+#ifndef _WIPI_FLOOD_H_
+#define _WIPI_FLOOD_H_
+
+#ifndef _WIPI_FRAME_H_
+    #include "wipi_frame.h"
+#endif
+
+/*    INCLUDES    */
+#include <pthread.h>
+
+/*    MACRO DEFS    */
+#define WIPI_FLOOD_DEPTH            4
+#define WIPI_FLOOD_WIDTH            2048    /* power of 2, <= 1 << 16 */
+#define WIPI_FLOOD_SLOTS            10
+#define WIPI_FLOOD_HOLD             256     /* alert hold-off entries */
+#define WIPI_FLOOD_ALERTS           256     /* ring of recent alerts  */
+
+#define WIPI_FLOOD_WINDOW           10      /* s                          */
+#define WIPI_FLOOD_THRESHOLD        30      /* per (BSSID, source, reason) */
+#define WIPI_FLOOD_BSSID_THRESHOLD  100     /* per BSSID, any source      */
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_FLOOD_SENDER,      /* one (BSSID, source, reason) */
+    WIPI_FLOOD_BSSID        /* all frames for a BSSID      */
+} WIPI_FLOOD_SCOPE;
+
+typedef uint32_t wipi_flood_sketch_t[WIPI_FLOOD_DEPTH][WIPI_FLOOD_WIDTH];
+
+typedef struct __wipi_flood_alert_t
+{
+    uint64_t            id;
+    uint64_t            ts;         /* frame timestamp, ns */
+    WIPI_FLOOD_SCOPE    scope;
+
+    uint8_t             subtype;    /* WIPI_ST_DEAUTH or WIPI_ST_DISASSOC */
+    uint8_t             bssid[WIPI_MAC_LEN];
+    uint8_t             src[WIPI_MAC_LEN];
+    uint8_t             dst[WIPI_MAC_LEN];
+    uint16_t            reason;
+    int                 channel;
+
+    uint32_t            count;      /* estimate over the window */
+} wipi_flood_alert_t;
+
+typedef void (*wipi_flood_fn)(void* ctx,
+                              const struct __wipi_flood_alert_t* alert);
+
+typedef struct __wipi_flood_t
+{
+    wipi_flood_sketch_t             total;
+    wipi_flood_sketch_t             slots[WIPI_FLOOD_SLOTS];
+    uint64_t                        slot;       /* current slot number */
+    uint64_t                        slot_ns;
+
+    uint32_t                        threshold;
+    uint32_t                        bssid_threshold;
+
+    uint64_t                        hold[WIPI_FLOOD_HOLD][2];  /* key, slot until */
+
+    struct __wipi_flood_alert_t     alerts[WIPI_FLOOD_ALERTS];
+    uint64_t                        next_id;
+
+    uint64_t                        frames;     /* every frame looked at */
+    uint64_t                        deauths;
+    uint64_t                        disassocs;
+
+    wipi_flood_fn                   fn;
+    void*                           ctx;
+
+    pthread_mutex_t                 lock;       /* sketches, hold-off table and alert ring */
+} wipi_flood_t;
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_flood_t* wipi_flood_init(int window,
+                                       uint32_t threshold,
+                                       uint32_t bssid_threshold);
+
+void wipi_flood_callback(struct __wipi_flood_t* wd,
+                         wipi_flood_fn fn,
+                         void* ctx);
+
+int wipi_flood_update(struct __wipi_flood_t* wd,
+                      const struct __wipi_frame_t* f,
+                      uint64_t ts_ns);
+
+void wipi_flood_frame(void* ctx,
+                      const struct __wipi_frame_t* f,
+                      uint64_t ts_ns);
+
+int wipi_flood_alerts(struct __wipi_flood_t* wd,
+                      uint64_t since,
+                      struct __wipi_flood_alert_t* out,
+                      int max);
+
+void wipi_flood_free(struct __wipi_flood_t* wd);
+
+#endif
@@ -0,0 +1,198 @@
+/*    wipi_frame.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Radiotap + 802.11 frame definitions for WiPi.
+ * See wipi_frame.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#ifndef _WIPI_FRAME_H_
+    #include "wipi_frame.h"
+#endif
+
+/*    STATIC DEFS    */
+/* Alignment and size of each radiotap field in the default namespace */
+static const uint8_t WIPI_RT_ALIGN[WIPI_RT_FIELDS] = {
+    8, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1, 1, 1, 1,
+    2, 2, 1, 1, 4, 1, 4, 2, 8, 2, 2, 2, 1, 2
+};
+
+static const uint8_t WIPI_RT_SIZE[WIPI_RT_FIELDS] = {
+    8, 1, 1, 4, 2, 1, 1, 2, 2, 2, 1, 1, 1, 1,
+    2, 2, 1, 1, 8, 3, 8, 12, 12, 12, 12, 6, 1, 4
+};
+
+/*    FUNCTION DEFINITIONS    */
+int wipi_frame_parse(struct __wipi_frame_t* f,
+                     const uint8_t* pkt,
+                     size_t len)
+{
+    const uint8_t*  v;
+    size_t          rtlen, off;
+    uint32_t        word;
+
+    memset( f, 0, sizeof(struct __wipi_frame_t) );
+
+    f->pkt = pkt;
+    f->pkt_len = len;
+    f->mcs = 0xFF;
+
+    if (len < 8 || pkt[0] != 0)
+        return -1;
+
+    rtlen = wipi_get_le16(pkt + 2);
+
+    if (rtlen < 8 || rtlen > len)
+        return -1;
+
+    f->present = word = wipi_get_le32(pkt + 4);
+    off = 8;
+
+    /* Fields only start after the last extended present word */
+    while (word & (1U << 31))
+    {
+        if (off + 4 > rtlen)
+            return -1;
+
+        word = wipi_get_le32(pkt + off);
+        off += 4;
+    }
+
+    for (int i = 0; i < WIPI_RT_FIELDS; i++)
+    {
+        if (!(f->present & (1U << i)))
+            continue;
+
+        off = (off + WIPI_RT_ALIGN[i] - 1) & ~(size_t)(WIPI_RT_ALIGN[i] - 1);
+
+        if (off + WIPI_RT_SIZE[i] > rtlen)
+            break;
+
+        v = pkt + off;
+
+        switch (i)
+        {
+            case WIPI_RT_TSFT:
+                f->tsft = wipi_get_le64(v);
+                break;
+
+            case WIPI_RT_FLAGS:
+                f->rt_flags = v[0];
+                break;
+
+            case WIPI_RT_RATE:
+                f->rate = v[0];
+                break;
+
+            case WIPI_RT_CHANNEL:
+                f->freq = wipi_get_le16(v);
+                f->chan_flags = wipi_get_le16(v + 2);
+                break;
+
+            case WIPI_RT_DBM_SIGNAL:
+                f->signal = (int8_t)v[0];
+                break;
+
+            case WIPI_RT_MCS:
+                f->mcs = v[2];
+                f->mcs_flags = v[1];
+                break;
+
+            case WIPI_RT_VHT:
+                f->vht_flags = v[2];
+                f->vht_bw = v[3];
+                f->vht_mcs = v[4];
+                break;
+        }
+
+        off += WIPI_RT_SIZE[i];
+    }
+
+    f->hdr = pkt + rtlen;
+    f->len = len - rtlen;
+
+    if (f->rt_flags & WIPI_RT_F_FCS)
+    {
+        if (f->len < 4)
+            return -1;
+
+        f->len -= 4;
+    }
+
+    if (f->len < 2)
+        return -1;
+
+    f->fc = wipi_get_le16(f->hdr);
+
+    if (f->len >= WIPI_MGMT_HDR_LEN)
+        f->seq = wipi_get_le16(f->hdr + 22) >> 4;
+
+    return 0;
+}
+
+int wipi_frame_beacon(const struct __wipi_frame_t* f,
+                      struct __wipi_beacon_t* wb)
+{
+    const uint8_t*  body, *ssid, *ds;
+    uint8_t         ssid_len, ds_len;
+
+    if (WIPI_FC_TYPE(f->fc) != WIPI_FT_MGMT ||
+        (WIPI_FC_SUBTYPE(f->fc) != WIPI_ST_BEACON && WIPI_FC_SUBTYPE(f->fc) != WIPI_ST_PROBE_RESP) ||
+        f->len < WIPI_MGMT_HDR_LEN + WIPI_BEACON_FIXED)
+        return -1;
+
+    memset( wb, 0, sizeof(struct __wipi_beacon_t) );
+
+    body = f->hdr + WIPI_MGMT_HDR_LEN;
+
+    /* addr3 is the BSSID for frames sent by an AP */
+    memcpy(wb->addr, f->hdr + 16, WIPI_MAC_LEN);
+    snprintf(wb->bssid,
+             WIPI_MAX_BSSID,
+             "%02X:%02X:%02X:%02X:%02X:%02X",
+             wb->addr[0], wb->addr[1], wb->addr[2],
+             wb->addr[3], wb->addr[4], wb->addr[5]);
+
+    wb->ie = body + WIPI_BEACON_FIXED;
+    wb->ie_len = f->len - WIPI_MGMT_HDR_LEN - WIPI_BEACON_FIXED;
+
+    ssid = wipi_ie_find(wb->ie, wb->ie_len, WIPI_IE_SSID, -1, &ssid_len);
+
+    /* All 32 bytes, a full length SSID is left without a NUL */
+    if (ssid)
+        memcpy( wb->ssid, ssid, ssid_len < WIPI_MAX_SSID ? ssid_len : WIPI_MAX_SSID );
+
+    wipi_ie_parse(wb->ie, wb->ie_len, wipi_get_le16(body + 10), &wb->caps);
+
+    wb->freq_mhz = f->freq;
+    wb->channel = wipi_freq_channel(f->freq);
+    wb->band = wipi_freq_band(f->freq);
+
+    /* 2.4GHz beacons leak into neighbouring channels, the AP says where it really is */
+    ds = wipi_ie_find(wb->ie, wb->ie_len, WIPI_IE_DS_PARAMS, -1, &ds_len);
+
+    if (ds && ds_len == 1 && ds[0] != wb->channel && wipi_channel_freq(ds[0], wb->band) > 0)
+    {
+        wb->channel = ds[0];
+        wb->freq_mhz = (uint16_t)wipi_channel_freq(ds[0], wb->band);
+    }
+
+    /* Fixed fields: timestamp, beacon interval, capability */
+    wb->tsf = wipi_get_le64(body);
+    wb->beacon_int = wipi_get_le16(body + 8);
+
+    wb->freq = (double)wb->freq_mhz / 1000; /* MHz to GHz */
+    wb->db = f->signal;
+    wb->seen = wipi_stats_now();
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*    wipi_frame.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Radiotap + 802.11 frame decoding for WiPi.
+ * See wipi_frame.c for source definitions.
+ *
+ * Frames read from a monitor socket start with a radiotap header,
+ * followed by the 802.11 frame. wipi_frame_parse() never copies -
+ * every pointer in wipi_frame_t points back into the packet.
+ */
+
+#ifndef _WIPI_FRAME_H_
+#define _WIPI_FRAME_H_
+
+#ifndef _WIPI_H_
+    #include "wipi.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_RT_TSFT        0
+#define WIPI_RT_FLAGS       1
+#define WIPI_RT_RATE        2
+#define WIPI_RT_CHANNEL     3
+#define WIPI_RT_DBM_SIGNAL  5
+#define WIPI_RT_MCS         19
+#define WIPI_RT_VHT         21
+#define WIPI_RT_FIELDS      28  /* fields we know the size of */
+
+#define WIPI_RT_F_SHORTPRE  0x02
+#define WIPI_RT_F_FCS       0x10
+#define WIPI_RT_F_BADFCS    0x40
+
+#define WIPI_FC_TYPE(fc)    (((fc) >> 2) & 0x3)
+#define WIPI_FC_SUBTYPE(fc) (((fc) >> 4) & 0xF)
+#define WIPI_FC_TODS        0x0100
+#define WIPI_FC_FROMDS      0x0200
+#define WIPI_FC_RETRY       0x0800
+
+#define WIPI_FT_MGMT        0
+#define WIPI_FT_CTRL        1
+#define WIPI_FT_DATA        2
+
+#define WIPI_ST_PROBE_RESP  5
+#define WIPI_ST_BEACON      8
+#define WIPI_ST_DISASSOC    10
+#define WIPI_ST_DEAUTH      12
+
+#define WIPI_MGMT_HDR_LEN   24
+#define WIPI_BEACON_FIXED   12  /* timestamp, interval, capability */
+
+/*    TYPEDEFS    */
+typedef struct __wipi_frame_t
+{
+    const uint8_t*  pkt;
+    size_t          pkt_len;
+
+    const uint8_t*  hdr;        /* 802.11 header          */
+    size_t          len;        /* 802.11 length, no FCS  */
+
+    uint32_t        present;    /* radiotap present word  */
+    uint64_t        tsft;
+    uint16_t        freq;
+    uint16_t        chan_flags;
+    int8_t          signal;
+    uint8_t         rt_flags;
+    uint8_t         rate;       /* 500kbps units          */
+
+    uint8_t         mcs;        /* HT MCS index, 0xFF = none     */
+    uint8_t         mcs_flags;  /* HT bandwidth + guard interval */
+    uint8_t         vht_mcs;    /* user 0 MCS << 4 | NSS, 0 = none */
+    uint8_t         vht_flags;
+    uint8_t         vht_bw;
+
+    uint16_t        fc;
+    uint16_t        seq;        /* sequence number        */
+} wipi_frame_t;
+
+/*    FUNCTION DECLS    */
+static inline uint16_t wipi_get_le16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static inline uint32_t wipi_get_le32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline uint64_t wipi_get_le64(const uint8_t* p)
+{
+    return (uint64_t)wipi_get_le32(p) | (uint64_t)wipi_get_le32(p + 4) << 32;
+}
+
+int wipi_frame_parse(struct __wipi_frame_t* f,
+                     const uint8_t* pkt,
+                     size_t len);
+
+int wipi_frame_beacon(const struct __wipi_frame_t* f,
+                      struct __wipi_beacon_t* wb);
+
+#endif
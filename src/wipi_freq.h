@@ -0,0 +1,149 @@
+/*    wipi_freq.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Frequency <-> channel mapping for WiPi.
+ *
+ * Everything works on integer MHz and is plain arithmetic, so a
+ * lookup is a couple of compares. Covers 2.4 GHz (1-14), 4.9/5 GHz
+ * and 6 GHz (1-233, plus channel 2 at 5935 MHz).
+ */
+
+#ifndef _WIPI_FREQ_H_
+#define _WIPI_FREQ_H_
+
+/*    INCLUDES    */
+#include <stdint.h>
+#include <string.h>
+
+/*    MACRO DEFS    */
+#define WIPI_BAND_FREQS_MAX 32  /* IW_MAX_FREQUENCIES */
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_BAND_UNKNOWN,
+    WIPI_BAND_2G,
+    WIPI_BAND_5G,
+    WIPI_BAND_6G
+} WIPI_BAND;
+
+/*    STATIC DEFS    */
+static const char* WIPI_BAND_NAMES[] = {
+    "unknown",
+    "2.4",
+    "5",
+    "6"
+};
+
+/*    FUNCTION DECLS    */
+static inline WIPI_BAND wipi_freq_band(int mhz)
+{
+    if (mhz >= 2412 && mhz <= 2484)
+        return WIPI_BAND_2G;
+
+    if (mhz >= 5935 && mhz <= 7115)
+        return WIPI_BAND_6G;
+
+    if (mhz >= 4910 && mhz <= 5895)
+        return WIPI_BAND_5G;
+
+    return WIPI_BAND_UNKNOWN;
+}
+
+static inline int wipi_freq_channel(int mhz)
+{
+    switch (wipi_freq_band(mhz))
+    {
+        case WIPI_BAND_2G:
+            return mhz == 2484 ? 14 : (mhz - 2407) / 5;
+
+        case WIPI_BAND_5G:
+            return mhz < 5000 ? (mhz - 4000) / 5 : (mhz - 5000) / 5;
+
+        case WIPI_BAND_6G:
+            return mhz == 5935 ? 2 : (mhz - 5950) / 5;
+
+        default:
+            return 0;
+    }
+}
+
+static inline int wipi_channel_freq(int channel, WIPI_BAND band)
+{
+    switch (band)
+    {
+        case WIPI_BAND_2G:
+            return channel == 14 ? 2484 : channel >= 1 && channel <= 13 ? 2407 + channel * 5 : 0;
+
+        case WIPI_BAND_5G:
+            return channel >= 182 && channel <= 196 ? 4000 + channel * 5 :
+                   channel >= 1 && channel <= 177 ? 5000 + channel * 5 : 0;
+
+        case WIPI_BAND_6G:
+            return channel == 2 ? 5935 : channel >= 1 && channel <= 233 ? 5950 + channel * 5 : 0;
+
+        default:
+            return 0;
+    }
+}
+
+static inline WIPI_BAND wipi_band_from_name(const char* name)
+{
+    for (int i = WIPI_BAND_2G; i <= WIPI_BAND_6G; i++)
+    {
+        if (strcmp(name, WIPI_BAND_NAMES[i]) == 0)
+            return (WIPI_BAND)i;
+    }
+
+    return WIPI_BAND_UNKNOWN;
+}
+
+/* 20 MHz primaries worth scanning - 6 GHz is limited to the PSCs so
+ * every band fits in one SIOCSIWSCAN channel list. */
+static inline int wipi_band_freqs(WIPI_BAND band, int* freqs, int max)
+{
+    int n;
+
+    n = 0;
+
+    switch (band)
+    {
+        case WIPI_BAND_2G:
+            for (int ch = 1; ch <= 13 && n < max; ch++)
+                freqs[n++] = wipi_channel_freq(ch, band);
+
+            break;
+
+        case WIPI_BAND_5G:
+            for (int ch = 36; ch <= 177 && n < max; ch += 4)
+            {
+                if (ch > 64 && ch < 100)
+                    continue;
+
+                if (ch > 144 && ch < 149)
+                    ch = 149;
+
+                freqs[n++] = wipi_channel_freq(ch, band);
+            }
+
+            break;
+
+        case WIPI_BAND_6G:
+            for (int ch = 5; ch <= 229 && n < max; ch += 16)
+                freqs[n++] = wipi_channel_freq(ch, band);
+
+            break;
+
+        default:
+            break;
+    }
+
+    return n;
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*    wipi_group.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Multi-radio scanner group definitions for WiPi.
+ * See wipi_group.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#ifndef _WIPI_GROUP_H_
+    #include "wipi_group.h"
+#endif
+
+/*    FUNCTION DEFINITIONS    */
+__wur
+struct __wipi_scanner_group_t* wipi_scanner_group_init(WIPI_MERGE policy)
+{
+    struct __wipi_scanner_group_t*  wg;
+
+    wg = (struct __wipi_scanner_group_t*)WIPI_ALLOC( sizeof(struct __wipi_scanner_group_t) );
+    assert(wg != NULL);
+
+    memset( wg, 0, sizeof(struct __wipi_scanner_group_t) );
+
+    wg->table = wipi_aptable_init(0);
+    wg->policy = policy;
+    wg->timeout_ms = WIPI_SCAN_TIMEOUT_MS;
+
+    return wg;
+}
+
+int wipi_scanner_group_add(struct __wipi_scanner_group_t* wg,
+                           const char* __restrict__ iface,
+                           const int* freqs,
+                           int nfreqs)
+{
+    struct __wipi_radio_t*  r;
+
+    assert(wg != NULL && iface != NULL);
+
+    if (wg->count >= WIPI_MAX_RADIOS)
+    {
+        WIPI_ERRNO = WIPI_ERR_RANGE;
+
+        return -1;
+    }
+
+    r = &wg->radios[wg->count];
+    memset( r, 0, sizeof(struct __wipi_radio_t) );
+
+    r->ws = wipi_scanner_init(iface);
+
+    if (r->ws == NULL)
+        return -1;
+
+    if (freqs && nfreqs > 0)
+    {
+        r->nfreqs = nfreqs < IW_MAX_FREQUENCIES ? nfreqs : IW_MAX_FREQUENCIES;
+        memcpy( r->freqs, freqs, r->nfreqs * sizeof(int) );
+    }
+
+    return wg->count++;
+}
+
+static void wipi_scanner_group_merge(struct __wipi_scanner_group_t* wg, int radio)
+{
+    struct __wipi_scanner_t*    ws;
+    struct __wipi_beacon_t      wb;
+    uint64_t                    t0;
+
+    ws = wg->radios[radio].ws;
+
+    for (ws->res = ws->wsh.result; ws->res; ws->res = ws->res->next)
+    {
+        t0 = wipi_stats_now();
+
+        wipi_populate_beacon(&wb, ws);
+
+        wb.radio = radio;
+        wb.radios = 1U << radio;
+
+        wipi_aptable_merge(wg->table, &wb, wg->policy);
+
+        wipi_stats_observe(WIPI_HIST_PARSE, wipi_stats_now() - t0);
+        wipi_stats_add(WIPI_STAT_SCAN_APS, 1);
+    }
+}
+
+int wipi_scanner_group_scan(struct __wipi_scanner_group_t* wg)
+{
+    struct __wipi_radio_t*  r;
+    uint64_t                t0, now;
+    int                     live, ok, done;
+
+    assert(wg != NULL);
+
+    t0 = wipi_stats_now();
+    live = ok = 0;
+
+    /* Kick every radio off before waiting on any of them */
+    for (int i = 0; i < wg->count; i++)
+    {
+        r = &wg->radios[i];
+
+        r->pending = wipi_scanner_trigger(r->ws, r->freqs, r->nfreqs) == 0;
+        r->status = r->pending ? WIPI_ERR_OK : WIPI_ERR_SCAN;
+
+        live += r->pending;
+    }
+
+    wipi_aptable_clear(wg->table);
+
+    while (live)
+    {
+        now = wipi_stats_now();
+
+        for (int i = 0; i < wg->count; i++)
+        {
+            r = &wg->radios[i];
+
+            if (!r->pending)
+                continue;
+
+            done = wipi_scanner_collect(r->ws);
+
+            if (done == 0 && now - t0 < wg->timeout_ms * 1000000ULL)
+                continue;
+
+            r->pending = 0;
+            live--;
+
+            if (done <= 0)
+            {
+                r->status = WIPI_ERR_SCAN;
+
+                wipi_stats_add(WIPI_STAT_SCAN_ERRORS, 1);
+
+                continue;
+            }
+
+            wipi_stats_observe(WIPI_HIST_SCAN, wipi_stats_now() - r->ws->triggered);
+            wipi_stats_add(WIPI_STAT_SCANS, 1);
+
+            wipi_scanner_group_merge(wg, i);
+
+            ok++;
+        }
+
+        if (live)
+            usleep(WIPI_SCAN_POLL_US);
+    }
+
+    if (ok == 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_SCAN;
+
+        return -1;
+    }
+
+    return (int)wg->table->count;
+}
+
+void wipi_scanner_group_free(struct __wipi_scanner_group_t* wg)
+{
+    if (wg == NULL)
+        return;
+
+    for (int i = 0; i < wg->count; i++)
+        wipi_scanner_free(wg->radios[i].ws);
+
+    wipi_aptable_free(wg->table);
+
+    free(wg);
+}
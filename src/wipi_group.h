@@ -0,0 +1,64 @@
+/*    wipi_group.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Multi-radio scanner groups for WiPi.
+ * See wipi_group.c for source definitions.
+ *
+ * A group triggers a scan on every radio at once and then polls
+ * them all from a single loop, so a sweep takes as long as the
+ * slowest radio rather than the sum of them. Each radio can be
+ * limited to its own channel set (e.g. one radio per band).
+ */
+
+#ifndef _WIPI_GROUP_H_
+#define _WIPI_GROUP_H_
+
+#ifndef _WIPI_APTABLE_H_
+    #include "wipi_aptable.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_MAX_RADIOS 8
+
+/*    TYPEDEFS    */
+typedef struct __wipi_radio_t
+{
+    struct __wipi_scanner_t*    ws;
+
+    int                         freqs[IW_MAX_FREQUENCIES];  /* MHz */
+    int                         nfreqs;
+
+    uint8_t                     pending;
+    WIPI_STATUS                 status;
+} wipi_radio_t;
+
+typedef struct __wipi_scanner_group_t
+{
+    struct __wipi_radio_t       radios[WIPI_MAX_RADIOS];
+    int                         count;
+
+    struct __wipi_aptable_t*    table;
+
+    WIPI_MERGE                  policy;
+    int                         timeout_ms;
+} wipi_scanner_group_t;
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_scanner_group_t* wipi_scanner_group_init(WIPI_MERGE policy);
+
+int wipi_scanner_group_add(struct __wipi_scanner_group_t* wg,
+                           const char* __restrict__ iface,
+                           const int* freqs,
+                           int nfreqs);
+
+int wipi_scanner_group_scan(struct __wipi_scanner_group_t* wg);
+
+void wipi_scanner_group_free(struct __wipi_scanner_group_t* wg);
+
+#endif
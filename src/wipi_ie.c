@@ -0,0 +1,360 @@
+/*    wipi_ie.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* 802.11 information element definitions for WiPi.
+ * See wipi_ie.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <string.h>
+
+#ifndef _WIPI_IE_H_
+    #include "wipi_ie.h"
+#endif
+
+/*    STATIC DEFS    */
+static const uint8_t WIPI_OUI_RSN[3] = { 0x00, 0x0F, 0xAC };
+static const uint8_t WIPI_OUI_MS[3]  = { 0x00, 0x50, 0xF2 };
+
+/*    FUNCTION DEFINITIONS    */
+static inline uint16_t wipi_le16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static uint8_t wipi_ie_cipher(const uint8_t* suite, const uint8_t* oui)
+{
+    if (memcmp(suite, oui, 3) != 0)
+        return 0;
+
+    switch (suite[3])
+    {
+        case 1:
+        case 5:  return WIPI_CIPHER_WEP;
+        case 2:  return WIPI_CIPHER_TKIP;
+        case 4:  return WIPI_CIPHER_CCMP;
+        case 8:  return WIPI_CIPHER_GCMP;
+        case 9:  return WIPI_CIPHER_GCMP256;
+        case 10: return WIPI_CIPHER_CCMP256;
+    }
+
+    return 0;
+}
+
+/* RSN and the legacy WPA vendor IE share a layout, just not an OUI */
+static void wipi_ie_rsn(const uint8_t* b,
+                        size_t n,
+                        const uint8_t* oui,
+                        struct __wipi_caps_t* caps)
+{
+    size_t      off;
+    uint16_t    count, rsncap;
+
+    caps->group    |= WIPI_CIPHER_CCMP;
+    caps->pairwise |= oui == WIPI_OUI_RSN ? WIPI_CIPHER_CCMP : WIPI_CIPHER_TKIP;
+
+    if (n < 2 + 4)
+    {
+        caps->akm |= WIPI_AKM_8021X;
+
+        return;
+    }
+
+    off = 2;    /* version */
+
+    caps->group = wipi_ie_cipher(b + off, oui);
+    off += 4;
+
+    if (off + 2 > n)
+    {
+        caps->akm |= WIPI_AKM_8021X;
+
+        return;
+    }
+
+    count = wipi_le16(b + off);
+    off += 2;
+
+    caps->pairwise = 0;
+
+    for (uint16_t i = 0; i < count && off + 4 <= n; i++, off += 4)
+        caps->pairwise |= wipi_ie_cipher(b + off, oui);
+
+    if (off + 2 > n)
+    {
+        caps->akm |= WIPI_AKM_8021X;
+
+        return;
+    }
+
+    count = wipi_le16(b + off);
+    off += 2;
+
+    for (uint16_t i = 0; i < count && off + 4 <= n; i++, off += 4)
+    {
+        if (memcmp(b + off, oui, 3) == 0 && b[off + 3] < 32)
+            caps->akm |= WIPI_AKM(b[off + 3]);
+    }
+
+    if (oui == WIPI_OUI_RSN && off + 2 <= n)
+    {
+        rsncap = wipi_le16(b + off);
+
+        caps->pmf = rsncap & 0x0040 ? 2 : rsncap & 0x0080 ? 1 : 0;
+    }
+}
+
+/* 2 bits per spatial stream, 3 = unsupported */
+static uint8_t wipi_ie_mcs_map_nss(uint16_t map)
+{
+    uint8_t nss;
+
+    nss = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        if (((map >> (i * 2)) & 3) != 3)
+            nss = i + 1;
+    }
+
+    return nss;
+}
+
+static WIPI_WIDTH wipi_ie_seg_width(uint8_t ccfs0, uint8_t ccfs1)
+{
+    int diff;
+
+    if (ccfs1 == 0)
+        return WIPI_WIDTH_80;
+
+    diff = ccfs1 > ccfs0 ? ccfs1 - ccfs0 : ccfs0 - ccfs1;
+
+    return diff == 8 ? WIPI_WIDTH_160 : WIPI_WIDTH_80P80;
+}
+
+static void wipi_ie_he_op(const uint8_t* b,
+                          size_t n,
+                          struct __wipi_caps_t* caps)
+{
+    uint32_t    params;
+    size_t      off;
+    uint8_t     ctrl;
+    WIPI_WIDTH  w;
+
+    if (n < 6)
+        return;
+
+    params = b[0] | b[1] << 8 | b[2] << 16;
+    off = 6;    /* params, BSS colour, basic HE-MCS */
+
+    if (params & (1 << 14))     /* VHT operation info */
+        off += 3;
+
+    if (params & (1 << 15))     /* co-hosted BSS */
+        off += 1;
+
+    if (!(params & (1 << 17)) || off + 5 > n)
+        return;
+
+    /* 6 GHz operation info: primary, control, CCFS0, CCFS1, min rate */
+    ctrl = b[off + 1] & 0x03;
+    w = ctrl == 3 ? wipi_ie_seg_width(b[off + 2], b[off + 3]) : (WIPI_WIDTH)ctrl;
+
+    if (w > caps->width)
+        caps->width = w;
+}
+
+void wipi_ie_parse(const uint8_t* ie,
+                   size_t len,
+                   uint16_t capab,
+                   struct __wipi_caps_t* caps)
+{
+    struct __wipi_caps_t    sub;
+    const uint8_t*          b, *end;
+    uint8_t                 id, n, nss;
+    WIPI_WIDTH              w;
+
+    memset( caps, 0, sizeof(struct __wipi_caps_t) );
+
+    caps->privacy = (capab & WIPI_CAPAB_PRIVACY) != 0;
+
+    end = ie + len;
+
+    for (; ie && ie + 2 <= end; ie = b + n)
+    {
+        id = ie[0];
+        n  = ie[1];
+        b  = ie + 2;
+
+        if (b + n > end)
+            break;
+
+        nss = 0;
+        w = WIPI_WIDTH_20;
+
+        switch (id)
+        {
+            case WIPI_IE_COUNTRY:
+                if (n >= 2)
+                    memcpy(caps->country, b, 2);
+
+                break;
+
+            case WIPI_IE_HT_CAP:
+                caps->ht = 1;
+
+                for (int i = 3; i < 7 && i < n; i++)
+                    nss += b[i] != 0;
+
+                break;
+
+            case WIPI_IE_HT_OP:
+                if (n >= 2 && (b[1] & 0x04) && (b[1] & 0x03))
+                    w = WIPI_WIDTH_40;
+
+                break;
+
+            case WIPI_IE_VHT_CAP:
+                caps->vht = 1;
+
+                if (n >= 6)
+                    nss = wipi_ie_mcs_map_nss( wipi_le16(b + 4) );
+
+                break;
+
+            case WIPI_IE_VHT_OP:
+                if (n < 3 || b[0] == 0)
+                    break;
+
+                w = b[0] == 1 ? wipi_ie_seg_width(b[1], b[2]) :
+                    b[0] == 2 ? WIPI_WIDTH_160 : WIPI_WIDTH_80P80;
+
+                break;
+
+            case WIPI_IE_RSN:
+                memset( &sub, 0, sizeof(sub) );
+                wipi_ie_rsn(b, n, WIPI_OUI_RSN, &sub);
+
+                caps->rsn = 1;
+                caps->pairwise |= sub.pairwise;
+                caps->group     = sub.group;
+                caps->akm       = sub.akm;
+                caps->pmf       = sub.pmf;
+
+                break;
+
+            case WIPI_IE_VENDOR:
+                caps->vendor_ies += caps->vendor_ies < 0xFF;
+
+                if (n >= 4 && memcmp(b, WIPI_OUI_MS, 3) == 0)
+                {
+                    if (b[3] == 1 && !caps->wpa)
+                    {
+                        memset( &sub, 0, sizeof(sub) );
+                        wipi_ie_rsn(b + 4, n - 4, WIPI_OUI_MS, &sub);
+
+                        /* Mixed mode APs - RSN's group and AKMs win */
+                        caps->wpa = 1;
+                        caps->pairwise |= sub.pairwise;
+
+                        if (!caps->rsn)
+                        {
+                            caps->group = sub.group;
+                            caps->akm   = sub.akm;
+                        }
+                    }
+                    else if (b[3] == 4)
+                        caps->wps = 1;
+                }
+
+                break;
+
+            case WIPI_IE_EXT:
+                if (n < 1)
+                    break;
+
+                if (b[0] == WIPI_IE_EXT_HE_CAP)
+                {
+                    caps->he = 1;
+
+                    /* ext id, MAC caps (6), PHY caps (11), Rx HE-MCS <= 80 */
+                    if (n >= 1 + 17 + 2)
+                        nss = wipi_ie_mcs_map_nss( wipi_le16(b + 18) );
+                }
+                else if (b[0] == WIPI_IE_EXT_HE_OP)
+                    wipi_ie_he_op(b + 1, n - 1, caps);
+
+                break;
+        }
+
+        if (nss > caps->nss)
+            caps->nss = nss > 7 ? 7 : nss;
+
+        if (w > caps->width)
+            caps->width = w;
+    }
+
+    if (caps->rsn)
+    {
+        if (caps->akm & (WIPI_AKM_SAE | WIPI_AKM_FT_SAE | WIPI_AKM_SAE_EXT))
+            caps->security = caps->akm & (WIPI_AKM_PSK | WIPI_AKM_FT_PSK | WIPI_AKM_PSK_256) ?
+                             WIPI_SEC_WPA2_WPA3 : WIPI_SEC_WPA3;
+        else if (caps->akm & WIPI_AKM_OWE)
+            caps->security = WIPI_SEC_OWE;
+        else if (caps->akm & WIPI_AKM_SUITE_B192)
+            caps->security = WIPI_SEC_WPA3;
+        else
+            caps->security = WIPI_SEC_WPA2;
+    }
+    else if (caps->wpa)
+        caps->security = WIPI_SEC_WPA;
+    else if (caps->privacy)
+        caps->security = WIPI_SEC_WEP;
+    else
+        caps->security = WIPI_SEC_OPEN;
+
+    caps->enterprise = (caps->akm & (WIPI_AKM_8021X | WIPI_AKM_FT_8021X | WIPI_AKM_8021X_256 |
+                                     WIPI_AKM_SUITE_B | WIPI_AKM_SUITE_B192)) != 0;
+}
+
+const uint8_t* wipi_ie_find(const uint8_t* ie,
+                            size_t len,
+                            uint8_t id,
+                            int ext,
+                            uint8_t* out_len)
+{
+    const uint8_t*  end;
+
+    end = ie + len;
+
+    for (; ie && ie + 2 <= end && ie + 2 + ie[1] <= end; ie += 2 + ie[1])
+    {
+        if (ie[0] != id)
+            continue;
+
+        if (ext < 0)
+        {
+            *out_len = ie[1];
+
+            return ie + 2;
+        }
+
+        if (ie[1] >= 1 && ie[2] == ext)
+        {
+            *out_len = ie[1] - 1;
+
+            return ie + 3;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,174 @@
+/*    wipi_ie.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* 802.11 information element parsing for WiPi.
+ * See wipi_ie.c for source definitions.
+ *
+ * wipi_ie_parse() walks the IE list once and packs everything we
+ * filter on into a wipi_caps_t. Anything rarer is left in the raw
+ * buffer and decoded on demand with wipi_ie_find().
+ */
+
+#ifndef _WIPI_IE_H_
+#define _WIPI_IE_H_
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <stdint.h>
+#include <stddef.h>
+
+/*    MACRO DEFS    */
+#define WIPI_IE_SSID        0
+#define WIPI_IE_DS_PARAMS   3
+#define WIPI_IE_COUNTRY     7
+#define WIPI_IE_HT_CAP      45
+#define WIPI_IE_RSN         48
+#define WIPI_IE_HT_OP       61
+#define WIPI_IE_VHT_CAP     191
+#define WIPI_IE_VHT_OP      192
+#define WIPI_IE_VENDOR      221
+#define WIPI_IE_EXT         255
+
+#define WIPI_IE_EXT_HE_CAP  35
+#define WIPI_IE_EXT_HE_OP   36
+
+#define WIPI_CAPAB_PRIVACY  0x0010
+
+#define WIPI_CIPHER_WEP     0x01
+#define WIPI_CIPHER_TKIP    0x02
+#define WIPI_CIPHER_CCMP    0x04
+#define WIPI_CIPHER_GCMP    0x08
+#define WIPI_CIPHER_GCMP256 0x10
+#define WIPI_CIPHER_CCMP256 0x20
+#define WIPI_CIPHERS        6
+
+#define WIPI_AKM(n)         (1U << (n))     /* 00-0F-AC suite type n */
+#define WIPI_AKM_8021X      WIPI_AKM(1)
+#define WIPI_AKM_PSK        WIPI_AKM(2)
+#define WIPI_AKM_FT_8021X   WIPI_AKM(3)
+#define WIPI_AKM_FT_PSK     WIPI_AKM(4)
+#define WIPI_AKM_8021X_256  WIPI_AKM(5)
+#define WIPI_AKM_PSK_256    WIPI_AKM(6)
+#define WIPI_AKM_SAE        WIPI_AKM(8)
+#define WIPI_AKM_FT_SAE     WIPI_AKM(9)
+#define WIPI_AKM_SUITE_B    WIPI_AKM(11)
+#define WIPI_AKM_SUITE_B192 WIPI_AKM(12)
+#define WIPI_AKM_OWE        WIPI_AKM(18)
+#define WIPI_AKM_SAE_EXT    WIPI_AKM(24)
+#define WIPI_AKMS           26
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_SEC_OPEN,
+    WIPI_SEC_WEP,
+    WIPI_SEC_WPA,
+    WIPI_SEC_WPA2,
+    WIPI_SEC_WPA3,
+    WIPI_SEC_WPA2_WPA3,
+    WIPI_SEC_OWE
+} WIPI_SECURITY;
+
+typedef enum
+{
+    WIPI_WIDTH_20,
+    WIPI_WIDTH_40,
+    WIPI_WIDTH_80,
+    WIPI_WIDTH_160,
+    WIPI_WIDTH_80P80
+} WIPI_WIDTH;
+
+typedef struct __wipi_caps_t
+{
+    uint32_t    akm;                /* WIPI_AKM() bits          */
+    uint8_t     pairwise;           /* WIPI_CIPHER_* bits       */
+    uint8_t     group;              /* WIPI_CIPHER_* bits       */
+    char        country[2];
+
+    uint16_t    security    : 3,    /* WIPI_SECURITY            */
+                width       : 3,    /* WIPI_WIDTH               */
+                nss         : 3,    /* max spatial streams      */
+                pmf         : 2,    /* 0 off, 1 capable, 2 req  */
+                enterprise  : 1,
+                ht          : 1,
+                vht         : 1,
+                he          : 1,
+                wps         : 1;
+    uint8_t     privacy     : 1,
+                wpa         : 1,
+                rsn         : 1;
+    uint8_t     vendor_ies;
+} wipi_caps_t;
+
+/*    STATIC DEFS    */
+static const char* WIPI_SECURITY_NAMES[] = {
+    "OPEN",
+    "WEP",
+    "WPA",
+    "WPA2",
+    "WPA3",
+    "WPA2/WPA3",
+    "OWE"
+};
+
+static const int WIPI_WIDTH_MHZ[] = { 20, 40, 80, 160, 160 };
+
+static const char* WIPI_CIPHER_NAMES[] = {
+    "WEP",
+    "TKIP",
+    "CCMP",
+    "GCMP",
+    "GCMP-256",
+    "CCMP-256"
+};
+
+static const char* WIPI_AKM_NAMES[] = {
+    NULL,
+    "802.1X",
+    "PSK",
+    "FT-802.1X",
+    "FT-PSK",
+    "802.1X-SHA256",
+    "PSK-SHA256",
+    "TDLS",
+    "SAE",
+    "FT-SAE",
+    "AP-PEER-KEY",
+    "802.1X-SUITE-B",
+    "802.1X-SUITE-B-192",
+    "FT-802.1X-SHA384",
+    "FILS-SHA256",
+    "FILS-SHA384",
+    "FT-FILS-SHA256",
+    "FT-FILS-SHA384",
+    "OWE",
+    "FT-PSK-SHA384",
+    "PSK-SHA384",
+    NULL,
+    NULL,
+    NULL,
+    "SAE-EXT-KEY",
+    "FT-SAE-EXT-KEY"
+};
+
+/*    FUNCTION DECLS    */
+void wipi_ie_parse(const uint8_t* ie,
+                   size_t len,
+                   uint16_t capab,
+                   struct __wipi_caps_t* caps);
+
+const uint8_t* wipi_ie_find(const uint8_t* ie,
+                            size_t len,
+                            uint8_t id,
+                            int ext,
+                            uint8_t* out_len);
+
+#endif
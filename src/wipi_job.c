@@ -0,0 +1,312 @@
+/*    wipi_job.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* In-process job supervisor definitions for WiPi.
+ * See wipi_job.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <time.h>
+#include <unistd.h>
+
+#ifndef _WIPI_JOB_H_
+    #include "wipi_job.h"
+#endif
+
+/*    FUNCTION DEFINITIONS    */
+static struct __wipi_job_t* wipi_jobs_find(struct __wipi_jobs_t* wj, uint64_t id)
+{
+    for (int i = 0; i < WIPI_JOBS_MAX; i++)
+    {
+        if (wj->jobs[i].used && wj->jobs[i].id == id)
+            return &wj->jobs[i];
+    }
+
+    return NULL;
+}
+
+static void wipi_jobs_deadline(struct timespec* ts, int ms)
+{
+    clock_gettime(CLOCK_MONOTONIC, ts);
+
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (long)(ms % 1000) * 1000000;
+
+    if (ts->tv_nsec >= 1000000000)
+    {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000;
+    }
+}
+
+static void* wipi_jobs_deauth_thread(void* arg)
+{
+    struct __wipi_job_t*    job;
+    struct __wipi_jobs_t*   wj;
+    wipi_interface_t        wi;
+    struct timespec         until;
+    uint8_t                 packet[WIPI_DEAUTH_LEN];
+    int                     sockfd, sent;
+
+    job = (struct __wipi_job_t*)arg;
+    wj = job->owner;
+
+    memset( &wi, 0, sizeof(wi) );
+    wi.if_name = job->iface;
+    wi.if_mon = 1;
+
+    sockfd = wipi_mon_socket(&wi);
+
+    wipi_deauth_frame(packet, job->bssid);
+
+    pthread_mutex_lock(&wj->lock);
+
+    if (sockfd < 0)
+        job->status = WIPI_ERR_SOCKFD;
+
+    for (int i = 0; sockfd >= 0 && i < job->packets && !job->cancel; i++)
+    {
+        pthread_mutex_unlock(&wj->lock);
+        sent = send(sockfd, packet, WIPI_DEAUTH_LEN, 0) < 0 ? 0 : 1;
+        pthread_mutex_lock(&wj->lock);
+
+        job->sent += sent;
+
+        /* Sleep out the delay unless cancelled */
+        wipi_jobs_deadline(&until, job->delay);
+
+        while (!job->cancel && pthread_cond_timedwait(&wj->cond, &wj->lock, &until) == 0)
+            ;
+    }
+
+    if (sockfd >= 0)
+        close(sockfd);
+
+    job->state = job->cancel ? WIPI_JOB_CANCELLED : sockfd < 0 || job->sent == 0 ? WIPI_JOB_FAILED : WIPI_JOB_DONE;
+    job->status = job->state == WIPI_JOB_FAILED && job->status == WIPI_ERR_OK ? WIPI_ERR_SEND : job->status;
+    job->end = (uint64_t)time(NULL);
+
+    wj->running--;
+
+    pthread_cond_broadcast(&wj->cond);
+    pthread_mutex_unlock(&wj->lock);
+
+    return NULL;
+}
+
+__wur
+struct __wipi_jobs_t* wipi_jobs_init(int max_running)
+{
+    struct __wipi_jobs_t*   wj;
+    pthread_condattr_t      attr;
+
+    wj = (struct __wipi_jobs_t*)WIPI_ALLOC( sizeof(struct __wipi_jobs_t) );
+    assert(wj != NULL);
+
+    memset( wj, 0, sizeof(struct __wipi_jobs_t) );
+
+    wj->max_running = max_running > 0 ? max_running : WIPI_JOBS_RUNNING;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+    pthread_mutex_init(&wj->lock, NULL);
+    pthread_cond_init(&wj->cond, &attr);
+
+    pthread_condattr_destroy(&attr);
+
+    return wj;
+}
+
+int wipi_jobs_deauth(struct __wipi_jobs_t* wj,
+                     uint64_t id,
+                     struct __wipi_interface_t* wi,
+                     const uint8_t* bssid,
+                     int packets,
+                     int delay)
+{
+    struct __wipi_job_t*    job;
+    pthread_attr_t          attr;
+    pthread_t               thread;
+
+    assert(wi != NULL && bssid != NULL);
+
+    if (!wi->if_mon)
+    {
+        WIPI_ERRNO = WIPI_ERR_NOMON;
+
+        return -1;
+    }
+
+    pthread_mutex_lock(&wj->lock);
+
+    job = NULL;
+
+    if (wj->running < wj->max_running && wipi_jobs_find(wj, id) == NULL)
+    {
+        /* Take a free slot, else the job that finished longest ago */
+        for (int i = 0; i < WIPI_JOBS_MAX; i++)
+        {
+            if (wj->jobs[i].used && wj->jobs[i].state == WIPI_JOB_RUNNING)
+                continue;
+
+            if (job == NULL || !wj->jobs[i].used || (job->used && wj->jobs[i].end < job->end))
+                job = &wj->jobs[i];
+        }
+    }
+
+    if (job == NULL)
+    {
+        pthread_mutex_unlock(&wj->lock);
+
+        WIPI_ERRNO = WIPI_ERR_BUSY;
+
+        return -1;
+    }
+
+    memset( job, 0, sizeof(struct __wipi_job_t) );
+
+    job->id = id;
+    job->packets = packets > 0 ? packets : 50;
+    job->delay = delay > 0 ? delay : 100;
+    job->start = (uint64_t)time(NULL);
+    job->owner = wj;
+    job->used = 1;
+
+    strncpy(job->iface, wi->if_name, IFNAMSIZ - 1);
+    memcpy(job->bssid, bssid, WIPI_MAC_LEN);
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+    if (pthread_create(&thread, &attr, wipi_jobs_deauth_thread, job) != 0)
+    {
+        job->used = 0;
+
+        pthread_attr_destroy(&attr);
+        pthread_mutex_unlock(&wj->lock);
+
+        WIPI_ERRNO = WIPI_ERR_BUSY;
+
+        return -1;
+    }
+
+    wj->running++;
+
+    pthread_attr_destroy(&attr);
+    pthread_mutex_unlock(&wj->lock);
+
+    return 0;
+}
+
+int wipi_jobs_cancel(struct __wipi_jobs_t* wj,
+                     uint64_t id)
+{
+    struct __wipi_job_t*    job;
+    int                     ret;
+
+    pthread_mutex_lock(&wj->lock);
+
+    job = wipi_jobs_find(wj, id);
+    ret = job && job->state == WIPI_JOB_RUNNING ? 0 : -1;
+
+    if (ret == 0)
+    {
+        job->cancel = 1;
+        pthread_cond_broadcast(&wj->cond);
+    }
+
+    pthread_mutex_unlock(&wj->lock);
+
+    return ret;
+}
+
+int wipi_jobs_wait(struct __wipi_jobs_t* wj,
+                   uint64_t id,
+                   int timeout_ms,
+                   struct __wipi_job_t* out)
+{
+    struct __wipi_job_t*    job;
+    struct timespec         until;
+    int                     ret;
+
+    wipi_jobs_deadline(&until, timeout_ms > 0 ? timeout_ms : 0);
+
+    pthread_mutex_lock(&wj->lock);
+
+    /* Once the job finishes its slot can go to another while this sleeps,
+     * so look it up by id again after every wakeup.
+     */
+    for (job = wipi_jobs_find(wj, id); job && job->state == WIPI_JOB_RUNNING; job = wipi_jobs_find(wj, id))
+    {
+        if ((timeout_ms < 0 ? pthread_cond_wait(&wj->cond, &wj->lock)
+                            : pthread_cond_timedwait(&wj->cond, &wj->lock, &until)) != 0)
+        {
+            job = wipi_jobs_find(wj, id);
+            break;
+        }
+    }
+
+    if (job)
+        *out = *job;
+
+    ret = job ? 0 : -1;
+
+    pthread_mutex_unlock(&wj->lock);
+
+    return ret;
+}
+
+int wipi_jobs_list(struct __wipi_jobs_t* wj,
+                   struct __wipi_job_t* out,
+                   int max)
+{
+    int n;
+
+    n = 0;
+
+    pthread_mutex_lock(&wj->lock);
+
+    for (int i = 0; i < WIPI_JOBS_MAX && n < max; i++)
+    {
+        if (wj->jobs[i].used)
+            out[n++] = wj->jobs[i];
+    }
+
+    pthread_mutex_unlock(&wj->lock);
+
+    return n;
+}
+
+void wipi_jobs_free(struct __wipi_jobs_t* wj)
+{
+    if (wj == NULL)
+        return;
+
+    pthread_mutex_lock(&wj->lock);
+
+    for (int i = 0; i < WIPI_JOBS_MAX; i++)
+        wj->jobs[i].cancel = 1;
+
+    pthread_cond_broadcast(&wj->cond);
+
+    /* Workers point into the table, let them all finish first */
+    while (wj->running > 0)
+        pthread_cond_wait(&wj->cond, &wj->lock);
+
+    pthread_mutex_unlock(&wj->lock);
+
+    pthread_mutex_destroy(&wj->lock);
+    pthread_cond_destroy(&wj->cond);
+
+    free(wj);
+}
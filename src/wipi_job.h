@@ -0,0 +1,109 @@
+/*    wipi_job.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* In-process job supervisor for WiPi.
+ * See wipi_job.c for source definitions.
+ *
+ * Jobs run on their own thread and are tracked in a fixed table by
+ * the id the caller gives them (the web API uses the jobs table row
+ * id). No more than max_running may run at once, further jobs are
+ * refused with WIPI_ERR_BUSY rather than queued.
+ *
+ * Progress can be read at any time. Cancelling wakes the job out of
+ * its inter-packet delay, so it stops straight away.
+ */
+
+#ifndef _WIPI_JOB_H_
+#define _WIPI_JOB_H_
+
+#ifndef _WIPI_H_
+    #include "wipi.h"
+#endif
+
+/*    INCLUDES    */
+#include <net/if.h>
+#include <pthread.h>
+
+/*    MACRO DEFS    */
+#define WIPI_JOBS_MAX       64      /* tracked jobs, finished ones get reused */
+#define WIPI_JOBS_RUNNING   4       /* default concurrency cap */
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_JOB_RUNNING,
+    WIPI_JOB_DONE,
+    WIPI_JOB_CANCELLED,
+    WIPI_JOB_FAILED
+} WIPI_JOB_STATE;
+
+typedef struct __wipi_job_t
+{
+    uint64_t                id;
+    char                    iface[IFNAMSIZ];
+    uint8_t                 bssid[WIPI_MAC_LEN];
+    int                     packets;
+    int                     delay;      /* ms */
+
+    int                     sent;
+    WIPI_JOB_STATE          state;
+    WIPI_STATUS             status;     /* why it failed */
+    uint8_t                 cancel;
+
+    uint64_t                start;      /* unix time, s */
+    uint64_t                end;
+
+    struct __wipi_jobs_t*   owner;
+    uint8_t                 used;
+} wipi_job_t;
+
+typedef struct __wipi_jobs_t
+{
+    struct __wipi_job_t jobs[WIPI_JOBS_MAX];
+
+    int                 max_running;
+    int                 running;
+
+    pthread_mutex_t     lock;
+    pthread_cond_t      cond;       /* a job was cancelled or finished */
+} wipi_jobs_t;
+
+/*    STATIC DEFS    */
+static const char* WIPI_JOB_STATE_NAMES[] = {
+    "running",
+    "done",
+    "cancelled",
+    "failed"
+};
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_jobs_t* wipi_jobs_init(int max_running);
+
+int wipi_jobs_deauth(struct __wipi_jobs_t* wj,
+                     uint64_t id,
+                     struct __wipi_interface_t* wi,
+                     const uint8_t* bssid,
+                     int packets,
+                     int delay);
+
+int wipi_jobs_cancel(struct __wipi_jobs_t* wj,
+                     uint64_t id);
+
+int wipi_jobs_wait(struct __wipi_jobs_t* wj,
+                   uint64_t id,
+                   int timeout_ms,
+                   struct __wipi_job_t* out);
+
+int wipi_jobs_list(struct __wipi_jobs_t* wj,
+                   struct __wipi_job_t* out,
+                   int max);
+
+void wipi_jobs_free(struct __wipi_jobs_t* wj);
+
+#endif
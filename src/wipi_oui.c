@@ -0,0 +1,76 @@
+/*    wipi_oui.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* IEEE OUI vendor lookup definitions for WiPi.
+ * See wipi_oui.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#ifndef _WIPI_OUI_H_
+    #include "wipi_oui.h"
+#endif
+
+#include "wipi_oui_db.h"
+
+/*    FUNCTION DEFINITIONS    */
+/* Index of key in keys[lo, hi), or -1 */
+#define WIPI_OUI_SEARCH(keys, lo, hi, key)          \
+    ({                                              \
+        int __lo = (lo), __hi = (hi), __end = __hi; \
+                                                    \
+        while (__lo < __hi)                         \
+        {                                           \
+            int __mid = (__lo + __hi) >> 1;         \
+                                                    \
+            if ((keys)[__mid] < (key))              \
+                __lo = __mid + 1;                   \
+            else                                    \
+                __hi = __mid;                       \
+        }                                           \
+                                                    \
+        __lo < __end && (keys)[__lo] == (key) ? __lo : -1; \
+    })
+
+const char* wipi_oui_lookup(const uint8_t* mac)
+{
+    uint64_t    key;
+    uint32_t    l, b;
+    int         i, j;
+
+    /* Locally administered (randomised) and group addresses are nobody's */
+    if (mac == NULL || (mac[0] & 0x03))
+        return NULL;
+
+    key = wipi_mac_key(mac);
+    l = (uint32_t)(key >> 24);
+    b = l >> (24 - WIPI_OUI_INDEX_BITS);
+
+    if ((i = WIPI_OUI_SEARCH(WIPI_OUI_L_KEYS, WIPI_OUI_L_INDEX[b], WIPI_OUI_L_INDEX[b + 1], l)) < 0)
+        return NULL;
+
+    /* Longest prefix wins inside blocks the IEEE carved up */
+    if (WIPI_OUI_L_NAMES[i] & WIPI_OUI_PARENT)
+    {
+        if ((j = WIPI_OUI_SEARCH(WIPI_OUI_S_KEYS, 0, WIPI_OUI_S_COUNT, key >> 12)) >= 0)
+            return WIPI_OUI_POOL + WIPI_OUI_S_NAMES[j];
+
+        if ((j = WIPI_OUI_SEARCH(WIPI_OUI_M_KEYS, 0, WIPI_OUI_M_COUNT, (uint32_t)(key >> 20))) >= 0)
+            return WIPI_OUI_POOL + WIPI_OUI_M_NAMES[j];
+    }
+
+    return WIPI_OUI_POOL + (WIPI_OUI_L_NAMES[i] & ~WIPI_OUI_PARENT);
+}
+
+int wipi_oui_count(void)
+{
+    return WIPI_OUI_L_COUNT + WIPI_OUI_M_COUNT + WIPI_OUI_S_COUNT;
+}
@@ -0,0 +1,45 @@
+/*    wipi_oui.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* IEEE OUI vendor lookup for WiPi.
+ * See wipi_oui.c for source definitions.
+ *
+ * The registry is compiled in (wipi_oui_db.h, generated by
+ * wipi_oui_gen.py when wipy/setup.py builds, from the ieee-data
+ * package if it is installed) as sorted prefix arrays with names in one
+ * deduplicated string pool. MA-L prefixes are found through a 4096
+ * bucket index on their top 12 bits, so a lookup is a few compares.
+ * MA-M (28 bit) and MA-S/IAB (36 bit) prefixes are only searched under
+ * the MA-L blocks the IEEE carved up for them, and win over the block.
+ */
+
+#ifndef _WIPI_OUI_H_
+#define _WIPI_OUI_H_
+
+#ifndef _WIPI_H_
+    #include "wipi.h"
+#endif
+
+/*    FUNCTION DECLS    */
+const char* wipi_oui_lookup(const uint8_t* mac);
+
+int wipi_oui_count(void);
+
+static inline const char* wipi_beacon_vendor(struct __wipi_beacon_t* wb)
+{
+    /* Filled on first use, "" when the BSSID is not in the registry */
+    if (wb->vendor == NULL)
+    {
+        wb->vendor = wipi_oui_lookup(wb->addr);
+        wb->vendor = wb->vendor ? wb->vendor : "";
+    }
+
+    return wb->vendor;
+}
+
+#endif
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+
+#    wipi_oui_gen.py
+
+# Author: ripmeep
+# GitHub: https://github.com/ripmeep/
+# Date  : 19/10/2026
+
+# Generates wipi_oui_db.h from local copies of the IEEE registries.
+#
+# Takes the CSV exports (oui.csv, mam.csv, oui36.csv, iab.csv) or the
+# oui.txt listing, as shipped by the ieee-data package:
+#
+#   ./wipi_oui_gen.py /usr/share/ieee-data/{oui,mam,oui36,iab}.csv -o wipi_oui_db.h
+
+import argparse, csv, re, sys, os
+
+BITS = { 'MA-L': 24, 'MA-M': 28, 'MA-S': 36, 'IAB': 36 }
+INDEX_BITS = 12
+PARENT = 1 << 31
+
+HEADER = '''/*    wipi_oui_db.h    */
+
+/*
+ * Generated by wipi_oui_gen.py from {sources}, do not edit.
+ * {l} MA-L, {m} MA-M and {s} MA-S/IAB prefixes, {names} names ({pool} bytes).
+ */
+
+#ifndef _WIPI_OUI_DB_H_
+#define _WIPI_OUI_DB_H_
+
+#include <stdint.h>
+
+'''
+
+def clean(name):
+    return re.sub(r'\s+', ' ', name).strip()
+
+def read_csv(path, table):
+    with open(path, newline='', encoding='utf-8', errors='replace') as f:
+        for row in csv.reader(f):
+            if len(row) < 3 or row[0] not in BITS:
+                continue
+
+            bits = BITS[row[0]]
+            digits = bits // 4
+
+            try:
+                key = int(row[1][:digits], 16)
+            except ValueError:
+                continue
+
+            if row[2].strip():
+                table[bits][key] = clean(row[2])
+
+def read_txt(path, table):
+    line_re = re.compile(r'^\s*([0-9A-Fa-f]{2})-([0-9A-Fa-f]{2})-([0-9A-Fa-f]{2})\s+\(hex\)\s+(.+)$')
+
+    with open(path, encoding='utf-8', errors='replace') as f:
+        for line in f:
+            m = line_re.match(line)
+
+            if m:
+                table[24][int(''.join(m.groups()[:3]), 16)] = clean(m.group(4))
+
+def c_string(s):
+    out = ''
+
+    for b in s.encode('utf-8'):
+        if b in (0x22, 0x5C):
+            out += '\\' + chr(b)
+        elif 0x20 <= b < 0x7F and chr(b) != '?':
+            out += chr(b)
+        else:
+            out += '\\%03o' % b     # octal never swallows a following digit past 3
+
+    return '"' + out + '\\0"'
+
+def c_array(ctype, name, values, per_line=8, fmt='0x%08X'):
+    lines = []
+
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt % v for v in values[i:i + per_line]))
+
+    return 'static const %s %s[] = {\n%s\n};\n' % (ctype, name, ',\n'.join(lines) or '    0')
+
+def main():
+    ap = argparse.ArgumentParser(description='Build the WiPi OUI vendor table')
+    ap.add_argument('registry', nargs='*', help='IEEE registry CSV exports or oui.txt, none for an empty table')
+    ap.add_argument('-o', '--output', default=os.path.join(os.path.dirname(__file__), 'wipi_oui_db.h'))
+    args = ap.parse_args()
+
+    table = { 24: {}, 28: {}, 36: {} }
+
+    for path in args.registry:
+        (read_txt if path.endswith('.txt') else read_csv)(path, table)
+
+    # Deduplicated string pool, one NUL terminated name per vendor
+    pool, offsets = [], {}
+    size = 0
+
+    def intern(name):
+        nonlocal size
+
+        if name not in offsets:
+            offsets[name] = size
+            pool.append(name)
+            size += len(name.encode('utf-8')) + 1
+
+        return offsets[name]
+
+    # Blocks carved into MA-M/MA-S are flagged so lookups only search those when needed
+    parents = { k >> 4 for k in table[28] } | { k >> 12 for k in table[36] }
+
+    for p in parents:
+        table[24].setdefault(p, 'IEEE Registration Authority')
+
+    l_keys = sorted(table[24])
+    l_names = [intern(table[24][k]) | (PARENT if k in parents else 0) for k in l_keys]
+    m_keys = sorted(table[28])
+    m_names = [intern(table[28][k]) for k in m_keys]
+    s_keys = sorted(table[36])
+    s_names = [intern(table[36][k]) for k in s_keys]
+
+    # First MA-L entry of each top INDEX_BITS bucket, so a search covers a handful of keys
+    index, j = [], 0
+
+    for b in range((1 << INDEX_BITS) + 1):
+        while j < len(l_keys) and l_keys[j] >> (24 - INDEX_BITS) < b:
+            j += 1
+
+        index.append(j)
+
+    with open(args.output, 'w') as out:
+        out.write(HEADER.format(sources=', '.join(os.path.basename(p) for p in args.registry) or 'no registry',
+                                l=len(l_keys), m=len(m_keys), s=len(s_keys),
+                                names=len(pool), pool=size))
+
+        out.write('#define WIPI_OUI_L_COUNT    %d\n' % len(l_keys))
+        out.write('#define WIPI_OUI_M_COUNT    %d\n' % len(m_keys))
+        out.write('#define WIPI_OUI_S_COUNT    %d\n' % len(s_keys))
+        out.write('#define WIPI_OUI_INDEX_BITS %d\n' % INDEX_BITS)
+        out.write('#define WIPI_OUI_PARENT     0x%08XU  /* MA-L block with MA-M/MA-S under it */\n\n' % PARENT)
+
+        out.write(c_array('uint32_t', 'WIPI_OUI_L_KEYS', l_keys, fmt='0x%06X') + '\n')
+        out.write(c_array('uint32_t', 'WIPI_OUI_L_NAMES', l_names) + '\n')
+        out.write(c_array('uint32_t', 'WIPI_OUI_L_INDEX', index, fmt='%d', per_line=16) + '\n')
+        out.write(c_array('uint32_t', 'WIPI_OUI_M_KEYS', m_keys, fmt='0x%07X') + '\n')
+        out.write(c_array('uint32_t', 'WIPI_OUI_M_NAMES', m_names) + '\n')
+        out.write(c_array('uint64_t', 'WIPI_OUI_S_KEYS', s_keys, fmt='0x%09XULL', per_line=6) + '\n')
+        out.write(c_array('uint32_t', 'WIPI_OUI_S_NAMES', s_names) + '\n')
+
+        out.write('static const char WIPI_OUI_POOL[] =\n')
+        out.write('\n'.join('    ' + c_string(name) for name in pool) or '    ""')
+        out.write(';\n\n#endif\n')
+
+    print('%s: %d MA-L, %d MA-M, %d MA-S, %d names, %d bytes' %
+          (args.output, len(l_keys), len(m_keys), len(s_keys), len(pool), size), file=sys.stderr)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,525 @@
+/*    wipi_pcapng.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Rotating pcapng writer definitions for WiPi.
+ * See wipi_pcapng.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <fcntl.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#ifndef _WIPI_PCAPNG_H_
+    #include "wipi_pcapng.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_PCAPNG_SHB 0x0A0D0D0A
+#define WIPI_PCAPNG_IDB 0x00000001
+#define WIPI_PCAPNG_EPB 0x00000006
+
+/*    STATIC DEFS    */
+static const uint8_t WIPI_PCAPNG_PAD[4] = { 0 };
+
+/*    FUNCTION DEFINITIONS    */
+static size_t wipi_pcapng_option(uint8_t* buf,
+                                 uint16_t code,
+                                 const void* value,
+                                 uint16_t len)
+{
+    size_t  pad;
+
+    pad = (4 - (len & 3)) & 3;
+
+    memcpy(buf, &code, 2);
+    memcpy(buf + 2, &len, 2);
+    memcpy(buf + 4, value, len);
+    memset(buf + 4 + len, 0, pad);
+
+    return 4 + len + pad;
+}
+
+static size_t wipi_pcapng_block(uint8_t* buf, uint32_t type, size_t len)
+{
+    uint32_t    total;
+
+    total = (uint32_t)(len + 4);
+
+    memcpy(buf, &type, 4);
+    memcpy(buf + 4, &total, 4);
+    memcpy(buf + len, &total, 4);
+
+    return total;
+}
+
+static int wipi_pcapng_write(int fd, const uint8_t* buf, size_t len)
+{
+    ssize_t n;
+
+    while (len > 0)
+    {
+        n = write(fd, buf, len);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+
+        if (n <= 0)
+            return -1;
+
+        buf += n;
+        len -= n;
+    }
+
+    return 0;
+}
+
+/* Section header + one interface description (radiotap, ns timestamps) */
+static int wipi_pcapng_header(struct __wipi_pcapng_t* wp)
+{
+    uint8_t     buf[512];
+    size_t      off, len;
+    uint32_t    magic, snaplen;
+    uint16_t    version[2], linktype[2];
+    int64_t     section;
+    uint8_t     tsresol;
+
+    off = 8;
+    magic = 0x1A2B3C4D;
+    version[0] = 1;
+    version[1] = 0;
+    section = -1;
+
+    memcpy(buf + off, &magic, 4);
+    memcpy(buf + off + 4, version, 4);
+    memcpy(buf + off + 8, &section, 8);
+    off += 16;
+
+    off += wipi_pcapng_option(buf + off, 4, "wipi", 4);         /* shb_userappl */
+    off += wipi_pcapng_option(buf + off, 0, NULL, 0);
+
+    len = wipi_pcapng_block(buf, WIPI_PCAPNG_SHB, off);
+
+    off = len + 8;
+    linktype[0] = WIPI_PCAPNG_LINKTYPE;
+    linktype[1] = 0;
+    snaplen = WIPI_PCAPNG_SNAPLEN;
+    tsresol = 9;
+
+    memcpy(buf + off, linktype, 4);
+    memcpy(buf + off + 4, &snaplen, 4);
+    off += 8;
+
+    off += wipi_pcapng_option(buf + off, 2, wp->iface, strnlen(wp->iface, IFNAMSIZ));  /* if_name */
+    off += wipi_pcapng_option(buf + off, 9, &tsresol, 1);                               /* if_tsresol */
+    off += wipi_pcapng_option(buf + off, 0, NULL, 0);
+
+    len += wipi_pcapng_block(buf + len, WIPI_PCAPNG_IDB, off - len);
+
+    if (wipi_pcapng_write(wp->fd, buf, len) < 0)
+        return -1;
+
+    wp->file_bytes = len;
+    wp->total += len;
+
+    return 0;
+}
+
+static void wipi_pcapng_budget(struct __wipi_pcapng_t* wp)
+{
+    /* Never delete the file being written */
+    while (wp->nfiles > 0 && (wp->total > wp->budget || wp->nfiles == WIPI_PCAPNG_MAX_FILES))
+    {
+        unlink(wp->files[0].path);
+
+        wp->total -= wp->files[0].size;
+        wp->nfiles--;
+
+        /* The slot after the last closed file is the one being written */
+        memmove( wp->files, wp->files + 1, (wp->nfiles + 1) * sizeof(struct __wipi_pcapng_file_t) );
+    }
+}
+
+/* <prefix>-YYYYmmdd-HHMMSS-<seq>.pcapng, as named by wipi_pcapng_rotate() */
+static int wipi_pcapng_ours(const struct __wipi_pcapng_t* wp, const char* name)
+{
+    size_t  len;
+
+    len = strlen(wp->prefix);
+
+    if (strncmp(name, wp->prefix, len) != 0 || name[len] != '-')
+        return 0;
+
+    name += len + 1;
+
+    if (strspn(name, "0123456789") != 8 || name[8] != '-')
+        return 0;
+
+    name += 9;
+
+    if (strspn(name, "0123456789") != 6 || name[6] != '-')
+        return 0;
+
+    name += 7;
+    len = strspn(name, "0123456789");
+
+    return len > 0 && strcmp(name + len, ".pcapng") == 0;
+}
+
+static int wipi_pcapng_older(const void* a, const void* b)
+{
+    const struct __wipi_pcapng_file_t*  fa, *fb;
+
+    fa = (const struct __wipi_pcapng_file_t*)a;
+    fb = (const struct __wipi_pcapng_file_t*)b;
+
+    if (fa->mtime != fb->mtime)
+        return fa->mtime < fb->mtime ? -1 : 1;
+
+    return strcmp(fa->path, fb->path);
+}
+
+/* Files an earlier writer left in the directory count against the budget too */
+static void wipi_pcapng_scan(struct __wipi_pcapng_t* wp)
+{
+    struct __wipi_pcapng_file_t*    found;
+    struct dirent*                  de;
+    struct stat                     st;
+    DIR*                            dir;
+    size_t                          n, cap, keep;
+
+    if ((dir = opendir(wp->dir)) == NULL)
+        return;
+
+    found = NULL;
+    n = cap = 0;
+
+    while ((de = readdir(dir)) != NULL)
+    {
+        if (!wipi_pcapng_ours(wp, de->d_name))
+            continue;
+
+        if (n == cap)
+        {
+            cap = cap ? cap * 2 : 64;
+            found = (struct __wipi_pcapng_file_t*)realloc( found, cap * sizeof(struct __wipi_pcapng_file_t) );
+            assert(found != NULL);
+        }
+
+        snprintf(found[n].path, sizeof(found[n].path), "%s/%s", wp->dir, de->d_name);
+
+        if (stat(found[n].path, &st) < 0 || !S_ISREG(st.st_mode))
+            continue;
+
+        found[n].size = (uint64_t)st.st_size;
+        found[n].mtime = st.st_mtime;
+        n++;
+    }
+
+    closedir(dir);
+
+    if (found == NULL)
+        return;
+
+    qsort(found, n, sizeof(struct __wipi_pcapng_file_t), wipi_pcapng_older);
+
+    /* Leave a slot for the file about to be opened */
+    keep = n < WIPI_PCAPNG_MAX_FILES - 1 ? n : WIPI_PCAPNG_MAX_FILES - 1;
+
+    for (size_t i = 0; i < n - keep; i++)
+        unlink(found[i].path);
+
+    memcpy(wp->files, found + (n - keep), keep * sizeof(struct __wipi_pcapng_file_t));
+
+    for (size_t i = 0; i < keep; i++)
+        wp->total += wp->files[i].size;
+
+    wp->nfiles = (int)keep;
+
+    free(found);
+}
+
+static int wipi_pcapng_rotate(struct __wipi_pcapng_t* wp)
+{
+    struct __wipi_pcapng_file_t*    f;
+    char                            stamp[32];
+    struct tm                       tm;
+    time_t                          now;
+
+    if (wp->fd >= 0)
+    {
+        close(wp->fd);
+
+        f = &wp->files[wp->nfiles++];
+        f->size = wp->file_bytes;
+
+        wp->fd = -1;
+    }
+
+    wipi_pcapng_budget(wp);
+
+    now = time(NULL);
+    gmtime_r(&now, &tm);
+    strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+
+    f = &wp->files[wp->nfiles];
+
+    /* Never truncate a file already counted, one a restart left in the same second */
+    do
+    {
+        snprintf(f->path,
+                 sizeof(f->path),
+                 "%s/%s-%s-%u.pcapng",
+                 wp->dir,
+                 wp->prefix,
+                 stamp,
+                 wp->seq++);
+
+        wp->fd = open(f->path, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0640);
+    } while (wp->fd < 0 && errno == EEXIST);
+
+    if (wp->fd >= 0 && wipi_pcapng_header(wp) < 0)
+    {
+        /* A file with half a header is no use to anything that reads it */
+        close(wp->fd);
+        unlink(f->path);
+
+        wp->fd = -1;
+    }
+
+    if (wp->fd < 0)
+    {
+        /* Back off before the next try, see wipi_pcapng_drain() */
+        wp->retry_wait = wp->retry_wait ? wp->retry_wait * 2 : WIPI_PCAPNG_RETRY;
+
+        if (wp->retry_wait > WIPI_PCAPNG_RETRY_MAX)
+            wp->retry_wait = WIPI_PCAPNG_RETRY_MAX;
+
+        wp->retry_at = wipi_stats_now() + wp->retry_wait;
+
+        WIPI_ERRNO = wp->status = WIPI_ERR_IO;
+
+        return -1;
+    }
+
+    wp->file_start = wipi_stats_now();
+    wp->retry_wait = 0;
+
+    wipi_stats_add(WIPI_STAT_PCAP_FILES, 1);
+
+    return 0;
+}
+
+__wur
+struct __wipi_pcapng_t* wipi_pcapng_open(const char* __restrict__ dir,
+                                         const char* __restrict__ prefix,
+                                         const char* __restrict__ iface,
+                                         uint64_t file_size,
+                                         uint64_t file_time,
+                                         uint64_t budget)
+{
+    struct __wipi_pcapng_t* wp;
+
+    wp = (struct __wipi_pcapng_t*)WIPI_ALLOC( sizeof(struct __wipi_pcapng_t) );
+    assert(wp != NULL);
+
+    memset( wp, 0, sizeof(struct __wipi_pcapng_t) );
+
+    wp->files = (struct __wipi_pcapng_file_t*)calloc( WIPI_PCAPNG_MAX_FILES + 1, sizeof(struct __wipi_pcapng_file_t) );
+    assert(wp->files != NULL);
+
+    wp->dir    = strdup(dir);
+    wp->prefix = strdup(prefix ? prefix : "wipi");
+    wp->iface  = strdup(iface ? iface : "");
+    wp->fd     = -1;
+
+    wp->budget    = budget ? budget : WIPI_PCAPNG_BUDGET;
+    wp->file_size = file_size ? file_size : WIPI_PCAPNG_FILE_SIZE;
+    wp->file_time = (file_time ? file_time : WIPI_PCAPNG_FILE_TIME) * 1000000000ULL;
+
+    /* A single file has to fit in the budget for rotation to help */
+    if (wp->file_size > wp->budget / 2)
+        wp->file_size = wp->budget / 2;
+
+    wipi_pcapng_scan(wp);
+
+    if (wipi_pcapng_rotate(wp) < 0)
+    {
+        wipi_pcapng_close(wp);
+
+        return NULL;
+    }
+
+    return wp;
+}
+
+int wipi_pcapng_frame(struct __wipi_pcapng_t* wp,
+                      const uint8_t* data,
+                      uint32_t len,
+                      uint32_t orig_len,
+                      uint64_t ts_ns)
+{
+    uint32_t*   h;
+    uint32_t    pad;
+
+    if (wp->nframes == WIPI_PCAPNG_BATCH && wipi_pcapng_flush(wp) < 0)
+        return -1;
+
+    len = len < WIPI_PCAPNG_SNAPLEN ? len : WIPI_PCAPNG_SNAPLEN;
+    pad = (4 - (len & 3)) & 3;
+
+    /* Enhanced packet block: header words, then the trailing length */
+    h = wp->hdrs[wp->nframes++];
+
+    h[0] = WIPI_PCAPNG_EPB;
+    h[1] = 28 + len + pad + 4;
+    h[2] = 0;
+    h[3] = (uint32_t)(ts_ns >> 32);
+    h[4] = (uint32_t)ts_ns;
+    h[5] = len;
+    h[6] = orig_len;
+    h[7] = h[1];
+
+    wp->iov[wp->niov].iov_base = h;
+    wp->iov[wp->niov++].iov_len = 28;
+
+    wp->iov[wp->niov].iov_base = (void*)data;
+    wp->iov[wp->niov++].iov_len = len;
+
+    if (pad)
+    {
+        wp->iov[wp->niov].iov_base = (void*)WIPI_PCAPNG_PAD;
+        wp->iov[wp->niov++].iov_len = pad;
+    }
+
+    wp->iov[wp->niov].iov_base = &h[7];
+    wp->iov[wp->niov++].iov_len = 4;
+
+    wp->pending += h[1];
+
+    return 0;
+}
+
+/* The queued batch never reached a file */
+static int wipi_pcapng_discard(struct __wipi_pcapng_t* wp)
+{
+    WIPI_ERRNO = wp->status = WIPI_ERR_IO;
+
+    wp->drops += wp->nframes;
+
+    wp->niov = wp->nframes = 0;
+    wp->pending = 0;
+
+    return -1;
+}
+
+/* A write failed part way through the batch, take the file back to where the
+ * batch started so it never ends in a torn block */
+static int wipi_pcapng_undo(struct __wipi_pcapng_t* wp, uint64_t done)
+{
+    if (ftruncate(wp->fd, (off_t)wp->file_bytes) == 0 &&
+        lseek(wp->fd, (off_t)wp->file_bytes, SEEK_SET) == (off_t)wp->file_bytes)
+        return wipi_pcapng_discard(wp);
+
+    /* Cannot cut it, count what is on disk and leave the file for a new one */
+    wp->file_bytes += done;
+    wp->total      += done;
+
+    wipi_pcapng_rotate(wp);
+
+    return wipi_pcapng_discard(wp);
+}
+
+static int wipi_pcapng_drain(struct __wipi_pcapng_t* wp)
+{
+    struct iovec*   iov;
+    int             niov;
+    ssize_t         n;
+    uint64_t        done;
+
+    /* A failed rotate left no file open, try again once its backoff is up and
+     * only lose the batch if that fails too */
+    if (wp->fd < 0 && (wipi_stats_now() < wp->retry_at || wipi_pcapng_rotate(wp) < 0))
+        return wipi_pcapng_discard(wp);
+
+    iov = wp->iov;
+    niov = wp->niov;
+    done = 0;
+
+    while (niov > 0)
+    {
+        n = writev(wp->fd, iov, niov < IOV_MAX ? niov : IOV_MAX);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+
+        if (n < 0)
+            return done ? wipi_pcapng_undo(wp, done) : wipi_pcapng_discard(wp);
+
+        done += (uint64_t)n;
+
+        /* Partial write - skip what went out and carry on */
+        for (; niov > 0 && (size_t)n >= iov->iov_len; iov++, niov--)
+            n -= iov->iov_len;
+
+        if (niov > 0)
+        {
+            iov->iov_base = (uint8_t*)iov->iov_base + n;
+            iov->iov_len -= n;
+        }
+    }
+
+    wipi_stats_add(WIPI_STAT_PCAP_BYTES, wp->pending);
+
+    wp->frames     += wp->nframes;
+    wp->bytes      += wp->pending;
+    wp->file_bytes += wp->pending;
+    wp->total      += wp->pending;
+
+    wp->niov = wp->nframes = 0;
+    wp->pending = 0;
+
+    return 0;
+}
+
+int wipi_pcapng_flush(struct __wipi_pcapng_t* wp)
+{
+    if (wipi_pcapng_drain(wp) < 0)
+        return -1;
+
+    if (wp->file_bytes >= wp->file_size || wipi_stats_now() - wp->file_start >= wp->file_time)
+        return wipi_pcapng_rotate(wp);
+
+    if (wp->total > wp->budget)
+        wipi_pcapng_budget(wp);
+
+    return 0;
+}
+
+void wipi_pcapng_close(struct __wipi_pcapng_t* wp)
+{
+    if (wp == NULL)
+        return;
+
+    if (wp->fd >= 0)
+    {
+        wipi_pcapng_drain(wp);
+        close(wp->fd);
+    }
+
+    free(wp->files);
+    free(wp->dir);
+    free(wp->prefix);
+    free(wp->iface);
+    free(wp);
+}
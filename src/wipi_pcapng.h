@@ -0,0 +1,109 @@
+/*    wipi_pcapng.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Rotating pcapng writer for WiPi.
+ * See wipi_pcapng.c for source definitions.
+ *
+ * Frames are queued as iovecs that point straight at the caller's
+ * buffer (normally the capture ring) and written with one writev()
+ * per batch, so packet data is never copied in userspace. The
+ * caller must call wipi_pcapng_flush() before reusing a buffer.
+ *
+ * Files rotate on size or age, and the oldest ones are deleted
+ * to keep the whole set under a disk budget. Files with the same
+ * prefix already in the directory, from an earlier writer, are
+ * counted (and deleted first) when it opens.
+ */
+
+#ifndef _WIPI_PCAPNG_H_
+#define _WIPI_PCAPNG_H_
+
+#ifndef _WIPI_H_
+    #include "wipi.h"
+#endif
+
+/*    INCLUDES    */
+#include <limits.h>
+#include <time.h>
+#include <sys/uio.h>
+
+/*    MACRO DEFS    */
+#define WIPI_PCAPNG_LINKTYPE    127     /* LINKTYPE_IEEE802_11_RADIOTAP */
+#define WIPI_PCAPNG_SNAPLEN     65535
+#define WIPI_PCAPNG_BATCH       256     /* frames per writev()   */
+#define WIPI_PCAPNG_MAX_FILES   1024
+
+#define WIPI_PCAPNG_FILE_SIZE   (64ULL << 20)
+#define WIPI_PCAPNG_FILE_TIME   3600
+#define WIPI_PCAPNG_BUDGET      (1ULL << 30)
+
+#define WIPI_PCAPNG_RETRY       1000000000ULL    /* ns, first retry of a failed rotate */
+#define WIPI_PCAPNG_RETRY_MAX   60000000000ULL   /* ns, backoff doubles up to this     */
+
+/*    TYPEDEFS    */
+typedef struct __wipi_pcapng_file_t
+{
+    char        path[PATH_MAX];
+    uint64_t    size;
+    time_t      mtime;
+} wipi_pcapng_file_t;
+
+typedef struct __wipi_pcapng_t
+{
+    char*                           dir;
+    char*                           prefix;
+    char*                           iface;
+
+    uint64_t                        file_size;      /* bytes, rotate after */
+    uint64_t                        file_time;      /* ns, rotate after    */
+    uint64_t                        budget;         /* bytes, all files    */
+
+    int                             fd;
+    uint64_t                        file_bytes;
+    uint64_t                        file_start;
+    unsigned int                    seq;
+    uint64_t                        retry_at;       /* ns, no file open until then */
+    uint64_t                        retry_wait;
+
+    struct __wipi_pcapng_file_t*    files;          /* closed, oldest first */
+    int                             nfiles;
+    uint64_t                        total;
+
+    struct iovec                    iov[WIPI_PCAPNG_BATCH * 4];
+    int                             niov;
+    uint32_t                        hdrs[WIPI_PCAPNG_BATCH][8];
+    int                             nframes;
+    uint64_t                        pending;
+
+    uint64_t                        frames;
+    uint64_t                        bytes;
+    uint64_t                        drops;          /* lost to write errors */
+
+    WIPI_STATUS                     status;
+} wipi_pcapng_t;
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_pcapng_t* wipi_pcapng_open(const char* __restrict__ dir,
+                                         const char* __restrict__ prefix,
+                                         const char* __restrict__ iface,
+                                         uint64_t file_size,
+                                         uint64_t file_time,
+                                         uint64_t budget);
+
+int wipi_pcapng_frame(struct __wipi_pcapng_t* wp,
+                      const uint8_t* data,
+                      uint32_t len,
+                      uint32_t orig_len,
+                      uint64_t ts_ns);
+
+int wipi_pcapng_flush(struct __wipi_pcapng_t* wp);
+
+void wipi_pcapng_close(struct __wipi_pcapng_t* wp);
+
+#endif
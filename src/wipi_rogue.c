@@ -0,0 +1,591 @@
+/*    wipi_rogue.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Rogue AP / evil twin detection definitions for WiPi.
+ * See wipi_rogue.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <ctype.h>
+
+#ifndef _WIPI_ROGUE_H_
+    #include "wipi_rogue.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_ROGUE_USED (1ULL << 63)
+
+/*    STATIC DEFS    */
+/* How strong each WIPI_SECURITY is, so a "downgrade" can be compared */
+static const uint8_t WIPI_ROGUE_RANK[] = {
+    0,  /* OPEN      */
+    1,  /* WEP       */
+    2,  /* WPA       */
+    3,  /* WPA2      */
+    5,  /* WPA3      */
+    4,  /* WPA2/WPA3 */
+    2   /* OWE       */
+};
+
+#define WIPI_ROGUE_SECURITIES (sizeof(WIPI_ROGUE_RANK) / sizeof(WIPI_ROGUE_RANK[0]))
+
+/*    FUNCTION DEFINITIONS    */
+static uint64_t wipi_rogue_ssid_key(const char* ssid)
+{
+    uint64_t    h;
+    size_t      len;
+
+    len = strnlen(ssid, WIPI_MAX_SSID);
+
+    /* FNV-1a */
+    h = 0xCBF29CE484222325ULL;
+
+    for (size_t i = 0; i < len; i++)
+        h = (h ^ (uint8_t)ssid[i]) * 0x100000001B3ULL;
+
+    return h | WIPI_ROGUE_USED;
+}
+
+static struct __wipi_rogue_ap_t* wipi_rogue_ap_slot(struct __wipi_rogue_ap_t* aps,
+                                                    size_t cap,
+                                                    uint64_t key)
+{
+    size_t  i, mask;
+
+    mask = cap - 1;
+
+    for (i = wipi_mac_hash(key) & mask; aps[i].key && aps[i].key != key; i = (i + 1) & mask)
+        ;
+
+    return &aps[i];
+}
+
+static struct __wipi_rogue_ssid_t* wipi_rogue_ssid_slot(struct __wipi_rogue_ssid_t* ssids,
+                                                        size_t cap,
+                                                        uint64_t key,
+                                                        const char* ssid)
+{
+    size_t  i, mask, len;
+
+    mask = cap - 1;
+    len = strnlen(ssid, WIPI_MAX_SSID);
+
+    /* Either side may be a full 32 bytes with no NUL */
+    for (i = wipi_mac_hash(key) & mask; ssids[i].key; i = (i + 1) & mask)
+    {
+        if (ssids[i].key == key && strnlen(ssids[i].ssid, WIPI_MAX_SSID) == len && memcmp(ssids[i].ssid, ssid, len) == 0)
+            break;
+    }
+
+    return &ssids[i];
+}
+
+static int wipi_rogue_grow(struct __wipi_rogue_t* wr)
+{
+    struct __wipi_rogue_ap_t*   aps;
+    size_t                      cap;
+
+    cap = wr->aps_cap * 2;
+
+    if (cap > WIPI_ROGUE_MAX || (aps = (struct __wipi_rogue_ap_t*)calloc( cap, sizeof(struct __wipi_rogue_ap_t) )) == NULL)
+        return -1;
+
+    wipi_stats_add(WIPI_STAT_ALLOCS, 1);
+
+    for (size_t i = 0; i < wr->aps_cap; i++)
+    {
+        if (wr->aps[i].key)
+            *wipi_rogue_ap_slot(aps, cap, wr->aps[i].key) = wr->aps[i];
+    }
+
+    free(wr->aps);
+
+    wr->aps = aps;
+    wr->aps_cap = cap;
+
+    return 0;
+}
+
+/* Empties slot i, shifting back any entry that probed past it */
+static void wipi_rogue_delete(struct __wipi_rogue_t* wr, size_t i)
+{
+    size_t  j, home, mask;
+
+    mask = wr->aps_cap - 1;
+
+    for (j = i;;)
+    {
+        wr->aps[i].key = 0;
+
+        do
+        {
+            j = (j + 1) & mask;
+
+            if (wr->aps[j].key == 0)
+            {
+                wr->naps--;
+
+                return;
+            }
+
+            home = wipi_mac_hash(wr->aps[j].key) & mask;
+        } while (i <= j ? (i < home && home <= j) : (i < home || home <= j));
+
+        wr->aps[i] = wr->aps[j];
+        i = j;
+    }
+}
+
+static int wipi_rogue_oldest(const void* a, const void* b)
+{
+    uint64_t    sa, sb;
+
+    sa = *(const uint64_t*)a;
+    sb = *(const uint64_t*)b;
+
+    return sa < sb ? -1 : sa > sb;
+}
+
+/* At the size cap, forget roughly the quarter of BSSIDs seen longest ago.
+ * The cut off comes from a sample, allow-listed APs are always kept.
+ */
+static void wipi_rogue_evict(struct __wipi_rogue_t* wr)
+{
+    uint64_t    sample[WIPI_ROGUE_SAMPLE], cutoff;
+    size_t      n, step;
+
+    step = wr->aps_cap / WIPI_ROGUE_SAMPLE;
+    n = 0;
+
+    for (size_t i = 0; i < wr->aps_cap && n < WIPI_ROGUE_SAMPLE; i += step ? step : 1)
+    {
+        for (size_t k = i; k < wr->aps_cap && k < i + step; k++)
+        {
+            if (wr->aps[k].key && !wr->aps[k].known)
+            {
+                sample[n++] = wr->aps[k].seen;
+                break;
+            }
+        }
+    }
+
+    if (n == 0)
+        return;
+
+    qsort(sample, n, sizeof(uint64_t), wipi_rogue_oldest);
+    cutoff = sample[n / 4];
+
+    /* A deletion shifts a later entry into slot i, so look at it again */
+    for (size_t i = 0; i < wr->aps_cap;)
+    {
+        if (wr->aps[i].key && !wr->aps[i].known && wr->aps[i].seen <= cutoff)
+        {
+            wipi_rogue_delete(wr, i);
+            wr->evicted++;
+        }
+        else
+            i++;
+    }
+}
+
+static int wipi_rogue_grow_ssids(struct __wipi_rogue_t* wr)
+{
+    struct __wipi_rogue_ssid_t* ssids;
+    size_t                      cap;
+
+    cap = wr->ssids_cap * 2;
+
+    if ((ssids = (struct __wipi_rogue_ssid_t*)calloc( cap, sizeof(struct __wipi_rogue_ssid_t) )) == NULL)
+        return -1;
+
+    for (size_t i = 0; i < wr->ssids_cap; i++)
+    {
+        if (wr->ssids[i].key)
+            *wipi_rogue_ssid_slot(ssids, cap, wr->ssids[i].key, wr->ssids[i].ssid) = wr->ssids[i];
+    }
+
+    free(wr->ssids);
+
+    wr->ssids = ssids;
+    wr->ssids_cap = cap;
+
+    return 0;
+}
+
+/* Find or add the state for a BSSID, growing at 3/4 load up to the cap.
+ * NULL if it is new and there is no room even after evicting.
+ */
+static struct __wipi_rogue_ap_t* wipi_rogue_ap(struct __wipi_rogue_t* wr,
+                                               const uint8_t* addr)
+{
+    struct __wipi_rogue_ap_t*   ap;
+    uint64_t                    key;
+
+    key = wipi_mac_key(addr) | WIPI_ROGUE_USED;
+    ap = wipi_rogue_ap_slot(wr->aps, wr->aps_cap, key);
+
+    if (ap->key)
+        return ap;
+
+    if ((wr->naps + 1) * 4 > wr->aps_cap * 3 && wipi_rogue_grow(wr) < 0)
+    {
+        wipi_rogue_evict(wr);
+
+        if ((wr->naps + 1) * 4 > wr->aps_cap * 3)
+            return NULL;
+    }
+
+    ap = wipi_rogue_ap_slot(wr->aps, wr->aps_cap, key);
+
+    if (ap->key == 0)
+    {
+        ap->key = key;
+        ap->want_security = WIPI_ROGUE_ANY;
+        wr->naps++;
+    }
+
+    return ap;
+}
+
+__wur
+struct __wipi_rogue_t* wipi_rogue_init(int rssi_jump,
+                                       int channel_window)
+{
+    struct __wipi_rogue_t*  wr;
+
+    wr = (struct __wipi_rogue_t*)WIPI_ALLOC( sizeof(struct __wipi_rogue_t) );
+    assert(wr != NULL);
+
+    memset( wr, 0, sizeof(struct __wipi_rogue_t) );
+
+    wr->aps_cap = wr->ssids_cap = WIPI_ROGUE_MIN;
+    wr->aps = (struct __wipi_rogue_ap_t*)calloc( wr->aps_cap, sizeof(struct __wipi_rogue_ap_t) );
+    wr->ssids = (struct __wipi_rogue_ssid_t*)calloc( wr->ssids_cap, sizeof(struct __wipi_rogue_ssid_t) );
+
+    assert(wr->aps != NULL && wr->ssids != NULL);
+
+    wr->rssi_jump = rssi_jump > 0 ? rssi_jump : WIPI_ROGUE_RSSI_JUMP;
+    wr->channel_window = (uint64_t)(channel_window > 0 ? channel_window : WIPI_ROGUE_CHANNEL_WINDOW) * 1000000000ULL;
+    wr->next_id = 1;
+
+    pthread_mutex_init(&wr->lock, NULL);
+
+    return wr;
+}
+
+int wipi_rogue_allow(struct __wipi_rogue_t* wr,
+                     const uint8_t* addr,
+                     const char* __restrict__ ssid,
+                     uint8_t security,
+                     uint8_t channel)
+{
+    struct __wipi_rogue_ap_t*   ap;
+    struct __wipi_rogue_ssid_t* s;
+    uint64_t                    key;
+    uint8_t                     rank;
+
+    assert(wr != NULL && addr != NULL);
+
+    /* No beacon can carry a longer SSID, it would never match */
+    if ((security != WIPI_ROGUE_ANY && security >= WIPI_ROGUE_SECURITIES) ||
+        (ssid && strnlen(ssid, WIPI_MAX_SSID + 1) > WIPI_MAX_SSID))
+    {
+        WIPI_ERRNO = WIPI_ERR_RANGE;
+
+        return -1;
+    }
+
+    pthread_mutex_lock(&wr->lock);
+
+    if ((ap = wipi_rogue_ap(wr, addr)) == NULL ||
+        (ssid && *ssid && (wr->nssids + 1) * 4 > wr->ssids_cap * 3 && wipi_rogue_grow_ssids(wr) < 0))
+    {
+        pthread_mutex_unlock(&wr->lock);
+
+        WIPI_ERRNO = WIPI_ERR_RANGE;
+
+        return -1;
+    }
+
+    ap->known = 1;
+    ap->want_security = security;
+    ap->want_channel = channel;
+    ap->alerted = 0;
+
+    if (ssid && *ssid)
+    {
+        key = wipi_rogue_ssid_key(ssid);
+        s = wipi_rogue_ssid_slot(wr->ssids, wr->ssids_cap, key, ssid);
+        rank = security == WIPI_ROGUE_ANY ? 0 : WIPI_ROGUE_RANK[security];
+
+        if (s->key == 0)
+        {
+            s->key = key;
+            s->rank = rank;
+            strncpy(s->ssid, ssid, WIPI_MAX_SSID);
+
+            wr->nssids++;
+        }
+        else if (rank < s->rank)
+            s->rank = rank;     /* the weakest allowed AP sets the bar */
+    }
+
+    pthread_mutex_unlock(&wr->lock);
+
+    return 0;
+}
+
+int wipi_rogue_load(struct __wipi_rogue_t* wr,
+                    const char* __restrict__ path)
+{
+    FILE*       fp;
+    char        line[256], bssid[32], sec[16], *ssid, *p;
+    uint8_t     addr[WIPI_MAC_LEN], security;
+    int         channel, off, count;
+
+    fp = fopen(path, "r");
+
+    if (fp == NULL)
+    {
+        WIPI_ERRNO = WIPI_ERR_IO;
+
+        return -1;
+    }
+
+    count = 0;
+
+    while (fgets(line, sizeof(line), fp))
+    {
+        if ((p = strchr(line, '#')) != NULL)
+            *p = '\0';
+
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if (sscanf(line, " %31s %15s %d %n", bssid, sec, &channel, &off) < 3 ||
+            wipi_mac_aton(bssid, addr) < 0)
+            continue;
+
+        ssid = line + off;
+
+        for (p = ssid + strlen(ssid); p > ssid && isspace((unsigned char)p[-1]); )
+            *--p = '\0';
+
+        security = WIPI_ROGUE_ANY;
+
+        for (size_t i = 0; i < WIPI_ROGUE_SECURITIES; i++)
+        {
+            if (strcasecmp(sec, WIPI_SECURITY_NAMES[i]) == 0)
+                security = (uint8_t)i;
+        }
+
+        if (wipi_rogue_allow(wr, addr, ssid, security, (uint8_t)channel) == 0)
+            count++;
+    }
+
+    fclose(fp);
+
+    return count;
+}
+
+void wipi_rogue_callback(struct __wipi_rogue_t* wr,
+                         wipi_rogue_fn fn,
+                         void* ctx)
+{
+    pthread_mutex_lock(&wr->lock);
+
+    wr->fn = fn;
+    wr->ctx = ctx;
+
+    pthread_mutex_unlock(&wr->lock);
+}
+
+static void wipi_rogue_raise(struct __wipi_rogue_t* wr,
+                             WIPI_ROGUE_RULE rule,
+                             const struct __wipi_beacon_t* wb,
+                             const struct __wipi_rogue_ap_t* ap,
+                             uint64_t now)
+{
+    struct __wipi_rogue_alert_t*    a;
+
+    a = &wr->alerts[wr->next_id % WIPI_ROGUE_ALERTS];
+
+    a->id = wr->next_id++;
+    a->ts = now;
+    a->rule = rule;
+
+    memcpy(a->addr, wb->addr, WIPI_MAC_LEN);
+    memcpy(a->ssid, wb->ssid, WIPI_MAX_SSID);
+
+    a->channel = wb->channel;
+    a->db = wb->db;
+    a->security = wb->caps.security;
+
+    a->prev_channel = ap->samples ? ap->channel : ap->want_channel;
+    a->prev_db = (int8_t)lroundf(ap->rssi);
+    a->prev_security = ap->samples ? ap->security : ap->want_security;
+
+    wr->counts[rule]++;
+
+    if (wr->fn)
+        wr->fn(wr->ctx, a);
+}
+
+int wipi_rogue_update(struct __wipi_rogue_t* wr,
+                      const struct __wipi_beacon_t* wb)
+{
+    struct __wipi_rogue_ap_t*   ap;
+    struct __wipi_rogue_ssid_t* s;
+    uint64_t                    now, key;
+    uint8_t                     rank, floor, first, changed;
+    int                         raised;
+
+    assert(wr != NULL && wb != NULL);
+
+    now = wb->seen ? wb->seen : wipi_stats_now();
+    raised = 0;
+
+    pthread_mutex_lock(&wr->lock);
+
+    if ((ap = wipi_rogue_ap(wr, wb->addr)) == NULL)
+    {
+        pthread_mutex_unlock(&wr->lock);
+
+        return 0;
+    }
+
+    first = ap->samples == 0;
+
+    s = NULL;
+
+    if (wb->ssid[0])
+    {
+        key = wipi_rogue_ssid_key(wb->ssid);
+        s = wipi_rogue_ssid_slot(wr->ssids, wr->ssids_cap, key, wb->ssid);
+        s = s->key ? s : NULL;
+    }
+
+    /* A known network name from a BSSID nobody vouched for */
+    if (s && !ap->known && !(ap->alerted & (1 << WIPI_ROGUE_TWIN)))
+    {
+        wipi_rogue_raise(wr, WIPI_ROGUE_TWIN, wb, ap, now);
+        ap->alerted |= 1 << WIPI_ROGUE_TWIN;
+        raised++;
+    }
+
+    /* Weaker than the allow-list, or than this BSSID has been before */
+    rank = WIPI_ROGUE_RANK[wb->caps.security < WIPI_ROGUE_SECURITIES ? wb->caps.security : 0];
+    floor = ap->best;
+
+    if (ap->known && ap->want_security != WIPI_ROGUE_ANY && WIPI_ROGUE_RANK[ap->want_security] > floor)
+        floor = WIPI_ROGUE_RANK[ap->want_security];
+    else if (!ap->known && s && s->rank > floor)
+        floor = s->rank;
+
+    changed = first || wb->caps.security != ap->security;
+
+    if (changed && rank < floor)
+    {
+        wipi_rogue_raise(wr, WIPI_ROGUE_DOWNGRADE, wb, ap, now);
+        raised++;
+    }
+
+    /* The same radio can't be on two channels at once */
+    if (wb->channel > 0)
+    {
+        if ((!first && wb->channel != ap->channel && now - ap->seen < wr->channel_window) ||
+            (ap->want_channel && wb->channel != ap->want_channel && (first || wb->channel != ap->channel)))
+        {
+            wipi_rogue_raise(wr, WIPI_ROGUE_CHANNEL, wb, ap, now);
+            raised++;
+        }
+    }
+
+    if (ap->samples >= WIPI_ROGUE_RSSI_SAMPLES && fabsf((float)wb->db - ap->rssi) >= wr->rssi_jump)
+    {
+        wipi_rogue_raise(wr, WIPI_ROGUE_RSSI, wb, ap, now);
+        raised++;
+    }
+
+    ap->rssi = first ? (float)wb->db : ap->rssi + ((float)wb->db - ap->rssi) / 4;
+    ap->seen = now;
+    ap->security = wb->caps.security;
+    ap->best = rank > ap->best ? rank : ap->best;
+
+    if (wb->channel > 0)
+        ap->channel = (uint8_t)wb->channel;
+
+    if (ap->samples < UINT16_MAX)
+        ap->samples++;
+
+    pthread_mutex_unlock(&wr->lock);
+
+    return raised;
+}
+
+void wipi_rogue_frame(void* ctx,
+                      const struct __wipi_frame_t* f,
+                      uint64_t ts_ns)
+{
+    wipi_beacon_t   wb;
+    struct timespec ts;
+
+    if (wipi_frame_beacon(f, &wb) < 0)
+        return;
+
+    /* Frames carry wall clock time, the state runs on the monotonic clock.
+     * A replayed frame from before boot wraps, differences still hold.
+     */
+    if (ts_ns)
+    {
+        clock_gettime(CLOCK_REALTIME, &ts);
+
+        wb.seen = ts_ns - ((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec - wipi_stats_now());
+    }
+
+    wipi_rogue_update((struct __wipi_rogue_t*)ctx, &wb);
+}
+
+int wipi_rogue_alerts(struct __wipi_rogue_t* wr,
+                      uint64_t since,
+                      struct __wipi_rogue_alert_t* out,
+                      int max)
+{
+    uint64_t    id;
+    int         n;
+
+    pthread_mutex_lock(&wr->lock);
+
+    /* Older alerts have been overwritten by the ring */
+    id = since + 1;
+
+    if (wr->next_id > WIPI_ROGUE_ALERTS && id < wr->next_id - WIPI_ROGUE_ALERTS)
+        id = wr->next_id - WIPI_ROGUE_ALERTS;
+
+    for (n = 0; id < wr->next_id && n < max; id++)
+        out[n++] = wr->alerts[id % WIPI_ROGUE_ALERTS];
+
+    pthread_mutex_unlock(&wr->lock);
+
+    return n;
+}
+
+void wipi_rogue_free(struct __wipi_rogue_t* wr)
+{
+    if (wr == NULL)
+        return;
+
+    pthread_mutex_destroy(&wr->lock);
+
+    free(wr->aps);
+    free(wr->ssids);
+    free(wr);
+}
@@ -0,0 +1,174 @@
+/*    wipi_rogue.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Rogue AP / evil twin detection for WiPi.
+ * See wipi_rogue.c for source definitions.
+ *
+ * Every AP observation (a scan result or a captured beacon) is run
+ * through the rules as it arrives, against per-BSSID state and an
+ * allow-list of known APs, both held in open addressing hash tables.
+ * Nothing ever walks the whole set, so an update costs the same
+ * however many APs are tracked. The BSSID table stops growing at
+ * WIPI_ROGUE_MAX slots, after which about a quarter of it, the APs
+ * seen longest ago, is forgotten to make room (never allow-listed
+ * ones), so spoofed beacons from endless random BSSIDs can't exhaust
+ * memory.
+ *
+ * Rules:
+ *   evil-twin          - an allow-listed SSID from a BSSID not on the list
+ *   security-downgrade - weaker security than the allow-list (or than the
+ *                        same BSSID has shown before)
+ *   channel-mismatch   - a BSSID hopping channel within the window, or off
+ *                        its allow-listed channel
+ *   rssi-jump          - signal moving further than the threshold from its
+ *                        running average
+ *
+ * Allow-list files have one AP per line, '#' starts a comment:
+ *   <bssid> <security|any> <channel|0> <ssid...>
+ */
+
+#ifndef _WIPI_ROGUE_H_
+#define _WIPI_ROGUE_H_
+
+#ifndef _WIPI_FRAME_H_
+    #include "wipi_frame.h"
+#endif
+
+/*    INCLUDES    */
+#include <pthread.h>
+
+/*    MACRO DEFS    */
+#define WIPI_ROGUE_MIN              256
+#define WIPI_ROGUE_MAX              65536   /* BSSID slots, power of 2 */
+#define WIPI_ROGUE_SAMPLE           64      /* ages sampled to pick what to evict */
+#define WIPI_ROGUE_ALERTS           256     /* ring of recent alerts */
+
+#define WIPI_ROGUE_RSSI_JUMP        20      /* dB  */
+#define WIPI_ROGUE_RSSI_SAMPLES     4       /* before the average is trusted */
+#define WIPI_ROGUE_CHANNEL_WINDOW   10      /* s   */
+
+#define WIPI_ROGUE_ANY              0xFF    /* allow-list security wildcard */
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_ROGUE_TWIN,
+    WIPI_ROGUE_DOWNGRADE,
+    WIPI_ROGUE_CHANNEL,
+    WIPI_ROGUE_RSSI,
+    WIPI_ROGUE_RULES
+} WIPI_ROGUE_RULE;
+
+typedef struct __wipi_rogue_ap_t
+{
+    uint64_t    key;            /* mac key | WIPI_ROGUE_USED, 0 = empty */
+    uint64_t    seen;           /* monotonic ns */
+    float       rssi;           /* running average, dBm */
+    uint16_t    samples;
+    uint8_t     channel;
+    uint8_t     security;       /* last seen, WIPI_SECURITY */
+    uint8_t     best;           /* strongest rank seen */
+    uint8_t     alerted;        /* 1 << WIPI_ROGUE_TWIN once raised */
+
+    uint8_t     known;          /* on the allow-list */
+    uint8_t     want_security;  /* WIPI_SECURITY or WIPI_ROGUE_ANY */
+    uint8_t     want_channel;   /* 0 = any */
+} wipi_rogue_ap_t;
+
+typedef struct __wipi_rogue_ssid_t
+{
+    uint64_t    key;            /* ssid hash | WIPI_ROGUE_USED, 0 = empty */
+    char        ssid[WIPI_MAX_SSID];
+    uint8_t     rank;           /* weakest security rank the allow-list accepts */
+} wipi_rogue_ssid_t;
+
+typedef struct __wipi_rogue_alert_t
+{
+    uint64_t        id;
+    uint64_t        ts;         /* monotonic ns */
+    WIPI_ROGUE_RULE rule;
+
+    uint8_t         addr[WIPI_MAC_LEN];
+    char            ssid[WIPI_MAX_SSID];
+
+    int             channel;
+    int             prev_channel;
+    int8_t          db;
+    int8_t          prev_db;
+    uint8_t         security;
+    uint8_t         prev_security;
+} wipi_rogue_alert_t;
+
+typedef void (*wipi_rogue_fn)(void* ctx,
+                              const struct __wipi_rogue_alert_t* alert);
+
+typedef struct __wipi_rogue_t
+{
+    struct __wipi_rogue_ap_t*       aps;
+    size_t                          naps;
+    size_t                          aps_cap;        /* power of 2 */
+    uint64_t                        evicted;
+
+    struct __wipi_rogue_ssid_t*     ssids;
+    size_t                          nssids;
+    size_t                          ssids_cap;      /* power of 2 */
+
+    struct __wipi_rogue_alert_t     alerts[WIPI_ROGUE_ALERTS];
+    uint64_t                        next_id;
+    uint64_t                        counts[WIPI_ROGUE_RULES];
+
+    int                             rssi_jump;
+    uint64_t                        channel_window; /* ns */
+
+    wipi_rogue_fn                   fn;
+    void*                           ctx;
+
+    pthread_mutex_t                 lock;
+} wipi_rogue_t;
+
+/*    STATIC DEFS    */
+static const char* WIPI_ROGUE_NAMES[] = {
+    "evil-twin",
+    "security-downgrade",
+    "channel-mismatch",
+    "rssi-jump"
+};
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_rogue_t* wipi_rogue_init(int rssi_jump,
+                                       int channel_window);
+
+int wipi_rogue_allow(struct __wipi_rogue_t* wr,
+                     const uint8_t* addr,
+                     const char* __restrict__ ssid,
+                     uint8_t security,
+                     uint8_t channel);
+
+int wipi_rogue_load(struct __wipi_rogue_t* wr,
+                    const char* __restrict__ path);
+
+void wipi_rogue_callback(struct __wipi_rogue_t* wr,
+                         wipi_rogue_fn fn,
+                         void* ctx);
+
+int wipi_rogue_update(struct __wipi_rogue_t* wr,
+                      const struct __wipi_beacon_t* wb);
+
+void wipi_rogue_frame(void* ctx,
+                      const struct __wipi_frame_t* f,
+                      uint64_t ts_ns);
+
+int wipi_rogue_alerts(struct __wipi_rogue_t* wr,
+                      uint64_t since,
+                      struct __wipi_rogue_alert_t* out,
+                      int max);
+
+void wipi_rogue_free(struct __wipi_rogue_t* wr);
+
+#endif
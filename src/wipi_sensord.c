@@ -0,0 +1,210 @@
+/*    wipi_sensord.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Sensor daemon for WiPi.
+ *
+ * Owns the radios, scans them and publishes the AP and interface
+ * tables into shared memory (see wipi_shm.h), so any number of API
+ * workers can serve scans without each of them driving the hardware.
+ * The delay between scans adapts to churn (see wipi_cadence.h), pin
+ * it with -m and -M set to the same value.
+ *
+ *   wipi-sensord -i wlan0 [-i wlan1 ...] [-n /wipi] [-t ms] [-m ms] [-M ms] [-s bytes] [-I scans]
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef _WIPI_GROUP_H_
+    #include "wipi_group.h"
+#endif
+
+#ifndef _WIPI_SHM_H_
+    #include "wipi_shm.h"
+#endif
+
+#ifndef _WIPI_CADENCE_H_
+    #include "wipi_cadence.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_SENSORD_INTERVAL   5000    /* ms before the first adjustment */
+#define WIPI_SENSORD_IFREFRESH  12      /* scans between interface refreshes */
+#define WIPI_SENSORD_IFACES     64
+
+/*    STATIC DEFS    */
+static volatile sig_atomic_t running = 1;
+
+/*    FUNCTION DEFINITIONS    */
+static void wipi_sensord_stop(int sig)
+{
+    (void)sig;
+
+    running = 0;
+}
+
+static void wipi_sensord_usage(const char* argv0)
+{
+    fprintf(stderr,
+            "Usage: %s -i <interface> [-i <interface> ...] [options]\n"
+            "\n"
+            "  -i <interface>   radio to scan with (up to %d)\n"
+            "  -n <name>        shared memory name (default %s)\n"
+            "  -t <ms>          initial delay between scans (default %d)\n"
+            "  -m <ms>          shortest delay between scans (default %d)\n"
+            "  -M <ms>          longest delay between scans (default %d)\n"
+            "  -s <bytes>       snapshot buffer size (default %d)\n"
+            "  -I <scans>       refresh interfaces every N scans (default %d)\n",
+            argv0,
+            WIPI_MAX_RADIOS,
+            WIPI_SHM_NAME,
+            WIPI_SENSORD_INTERVAL,
+            WIPI_CADENCE_MIN_MS,
+            WIPI_CADENCE_MAX_MS,
+            WIPI_SHM_SIZE,
+            WIPI_SENSORD_IFREFRESH);
+}
+
+int main(int argc, char** argv)
+{
+    struct __wipi_scanner_group_t*  wg;
+    struct __wipi_shm_t*            shm;
+    struct __wipi_cadence_t*        wc;
+    struct __wipi_shm_if_t          ifaces[WIPI_SENSORD_IFACES];
+    struct sigaction                sa;
+    struct timespec                 ts;
+    const char*                     radios[WIPI_MAX_RADIOS];
+    const char*                     name;
+    size_t                          size;
+    int                             interval, min, max, refresh, nifaces, opt;
+    uint32_t                        ok;
+    uint64_t                        scans;
+
+    wg = wipi_scanner_group_init(WIPI_MERGE_STRONGEST);
+    name = WIPI_SHM_NAME;
+    size = WIPI_SHM_SIZE;
+    interval = WIPI_SENSORD_INTERVAL;
+    min = WIPI_CADENCE_MIN_MS;
+    max = WIPI_CADENCE_MAX_MS;
+    refresh = WIPI_SENSORD_IFREFRESH;
+
+    while ((opt = getopt(argc, argv, "i:n:t:m:M:s:I:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'i':
+                if (wipi_scanner_group_add(wg, optarg, NULL, 0) < 0)
+                {
+                    fprintf(stderr, "Could not add radio %s\n", optarg);
+                    WIPI_PERROR();
+
+                    return 1;
+                }
+
+                radios[wg->count - 1] = optarg;
+
+                break;
+            case 'n':
+                name = optarg;
+                break;
+            case 't':
+                interval = atoi(optarg);
+                break;
+            case 'm':
+                min = atoi(optarg);
+                break;
+            case 'M':
+                max = atoi(optarg);
+                break;
+            case 's':
+                size = strtoul(optarg, NULL, 0);
+                break;
+            case 'I':
+                refresh = atoi(optarg) > 0 ? atoi(optarg) : 1;
+                break;
+            default:
+                wipi_sensord_usage(argv[0]);
+
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (wg->count == 0)
+    {
+        wipi_sensord_usage(argv[0]);
+
+        return 1;
+    }
+
+    if ((shm = wipi_shm_create(name, size)) == NULL)
+    {
+        fprintf(stderr, "Could not create shared memory %s\n", name);
+        WIPI_PERROR();
+
+        return 1;
+    }
+
+    wc = wipi_cadence_init(interval > 0 ? interval : 0, min > 0 ? min : 0, max > 0 ? max : 0);
+
+    memset( &sa, 0, sizeof(sa) );
+    sa.sa_handler = wipi_sensord_stop;
+
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    nifaces = 0;
+
+    for (scans = 0; running; scans++)
+    {
+        if (scans % refresh == 0)
+            nifaces = wipi_shm_interfaces(ifaces, WIPI_SENSORD_IFACES);
+
+        wipi_scanner_group_scan(wg);
+
+        /* Radios that came back, the cadence ignores what only the others had seen */
+        ok = 0;
+
+        for (int i = 0; i < wg->count; i++)
+        {
+            if (wg->radios[i].status == WIPI_ERR_OK)
+                ok |= 1U << i;
+        }
+
+        interval = wipi_cadence_update(wc, wg->table, ok);
+
+        /* No radio came back, keep the last sweep and its age rather than an empty table */
+        if (!ok)
+            wipi_shm_republish(shm, &wc->stats);
+        else
+            wipi_shm_publish(shm,
+                             wipi_aptable_list(wg->table),
+                             ifaces,
+                             nifaces > 0 ? nifaces : 0,
+                             radios,
+                             wg->count,
+                             &wc->stats);
+
+        ts.tv_sec = interval / 1000;
+        ts.tv_nsec = (long)(interval % 1000) * 1000000;
+
+        /* Interrupted by SIGINT/SIGTERM, the loop condition ends it */
+        nanosleep(&ts, NULL);
+    }
+
+    wipi_cadence_free(wc);
+    wipi_shm_free(shm);
+    wipi_scanner_group_free(wg);
+
+    return 0;
+}
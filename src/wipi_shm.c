@@ -0,0 +1,591 @@
+/*    wipi_shm.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Shared memory AP/interface snapshot definitions for WiPi.
+ * See wipi_shm.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <fcntl.h>
+#include <stddef.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifndef _WIPI_SHM_H_
+    #include "wipi_shm.h"
+#endif
+
+#ifndef _WIPI_OUI_H_
+    #include "wipi_oui.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_SHM_ALIGN(n)   (((n) + 63) & ~(size_t)63)
+#define WIPI_SHM_HDR_LEN    WIPI_SHM_ALIGN(sizeof(struct __wipi_shm_hdr_t))
+
+/*    FUNCTION DEFINITIONS    */
+static inline struct __wipi_shm_buf_t* wipi_shm_buf(struct __wipi_shm_t* ws, uint32_t i)
+{
+    return (struct __wipi_shm_buf_t*)(ws->map + WIPI_SHM_HDR_LEN + (size_t)i * ws->hdr->buf_size);
+}
+
+static inline uint8_t* wipi_shm_data(struct __wipi_shm_buf_t* buf)
+{
+    return (uint8_t*)buf + sizeof(struct __wipi_shm_buf_t);
+}
+
+__wur
+struct __wipi_shm_t* wipi_shm_create(const char* __restrict__ name,
+                                     size_t size)
+{
+    struct __wipi_shm_t*    ws;
+
+    ws = (struct __wipi_shm_t*)WIPI_ALLOC( sizeof(struct __wipi_shm_t) );
+    assert(ws != NULL);
+
+    memset( ws, 0, sizeof(struct __wipi_shm_t) );
+
+    size = WIPI_SHM_ALIGN( sizeof(struct __wipi_shm_buf_t) + (size ? size : WIPI_SHM_SIZE) );
+
+    ws->name = strdup(name ? name : WIPI_SHM_NAME);
+    ws->len = WIPI_SHM_HDR_LEN + 2 * size;
+    ws->writer = 1;
+
+    /* Start from a fresh segment, readers of an old one keep their mapping */
+    shm_unlink(ws->name);
+
+    ws->fd = shm_open(ws->name, O_CREAT | O_EXCL | O_RDWR, 0644);
+
+    if (ws->fd < 0 || ftruncate(ws->fd, ws->len) < 0 ||
+        (ws->map = mmap(NULL, ws->len, PROT_READ | PROT_WRITE, MAP_SHARED, ws->fd, 0)) == MAP_FAILED)
+    {
+        WIPI_ERRNO = WIPI_ERR_IO;
+
+        if (ws->fd >= 0)
+        {
+            close(ws->fd);
+            shm_unlink(ws->name);
+        }
+
+        free(ws->name);
+        free(ws);
+
+        return NULL;
+    }
+
+    ws->hdr = (struct __wipi_shm_hdr_t*)ws->map;
+
+    ws->hdr->version = WIPI_SHM_VERSION;
+    ws->hdr->ap_size = sizeof(struct __wipi_shm_ap_t);
+    ws->hdr->if_size = sizeof(struct __wipi_shm_if_t);
+    ws->hdr->buf_size = (uint32_t)size;
+    ws->hdr->pid = getpid();
+
+    /* Readers check the magic last */
+    __atomic_store_n(&ws->hdr->magic, WIPI_SHM_MAGIC, __ATOMIC_RELEASE);
+
+    return ws;
+}
+
+static void wipi_shm_enc_names(struct __wipi_enc_t* e, uint32_t mask, const char** names, int count)
+{
+    uint32_t    n;
+
+    n = 0;
+
+    for (int i = 0; i < count; i++)
+        n += (mask & (1U << i)) && names[i];
+
+    wipi_enc_array(e, n);
+
+    for (int i = 0; i < count; i++)
+    {
+        if ((mask & (1U << i)) && names[i])
+            wipi_enc_str(e, names[i], (size_t)-1);
+    }
+
+    wipi_enc_end(e);
+}
+
+/* Same shape as /scan builds from wipi.beacon objects */
+static void wipi_shm_enc_ap(struct __wipi_enc_t* e,
+                            const struct __wipi_shm_ap_t* ap,
+                            const char** radios,
+                            int nradios)
+{
+    static const char*  pmf[] = { "disabled", "capable", "required" };
+    const char*         vendor;
+    char                bssid[WIPI_MAX_BSSID];
+
+    snprintf(bssid,
+             sizeof(bssid),
+             "%02X:%02X:%02X:%02X:%02X:%02X",
+             ap->addr[0], ap->addr[1], ap->addr[2], ap->addr[3], ap->addr[4], ap->addr[5]);
+
+    vendor = wipi_oui_lookup(ap->addr);
+
+    wipi_enc_map(e, 15);
+
+    wipi_enc_key(e, "ssid");        wipi_enc_str(e, ap->ssid, WIPI_MAX_SSID);
+    wipi_enc_key(e, "bssid");       wipi_enc_str(e, bssid, sizeof(bssid));
+    wipi_enc_key(e, "vendor");      vendor ? wipi_enc_str(e, vendor, (size_t)-1) : wipi_enc_null(e);
+    wipi_enc_key(e, "stats");       wipi_enc_str(e, ap->stats, WIPI_MAX_STATS);
+    wipi_enc_key(e, "frequency");   wipi_enc_float(e, (double)ap->freq_mhz / 1000);
+    wipi_enc_key(e, "quality");     wipi_enc_float(e, (double)ap->qual);
+    wipi_enc_key(e, "db");          wipi_enc_int(e, ap->db);
+    wipi_enc_key(e, "channel");     wipi_enc_int(e, ap->channel);
+    wipi_enc_key(e, "band");        wipi_enc_str(e, WIPI_BAND_NAMES[ap->band <= WIPI_BAND_6G ? ap->band : 0], (size_t)-1);
+    wipi_enc_key(e, "radio");       ap->radio < nradios ? wipi_enc_str(e, radios[ap->radio], IFNAMSIZ) : wipi_enc_null(e);
+    wipi_enc_key(e, "radios");      wipi_shm_enc_names(e, ap->radios, radios, nradios);
+    wipi_enc_key(e, "security");    wipi_enc_str(e, WIPI_SECURITY_NAMES[ap->caps.security], (size_t)-1);
+
+    wipi_enc_key(e, "capabilities");
+    wipi_enc_map(e, 13);
+
+    wipi_enc_key(e, "akm");         wipi_shm_enc_names(e, ap->caps.akm, WIPI_AKM_NAMES, WIPI_AKMS);
+    wipi_enc_key(e, "pairwise");    wipi_shm_enc_names(e, ap->caps.pairwise, WIPI_CIPHER_NAMES, WIPI_CIPHERS);
+    wipi_enc_key(e, "group");       wipi_shm_enc_names(e, ap->caps.group, WIPI_CIPHER_NAMES, WIPI_CIPHERS);
+    wipi_enc_key(e, "width");       wipi_enc_int(e, WIPI_WIDTH_MHZ[ap->caps.width]);
+    wipi_enc_key(e, "nss");         wipi_enc_int(e, ap->caps.nss);
+    wipi_enc_key(e, "enterprise");  wipi_enc_bool(e, ap->caps.enterprise);
+    wipi_enc_key(e, "ht");          wipi_enc_bool(e, ap->caps.ht);
+    wipi_enc_key(e, "vht");         wipi_enc_bool(e, ap->caps.vht);
+    wipi_enc_key(e, "he");          wipi_enc_bool(e, ap->caps.he);
+    wipi_enc_key(e, "wps");         wipi_enc_bool(e, ap->caps.wps);
+    wipi_enc_key(e, "pmf");         wipi_enc_str(e, pmf[ap->caps.pmf < 3 ? ap->caps.pmf : 0], (size_t)-1);
+    wipi_enc_key(e, "country");     ap->caps.country[0] ? wipi_enc_str(e, ap->caps.country, 2) : wipi_enc_null(e);
+    wipi_enc_key(e, "vendor_ies");  wipi_enc_int(e, ap->caps.vendor_ies);
+
+    wipi_enc_end(e);
+
+    /* Airtime is tracked by the API's own captures, the daemon has none */
+    wipi_enc_key(e, "airtime");     wipi_enc_null(e);
+    wipi_enc_key(e, "utilization"); wipi_enc_null(e);
+
+    wipi_enc_end(e);
+}
+
+/* Encode a complete WiapiResponse body into the data area, 0 if it did not fit */
+static uint32_t wipi_shm_encode(struct __wipi_shm_buf_t* buf,
+                                uint32_t room,
+                                WIPI_SHM_SECTION sect,
+                                WIPI_ENC fmt,
+                                const char** radios,
+                                int nradios)
+{
+    struct __wipi_enc_t             e;
+    const struct __wipi_shm_ap_t*   ap;
+    const struct __wipi_shm_if_t*   wi;
+    uint32_t                        count;
+
+    wipi_enc_init(&e, fmt, wipi_shm_data(buf) + buf->used, room - buf->used);
+
+    wipi_enc_map(&e, 2);
+    wipi_enc_key(&e, "success");
+    wipi_enc_bool(&e, 1);
+    wipi_enc_key(&e, "data");
+
+    if (sect == WIPI_SHM_APS)
+    {
+        ap = (const struct __wipi_shm_ap_t*)wipi_shm_section(buf, WIPI_SHM_APS, &count);
+
+        wipi_enc_map(&e, 2);
+        wipi_enc_key(&e, "message");
+        wipi_enc_array(&e, count);
+
+        for (uint32_t i = 0; i < count; i++)
+            wipi_shm_enc_ap(&e, &ap[i], radios, nradios);
+
+        wipi_enc_end(&e);
+        wipi_enc_key(&e, "total");
+        wipi_enc_int(&e, count);
+    }
+    else
+    {
+        wi = (const struct __wipi_shm_if_t*)wipi_shm_section(buf, WIPI_SHM_IFACES, &count);
+
+        wipi_enc_map(&e, 1);
+        wipi_enc_key(&e, "message");
+        wipi_enc_array(&e, count);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            wipi_enc_map(&e, 1);
+            wipi_enc_key(&e, wi[i].name);
+            wipi_enc_map(&e, 4);
+
+            wipi_enc_key(&e, "addr");           wi[i].addr[0] ? wipi_enc_str(&e, wi[i].addr, INET_ADDRSTRLEN) : wipi_enc_null(&e);
+            wipi_enc_key(&e, "mask");           wi[i].mask[0] ? wipi_enc_str(&e, wi[i].mask, INET_ADDRSTRLEN) : wipi_enc_null(&e);
+            wipi_enc_key(&e, "flags");          wipi_enc_int(&e, wi[i].flags);
+            wipi_enc_key(&e, "monitor_mode");   wipi_enc_bool(&e, wi[i].mon);
+
+            wipi_enc_end(&e);
+            wipi_enc_end(&e);
+        }
+
+        wipi_enc_end(&e);
+    }
+
+    wipi_enc_end(&e);
+    wipi_enc_end(&e);
+
+    return e.overflow ? 0 : (uint32_t)e.len;
+}
+
+int wipi_shm_publish(struct __wipi_shm_t* ws,
+                     struct __wipi_beacon_t* aps,
+                     const struct __wipi_shm_if_t* ifaces,
+                     int nifaces,
+                     const char** radios,
+                     int nradios,
+                     const struct __wipi_cadence_stats_t* cadence)
+{
+    struct __wipi_shm_buf_t*    buf, *cur;
+    struct __wipi_shm_ap_t*     ap;
+    struct timespec             ts;
+    uint32_t                    idx, room, n;
+    uint8_t*                    data;
+
+    assert(ws->writer);
+
+    idx = __atomic_load_n(&ws->hdr->current, __ATOMIC_RELAXED);
+    cur = wipi_shm_buf(ws, idx);
+
+    idx ^= 1;
+    buf = wipi_shm_buf(ws, idx);
+    data = wipi_shm_data(buf);
+    room = ws->hdr->buf_size - sizeof(struct __wipi_shm_buf_t);
+
+    __atomic_store_n(&buf->seq, buf->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    memset( buf->sections, 0, sizeof(buf->sections) );
+
+    if (cadence)
+        buf->cadence = *cadence;
+    else
+        memset( &buf->cadence, 0, sizeof(buf->cadence) );
+
+    wipi_stats_snapshot(&buf->stats);
+
+    /* Interfaces first, they are few and always fit */
+    n = (uint32_t)nifaces * sizeof(struct __wipi_shm_if_t) <= room ? (uint32_t)nifaces : 0;
+
+    buf->sections[WIPI_SHM_IFACES].off = 0;
+    buf->sections[WIPI_SHM_IFACES].count = n;
+    buf->sections[WIPI_SHM_IFACES].len = n * sizeof(struct __wipi_shm_if_t);
+
+    memcpy(data, ifaces, buf->sections[WIPI_SHM_IFACES].len);
+
+    buf->used = WIPI_SHM_ALIGN(buf->sections[WIPI_SHM_IFACES].len);
+    buf->sections[WIPI_SHM_APS].off = buf->used;
+
+    n = 0;
+    ap = (struct __wipi_shm_ap_t*)(data + buf->used);
+
+    for (struct __wipi_beacon_t* wb = aps; wb && wb->next; wb = wb->next)
+    {
+        if (buf->used + (n + 1) * sizeof(struct __wipi_shm_ap_t) > room)
+        {
+            ws->status = WIPI_ERR_RANGE;    /* published truncated */
+            break;
+        }
+
+        memset( ap, 0, sizeof(struct __wipi_shm_ap_t) );
+
+        memcpy(ap->ssid, wb->ssid, WIPI_MAX_SSID);
+        memcpy(ap->stats, wb->stats, WIPI_MAX_STATS - 1);
+        memcpy(ap->addr, wb->addr, WIPI_MAC_LEN);
+
+        ap->freq_mhz = wb->freq_mhz;
+        ap->band = wb->band;
+        ap->db = wb->db;
+        ap->qual = wb->qual;
+        ap->channel = wb->channel;
+        ap->caps = wb->caps;
+        ap->radio = wb->radio;
+        ap->radios = wb->radios;
+        ap->seen = wb->seen;
+        ap->airtime = wb->airtime;
+        ap->utilization = wb->utilization;
+
+        ap++;
+        n++;
+    }
+
+    buf->sections[WIPI_SHM_APS].count = n;
+    buf->sections[WIPI_SHM_APS].len = n * sizeof(struct __wipi_shm_ap_t);
+    buf->used += WIPI_SHM_ALIGN(buf->sections[WIPI_SHM_APS].len);
+
+    /* Response bodies, a reader falls back to the records if one did not fit */
+    for (int fmt = 0; fmt < WIPI_ENCS; fmt++)
+    {
+        for (int s = WIPI_SHM_APS; s <= WIPI_SHM_IFACES; s++)
+        {
+            struct __wipi_shm_sect_t*   body;
+
+            body = &buf->sections[(s == WIPI_SHM_APS ? WIPI_SHM_APS_BODY : WIPI_SHM_IFACES_BODY) + fmt];
+
+            body->off = buf->used;
+            body->len = wipi_shm_encode(buf, room, (WIPI_SHM_SECTION)s, (WIPI_ENC)fmt, radios, nradios);
+            body->count = buf->sections[s].count;
+
+            if (body->len == 0)
+                ws->status = WIPI_ERR_RANGE;
+
+            buf->used += WIPI_SHM_ALIGN(body->len);
+        }
+    }
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    buf->generation = cur->generation + 1;
+    buf->published = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+    __atomic_store_n(&buf->seq, buf->seq + 1, __ATOMIC_RELEASE);
+
+    /* Radio names only change if the daemon is restarted with others */
+    ws->hdr->nradios = nradios < WIPI_SHM_RADIOS ? nradios : WIPI_SHM_RADIOS;
+
+    for (uint32_t i = 0; i < ws->hdr->nradios; i++)
+        strncpy(ws->hdr->radios[i], radios[i], IFNAMSIZ - 1);
+
+    __atomic_store_n(&ws->hdr->current, idx, __ATOMIC_RELEASE);
+
+    return (int)n;
+}
+
+int wipi_shm_republish(struct __wipi_shm_t* ws,
+                       const struct __wipi_cadence_stats_t* cadence)
+{
+    struct __wipi_shm_buf_t*    buf, *cur;
+    uint32_t                    idx;
+    size_t                      off;
+
+    assert(ws->writer);
+
+    idx = __atomic_load_n(&ws->hdr->current, __ATOMIC_RELAXED);
+    cur = wipi_shm_buf(ws, idx);
+
+    /* Nothing good to keep yet */
+    if (cur->generation == 0)
+        return 0;
+
+    idx ^= 1;
+    buf = wipi_shm_buf(ws, idx);
+
+    __atomic_store_n(&buf->seq, buf->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    /* Everything but the sequence number, generation and timestamp included */
+    off = offsetof(struct __wipi_shm_buf_t, generation);
+    memcpy((uint8_t*)buf + off, (const uint8_t*)cur + off, sizeof(struct __wipi_shm_buf_t) - off + cur->used);
+
+    if (cadence)
+        buf->cadence = *cadence;
+
+    wipi_stats_snapshot(&buf->stats);
+
+    __atomic_store_n(&buf->seq, buf->seq + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&ws->hdr->current, idx, __ATOMIC_RELEASE);
+
+    return (int)buf->sections[WIPI_SHM_APS].count;
+}
+
+__wur
+struct __wipi_shm_t* wipi_shm_open(const char* __restrict__ name)
+{
+    struct __wipi_shm_t*    ws;
+    struct stat             st;
+
+    ws = (struct __wipi_shm_t*)WIPI_ALLOC( sizeof(struct __wipi_shm_t) );
+    assert(ws != NULL);
+
+    memset( ws, 0, sizeof(struct __wipi_shm_t) );
+
+    ws->name = strdup(name ? name : WIPI_SHM_NAME);
+    ws->fd = shm_open(ws->name, O_RDONLY, 0);
+    ws->map = MAP_FAILED;
+
+    if (ws->fd >= 0 && fstat(ws->fd, &st) == 0 && (size_t)st.st_size >= WIPI_SHM_HDR_LEN)
+    {
+        ws->len = st.st_size;
+        ws->map = mmap(NULL, ws->len, PROT_READ, MAP_SHARED, ws->fd, 0);
+    }
+
+    ws->hdr = (struct __wipi_shm_hdr_t*)ws->map;
+
+    if (ws->map == MAP_FAILED ||
+        __atomic_load_n(&ws->hdr->magic, __ATOMIC_ACQUIRE) != WIPI_SHM_MAGIC ||
+        ws->hdr->version != WIPI_SHM_VERSION ||
+        ws->hdr->ap_size != sizeof(struct __wipi_shm_ap_t) ||
+        ws->hdr->if_size != sizeof(struct __wipi_shm_if_t) ||
+        WIPI_SHM_HDR_LEN + 2 * (size_t)ws->hdr->buf_size > ws->len)
+    {
+        WIPI_ERRNO = ws->fd < 0 ? WIPI_ERR_IO : WIPI_ERR_RANGE;
+
+        if (ws->map != MAP_FAILED)
+            munmap(ws->map, ws->len);
+
+        if (ws->fd >= 0)
+            close(ws->fd);
+
+        free(ws->name);
+        free(ws);
+
+        return NULL;
+    }
+
+    /* Nothing else needs the descriptor once mapped */
+    close(ws->fd);
+    ws->fd = -1;
+
+    ws->snap = (struct __wipi_shm_buf_t*)aligned_alloc( 64, ws->hdr->buf_size );
+    assert(ws->snap != NULL);
+
+    memset( ws->snap, 0, sizeof(struct __wipi_shm_buf_t) );
+
+    return ws;
+}
+
+const struct __wipi_shm_buf_t* wipi_shm_snapshot(struct __wipi_shm_t* ws)
+{
+    struct __wipi_shm_buf_t*    buf;
+    uint64_t                    seq;
+    uint32_t                    used, idx;
+
+    for (int i = 0; i < WIPI_SHM_RETRIES; i++)
+    {
+        idx = __atomic_load_n(&ws->hdr->current, __ATOMIC_ACQUIRE);
+        buf = wipi_shm_buf(ws, idx);
+        seq = __atomic_load_n(&buf->seq, __ATOMIC_ACQUIRE);
+
+        if (seq & 1)
+            continue;
+
+        /* Unchanged since the last copy, no need to copy it again. A republish
+         * keeps the generation, the buffer it went to tells them apart.
+         */
+        if (ws->from == idx && ws->snap->seq == seq && ws->snap->generation == buf->generation && ws->snap->generation)
+            return ws->snap;
+
+        used = buf->used;
+
+        if (used > ws->hdr->buf_size - sizeof(struct __wipi_shm_buf_t))
+            continue;
+
+        memcpy(ws->snap, buf, sizeof(struct __wipi_shm_buf_t) + used);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&buf->seq, __ATOMIC_RELAXED) == seq)
+        {
+            ws->snap->seq = seq;
+            ws->from = idx;
+
+            return ws->snap;
+        }
+    }
+
+    ws->snap->generation = 0;
+    WIPI_ERRNO = WIPI_ERR_BUSY;
+
+    return NULL;
+}
+
+const void* wipi_shm_section(const struct __wipi_shm_buf_t* buf,
+                             WIPI_SHM_SECTION sect,
+                             uint32_t* count)
+{
+    if (count)
+        *count = buf->sections[sect].count;
+
+    return (const uint8_t*)buf + sizeof(struct __wipi_shm_buf_t) + buf->sections[sect].off;
+}
+
+int wipi_shm_interfaces(struct __wipi_shm_if_t* out,
+                        int max)
+{
+    struct ifaddrs*     ifa, *ifp;
+    wipi_interface_t    wi;
+    int                 n, i;
+
+    if (getifaddrs(&ifa) < 0)
+    {
+        WIPI_ERRNO = WIPI_ERR_IO;
+
+        return -1;
+    }
+
+    n = 0;
+
+    /* Every link once (AF_PACKET), then fill in AF_INET addresses */
+    for (ifp = ifa; ifp && n < max; ifp = ifp->ifa_next)
+    {
+        if (ifp->ifa_addr == NULL || ifp->ifa_addr->sa_family != AF_PACKET)
+            continue;
+
+        memset( &out[n], 0, sizeof(struct __wipi_shm_if_t) );
+        memset( &wi, 0, sizeof(wi) );
+
+        strncpy(out[n].name, ifp->ifa_name, IFNAMSIZ - 1);
+
+        wi.if_name = out[n].name;
+
+        out[n].flags = ifp->ifa_flags;
+        out[n].mon = wipi_interface_monitor_mode(&wi);
+
+        n++;
+    }
+
+    for (ifp = ifa; ifp; ifp = ifp->ifa_next)
+    {
+        if (ifp->ifa_addr == NULL || ifp->ifa_addr->sa_family != AF_INET)
+            continue;
+
+        for (i = 0; i < n && strcmp(out[i].name, ifp->ifa_name); i++)
+            ;
+
+        if (i == n)
+            continue;
+
+        inet_ntop(AF_INET, &((struct sockaddr_in*)ifp->ifa_addr)->sin_addr, out[i].addr, INET_ADDRSTRLEN);
+
+        if (ifp->ifa_netmask)
+            inet_ntop(AF_INET, &((struct sockaddr_in*)ifp->ifa_netmask)->sin_addr, out[i].mask, INET_ADDRSTRLEN);
+    }
+
+    freeifaddrs(ifa);
+
+    return n;
+}
+
+void wipi_shm_free(struct __wipi_shm_t* ws)
+{
+    if (ws == NULL)
+        return;
+
+    if (ws->map != MAP_FAILED && ws->map != NULL)
+        munmap(ws->map, ws->len);
+
+    if (ws->writer)
+    {
+        close(ws->fd);
+        shm_unlink(ws->name);
+    }
+
+    free(ws->snap);
+    free(ws->name);
+    free(ws);
+}
@@ -0,0 +1,188 @@
+/*    wipi_shm.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Shared memory AP/interface snapshots for WiPi.
+ * See wipi_shm.c for source definitions.
+ *
+ * One process (wipi-sensord) owns the radios and publishes each scan
+ * into a POSIX shared memory segment. Any number of readers map it
+ * read-only and copy out consistent snapshots without a syscall.
+ *
+ * The segment is a header followed by two buffers. The writer only
+ * ever fills the buffer readers are not pointed at, bracketing the
+ * write with an odd/even sequence number (a seqlock), then flips
+ * current to it. A reader checks the sequence is even and unchanged
+ * around its copy, so it only retries if the writer laps it twice.
+ *
+ * Records are position independent and the header carries the layout
+ * version and record sizes, so a reader built from different sources
+ * refuses the segment instead of misreading it.
+ *
+ * Each publish also encodes the AP and interface tables once, as the
+ * complete JSON and MessagePack API response bodies, so serving them
+ * is a copy however many clients ask.
+ *
+ * The publisher's scan cadence stats ride along in the buffer header
+ * so readers can report how it is scheduling scans, as does a copy of
+ * its library counters and histograms (wipi_stats_snapshot()), since
+ * the scans they time happen in its process. A sweep that
+ * failed outright republishes the last good one unchanged, with its
+ * original generation and timestamp, so only the stats move on and
+ * readers can tell from its age that the scans have stopped.
+ */
+
+#ifndef _WIPI_SHM_H_
+#define _WIPI_SHM_H_
+
+#ifndef _WIPI_H_
+    #include "wipi.h"
+#endif
+
+#ifndef _WIPI_ENC_H_
+    #include "wipi_enc.h"
+#endif
+
+#ifndef _WIPI_CADENCE_H_
+    #include "wipi_cadence.h"
+#endif
+
+/*    INCLUDES    */
+#include <net/if.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*    MACRO DEFS    */
+#define WIPI_SHM_NAME       "/wipi"
+#define WIPI_SHM_MAGIC      0x314D485349504957ULL   /* "WIPISHM1" */
+#define WIPI_SHM_VERSION    4
+#define WIPI_SHM_SIZE       (16 << 20)  /* data bytes per buffer */
+#define WIPI_SHM_RETRIES    64
+#define WIPI_SHM_RADIOS     8           /* WIPI_MAX_RADIOS */
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_SHM_APS,
+    WIPI_SHM_IFACES,
+    WIPI_SHM_APS_BODY,                                  /* one per WIPI_ENC */
+    WIPI_SHM_IFACES_BODY = WIPI_SHM_APS_BODY + WIPI_ENCS,
+    WIPI_SHM_SECTIONS = WIPI_SHM_IFACES_BODY + WIPI_ENCS
+} WIPI_SHM_SECTION;
+
+typedef struct __wipi_shm_ap_t
+{
+    char                    ssid[WIPI_MAX_SSID + 1];
+    char                    stats[WIPI_MAX_STATS];
+    uint8_t                 addr[WIPI_MAC_LEN];
+
+    uint16_t                freq_mhz;
+    uint8_t                 band;
+    int8_t                  db;
+    float                   qual;
+    int32_t                 channel;
+
+    struct __wipi_caps_t    caps;
+
+    uint8_t                 radio;
+    uint32_t                radios;
+    uint64_t                seen;
+
+    float                   airtime;
+    float                   utilization;
+} wipi_shm_ap_t;
+
+typedef struct __wipi_shm_if_t
+{
+    char        name[IFNAMSIZ];
+    char        addr[INET_ADDRSTRLEN];  /* AF_INET when it has one */
+    char        mask[INET_ADDRSTRLEN];
+    uint32_t    flags;
+    uint8_t     mon;
+} wipi_shm_if_t;
+
+typedef struct __wipi_shm_sect_t
+{
+    uint32_t    off;        /* from the start of the buffer data */
+    uint32_t    len;
+    uint32_t    count;
+} wipi_shm_sect_t;
+
+typedef struct __wipi_shm_buf_t
+{
+    uint64_t                        seq;        /* odd while being written */
+    uint64_t                        generation;
+    uint64_t                        published;  /* unix time, ns */
+    uint32_t                        used;
+
+    struct __wipi_cadence_stats_t   cadence;    /* publisher's scan scheduling */
+    struct __wipi_stats_t           stats;      /* and its counters, histograms */
+
+    struct __wipi_shm_sect_t        sections[WIPI_SHM_SECTIONS];
+} __attribute__((aligned(64))) wipi_shm_buf_t;
+
+typedef struct __wipi_shm_hdr_t
+{
+    uint64_t    magic;
+    uint32_t    version;
+    uint32_t    ap_size;
+    uint32_t    if_size;
+    uint32_t    buf_size;   /* buffer header + data */
+
+    int32_t     pid;        /* publisher */
+    uint32_t    current;    /* buffer readers should copy */
+
+    uint32_t    nradios;
+    char        radios[WIPI_SHM_RADIOS][IFNAMSIZ];
+} __attribute__((aligned(64))) wipi_shm_hdr_t;
+
+typedef struct __wipi_shm_t
+{
+    int                         fd;
+    char*                       name;
+    uint8_t*                    map;
+    size_t                      len;
+    uint8_t                     writer;
+
+    struct __wipi_shm_hdr_t*    hdr;
+    struct __wipi_shm_buf_t*    snap;   /* reader's private copy */
+    uint32_t                    from;   /* buffer it was copied from */
+
+    WIPI_STATUS                 status;
+} wipi_shm_t;
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_shm_t* wipi_shm_create(const char* __restrict__ name,
+                                     size_t size);
+
+int wipi_shm_publish(struct __wipi_shm_t* ws,
+                     struct __wipi_beacon_t* aps,
+                     const struct __wipi_shm_if_t* ifaces,
+                     int nifaces,
+                     const char** radios,
+                     int nradios,
+                     const struct __wipi_cadence_stats_t* cadence);
+
+int wipi_shm_republish(struct __wipi_shm_t* ws,
+                       const struct __wipi_cadence_stats_t* cadence);
+
+__wur
+struct __wipi_shm_t* wipi_shm_open(const char* __restrict__ name);
+
+const struct __wipi_shm_buf_t* wipi_shm_snapshot(struct __wipi_shm_t* ws);
+
+const void* wipi_shm_section(const struct __wipi_shm_buf_t* buf,
+                             WIPI_SHM_SECTION sect,
+                             uint32_t* count);
+
+int wipi_shm_interfaces(struct __wipi_shm_if_t* out,
+                        int max);
+
+void wipi_shm_free(struct __wipi_shm_t* ws);
+
+#endif
@@ -0,0 +1,149 @@
+/*    wipi_stats.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Hot-path instrumentation definitions for WiPi.
+ * See wipi_stats.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <pthread.h>
+
+#ifndef _WIPI_STATS_H_
+    #include "wipi_stats.h"
+#endif
+
+/*    TYPEDEFS    */
+typedef struct __wipi_stats_slot_t
+{
+    struct __wipi_stats_slot_t* next;
+
+    int                         in_use;
+
+    struct __wipi_stats_t       st;
+} wipi_stats_slot_t;
+
+/*    STATIC DEFS    */
+static struct __wipi_stats_slot_t*          wipi_stats_slots = NULL;
+static __thread struct __wipi_stats_slot_t* wipi_stats_tls   = NULL;
+
+static pthread_key_t    wipi_stats_key;
+static pthread_once_t   wipi_stats_once = PTHREAD_ONCE_INIT;
+
+/*    FUNCTION DEFINITIONS    */
+static void wipi_stats_release(void* p)
+{
+    /* Thread exited - hand the slot (and its totals) to the next thread */
+    __atomic_store_n(&((struct __wipi_stats_slot_t*)p)->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void wipi_stats_key_init(void)
+{
+    pthread_key_create(&wipi_stats_key, wipi_stats_release);
+}
+
+static struct __wipi_stats_slot_t* wipi_stats_slot(void)
+{
+    struct __wipi_stats_slot_t* s;
+    int                         expected;
+
+    if (wipi_stats_tls)
+        return wipi_stats_tls;
+
+    pthread_once(&wipi_stats_once, wipi_stats_key_init);
+
+    for (s = __atomic_load_n(&wipi_stats_slots, __ATOMIC_ACQUIRE); s; s = s->next)
+    {
+        expected = 0;
+
+        if (__atomic_compare_exchange_n(&s->in_use, &expected, 1, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            goto claimed;
+    }
+
+    s = (struct __wipi_stats_slot_t*)calloc( 1, sizeof(struct __wipi_stats_slot_t) );
+    assert(s != NULL);
+
+    s->in_use = 1;
+    s->next = __atomic_load_n(&wipi_stats_slots, __ATOMIC_RELAXED);
+
+    while (!__atomic_compare_exchange_n(&wipi_stats_slots, &s->next, s, 0,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        ;
+
+claimed:
+    pthread_setspecific(wipi_stats_key, s);
+    wipi_stats_tls = s;
+
+    return s;
+}
+
+static inline void wipi_stats_bump(uint64_t* p, uint64_t n)
+{
+    /* Single writer per slot, so no RMW needed - readers only see torn-free words */
+    __atomic_store_n(p, __atomic_load_n(p, __ATOMIC_RELAXED) + n, __ATOMIC_RELAXED);
+}
+
+void wipi_stats_add(WIPI_STAT_COUNTER c, uint64_t n)
+{
+    wipi_stats_bump(&wipi_stats_slot()->st.counters[c], n);
+}
+
+void wipi_stats_observe(WIPI_STAT_HIST h, uint64_t ns)
+{
+    struct __wipi_hist_t*   wh;
+    int                     b;
+
+    wh = &wipi_stats_slot()->st.hists[h];
+
+    /* Bounds are inclusive (le), so exactly 2^k ns is counted in bucket k */
+    b = ns <= (1ULL << WIPI_HIST_SHIFT) ? 0 : (64 - __builtin_clzll(ns - 1)) - WIPI_HIST_SHIFT;
+    b = b < WIPI_HIST_BUCKETS ? b : WIPI_HIST_BUCKETS - 1;
+
+    wipi_stats_bump(&wh->buckets[b], 1);
+    wipi_stats_bump(&wh->sum_ns, ns);
+    wipi_stats_bump(&wh->count, 1);
+}
+
+double wipi_stats_bucket_bound(int bucket)
+{
+    if (bucket >= WIPI_HIST_BUCKETS - 1)
+        return INFINITY;
+
+    return (double)(1ULL << (bucket + WIPI_HIST_SHIFT)) / 1000000000.0;
+}
+
+void wipi_stats_snapshot(struct __wipi_stats_t* st)
+{
+    struct __wipi_stats_slot_t* s;
+
+    assert(st != NULL);
+
+    memset( st, 0, sizeof(struct __wipi_stats_t) );
+
+    for (s = __atomic_load_n(&wipi_stats_slots, __ATOMIC_ACQUIRE); s; s = s->next)
+    {
+        for (int i = 0; i < WIPI_STAT_COUNTERS; i++)
+            st->counters[i] += __atomic_load_n(&s->st.counters[i], __ATOMIC_RELAXED);
+
+        for (int i = 0; i < WIPI_HISTS; i++)
+        {
+            for (int j = 0; j < WIPI_HIST_BUCKETS; j++)
+                st->hists[i].buckets[j] += __atomic_load_n(&s->st.hists[i].buckets[j], __ATOMIC_RELAXED);
+
+            st->hists[i].count  += __atomic_load_n(&s->st.hists[i].count, __ATOMIC_RELAXED);
+            st->hists[i].sum_ns += __atomic_load_n(&s->st.hists[i].sum_ns, __ATOMIC_RELAXED);
+        }
+    }
+}
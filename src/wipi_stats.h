@@ -0,0 +1,115 @@
+/*    wipi_stats.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Hot-path instrumentation for WiPi.
+ * See wipi_stats.c for source definitions.
+ *
+ * Every thread that records a stat claims its own slot, so
+ * the hot path is a plain relaxed load/store with no locked
+ * instructions. wipi_stats_snapshot() sums all slots.
+ */
+
+#ifndef _WIPI_STATS_H_
+#define _WIPI_STATS_H_
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+/*    MACRO DEFS    */
+#define WIPI_HIST_BUCKETS   28  /* log2 buckets, 256ns .. 17s, then +Inf */
+#define WIPI_HIST_SHIFT     8
+
+/*    TYPEDEFS    */
+typedef enum
+{
+    WIPI_STAT_SCANS,
+    WIPI_STAT_SCAN_ERRORS,
+    WIPI_STAT_SCAN_APS,
+    WIPI_STAT_CAP_FRAMES,
+    WIPI_STAT_CAP_DROPS,
+    WIPI_STAT_CAP_BYTES,
+    WIPI_STAT_PCAP_BYTES,
+    WIPI_STAT_PCAP_FILES,
+    WIPI_STAT_ALLOCS,
+    WIPI_STAT_ALLOC_BYTES,
+    WIPI_STAT_COUNTERS
+} WIPI_STAT_COUNTER;
+
+typedef enum
+{
+    WIPI_HIST_SCAN,
+    WIPI_HIST_PARSE,
+    WIPI_HIST_IFACE,
+    WIPI_HIST_QUERY,
+    WIPI_HISTS
+} WIPI_STAT_HIST;
+
+typedef struct __wipi_hist_t
+{
+    uint64_t    buckets[WIPI_HIST_BUCKETS];
+    uint64_t    count;
+    uint64_t    sum_ns;
+} wipi_hist_t;
+
+typedef struct __wipi_stats_t
+{
+    uint64_t    counters[WIPI_STAT_COUNTERS];
+
+    wipi_hist_t hists[WIPI_HISTS];
+} wipi_stats_t;
+
+/*    STATIC DEFS    */
+static const char* WIPI_STAT_NAMES[] = {
+    "scans_total",
+    "scan_errors_total",
+    "scan_aps_total",
+    "capture_frames_total",
+    "capture_drops_total",
+    "capture_bytes_total",
+    "pcap_written_bytes_total",
+    "pcap_files_total",
+    "allocations_total",
+    "allocation_bytes_total"
+};
+
+static const char* WIPI_HIST_NAMES[] = {
+    "scan_seconds",
+    "beacon_parse_seconds",
+    "interface_enum_seconds",
+    "ap_query_seconds"
+};
+
+/*    FUNCTION DECLS    */
+#define WIPI_ALLOC(sz) ( wipi_stats_add(WIPI_STAT_ALLOCS, 1), \
+                         wipi_stats_add(WIPI_STAT_ALLOC_BYTES, (sz)), \
+                         malloc(sz) )
+
+static inline uint64_t wipi_stats_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void wipi_stats_add(WIPI_STAT_COUNTER c, uint64_t n);
+
+void wipi_stats_observe(WIPI_STAT_HIST h, uint64_t ns);
+
+double wipi_stats_bucket_bound(int bucket);
+
+void wipi_stats_snapshot(struct __wipi_stats_t* st);
+
+#endif
@@ -0,0 +1,392 @@
+/*    wipi_timing.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Beacon timing analysis definitions for WiPi.
+ * See wipi_timing.h for source declarations.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#ifndef _WIPI_TIMING_H_
+    #include "wipi_timing.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_TIMING_USED    (1ULL << 63)
+
+/*    FUNCTION DEFINITIONS    */
+static struct __wipi_timing_bss_t* wipi_timing_slot(struct __wipi_timing_bss_t* bss,
+                                                    size_t cap,
+                                                    uint64_t key)
+{
+    size_t  i, mask;
+
+    mask = cap - 1;
+
+    for (i = wipi_mac_hash(key) & mask; bss[i].key && bss[i].key != key; i = (i + 1) & mask)
+        ;
+
+    return &bss[i];
+}
+
+static int wipi_timing_grow(struct __wipi_timing_t* wt)
+{
+    struct __wipi_timing_bss_t* bss;
+    size_t                      cap;
+
+    cap = wt->cap * 2;
+
+    if (cap > WIPI_TIMING_MAX || (bss = (struct __wipi_timing_bss_t*)calloc( cap, sizeof(struct __wipi_timing_bss_t) )) == NULL)
+        return -1;
+
+    wipi_stats_add(WIPI_STAT_ALLOCS, 1);
+
+    for (size_t i = 0; i < wt->cap; i++)
+    {
+        if (wt->bss[i].key)
+            *wipi_timing_slot(bss, cap, wt->bss[i].key) = wt->bss[i];
+    }
+
+    free(wt->bss);
+
+    wt->bss = bss;
+    wt->cap = cap;
+
+    return 0;
+}
+
+/* Empties slot i, shifting back any record that probed past it */
+static void wipi_timing_delete(struct __wipi_timing_t* wt, size_t i)
+{
+    size_t  j, home, mask;
+
+    mask = wt->cap - 1;
+
+    for (j = i;;)
+    {
+        wt->bss[i].key = 0;
+
+        do
+        {
+            j = (j + 1) & mask;
+
+            if (wt->bss[j].key == 0)
+            {
+                wt->nbss--;
+
+                return;
+            }
+
+            home = wipi_mac_hash(wt->bss[j].key) & mask;
+        } while (i <= j ? (i < home && home <= j) : (i < home || home <= j));
+
+        wt->bss[i] = wt->bss[j];
+        i = j;
+    }
+}
+
+static int wipi_timing_oldest(const void* a, const void* b)
+{
+    uint64_t    ra, rb;
+
+    ra = *(const uint64_t*)a;
+    rb = *(const uint64_t*)b;
+
+    return ra < rb ? -1 : ra > rb;
+}
+
+/* At the size cap, forget roughly the quarter of BSSIDs heard from longest
+ * ago. The cut off comes from a sample of capture times.
+ */
+static void wipi_timing_evict(struct __wipi_timing_t* wt)
+{
+    uint64_t    sample[WIPI_TIMING_SAMPLE], cutoff;
+    size_t      n, step;
+
+    step = wt->cap / WIPI_TIMING_SAMPLE;
+    n = 0;
+
+    for (size_t i = 0; i < wt->cap && n < WIPI_TIMING_SAMPLE; i += step ? step : 1)
+    {
+        for (size_t k = i; k < wt->cap && k < i + step; k++)
+        {
+            if (wt->bss[k].key)
+            {
+                sample[n++] = wt->bss[k].rx;
+                break;
+            }
+        }
+    }
+
+    if (n == 0)
+        return;
+
+    qsort(sample, n, sizeof(uint64_t), wipi_timing_oldest);
+    cutoff = sample[n / 4];
+
+    /* A deletion shifts a later record into slot i, so look at it again */
+    for (size_t i = 0; i < wt->cap;)
+    {
+        if (wt->bss[i].key && wt->bss[i].rx <= cutoff)
+        {
+            wipi_timing_delete(wt, i);
+            wt->evicted++;
+        }
+        else
+            i++;
+    }
+}
+
+/* Find or add the record for a BSSID, growing at 3/4 load up to the cap.
+ * NULL if it is new and there is no room even after evicting.
+ */
+static struct __wipi_timing_bss_t* wipi_timing_find(struct __wipi_timing_t* wt,
+                                                    const uint8_t* addr)
+{
+    struct __wipi_timing_bss_t* b;
+    uint64_t                    key;
+
+    key = wipi_mac_key(addr) | WIPI_TIMING_USED;
+    b = wipi_timing_slot(wt->bss, wt->cap, key);
+
+    if (b->key)
+        return b;
+
+    if ((wt->nbss + 1) * 4 > wt->cap * 3 && wipi_timing_grow(wt) < 0)
+    {
+        wipi_timing_evict(wt);
+
+        if ((wt->nbss + 1) * 4 > wt->cap * 3)
+            return NULL;
+    }
+
+    b = wipi_timing_slot(wt->bss, wt->cap, key);
+
+    if (b->key == 0)
+    {
+        b->key = key;
+        wt->nbss++;
+    }
+
+    return b;
+}
+
+__wur
+struct __wipi_timing_t* wipi_timing_init(void)
+{
+    struct __wipi_timing_t* wt;
+
+    wt = (struct __wipi_timing_t*)WIPI_ALLOC( sizeof(struct __wipi_timing_t) );
+    assert(wt != NULL);
+
+    memset( wt, 0, sizeof(struct __wipi_timing_t) );
+
+    wt->cap = WIPI_TIMING_MIN;
+    wt->bss = (struct __wipi_timing_bss_t*)calloc( wt->cap, sizeof(struct __wipi_timing_bss_t) );
+    assert(wt->bss != NULL);
+
+    pthread_mutex_init(&wt->lock, NULL);
+
+    return wt;
+}
+
+/* The name a hidden network answers probes with */
+static void wipi_timing_probe_resp(struct __wipi_timing_t* wt,
+                                   struct __wipi_timing_bss_t* b,
+                                   const struct __wipi_beacon_t* wb)
+{
+    wt->probe_resps++;
+
+    if (wb->ssid[0] == '\0')
+        return;
+
+    if (b->hidden && !b->resolved)
+        wt->resolved++;
+
+    memcpy(b->ssid, wb->ssid, WIPI_MAX_SSID);
+    b->resolved = b->hidden;
+}
+
+static int wipi_timing_tick(struct __wipi_timing_t* wt,
+                            struct __wipi_timing_bss_t* b,
+                            const struct __wipi_beacon_t* wb,
+                            uint16_t seq,
+                            uint64_t ts_ns)
+{
+    int64_t     offset, jump;
+    uint64_t    period, gap;
+    int         raised;
+
+    wt->beacons++;
+    raised = 0;
+
+    if (wb->ssid[0])
+    {
+        memcpy(b->ssid, wb->ssid, WIPI_MAX_SSID);
+        b->hidden = b->resolved = 0;
+    }
+    else
+    {
+        /* A probe response may have named it already */
+        if (!b->hidden && b->ssid[0])
+            wt->resolved++;
+
+        b->hidden = 1;
+        b->resolved = b->ssid[0] != '\0';
+    }
+
+    offset = (int64_t)wb->tsf - (int64_t)(ts_ns / 1000);
+
+    if (b->beacons)
+    {
+        /* A retransmission of the last beacon says nothing new */
+        if (seq == b->seq && wb->tsf == b->tsf)
+            return 0;
+
+        jump = offset - b->offset;
+
+        if (jump > WIPI_TIMING_SLACK || jump < -WIPI_TIMING_SLACK)
+        {
+            jump = offset - b->prev_offset;
+
+            /* Back on the clock it had before the last reset, two APs claim this BSSID */
+            if (b->reset_at && jump <= WIPI_TIMING_SLACK && jump >= -WIPI_TIMING_SLACK)
+            {
+                b->clashes++;
+                wt->clashes++;
+            }
+            else
+            {
+                b->resets++;
+                wt->resets++;
+            }
+
+            b->prev_offset = b->offset;
+            b->reset_at = ts_ns;
+            raised++;
+        }
+        else if (wb->tsf > b->tsf && wb->beacon_int)
+        {
+            /* Nearest whole number of intervals between the two, any past one went missing */
+            period = (uint64_t)wb->beacon_int * WIPI_TIMING_TU;
+            gap = (wb->tsf - b->tsf + period / 2) / period;
+
+            if (gap > 1)
+                b->missed += gap - 1;
+        }
+    }
+
+    b->tsf = wb->tsf;
+    b->rx = ts_ns;
+    b->offset = offset;
+    b->beacon_int = wb->beacon_int;
+    b->seq = seq;
+    b->beacons++;
+
+    return raised;
+}
+
+int wipi_timing_update(struct __wipi_timing_t* wt,
+                       const struct __wipi_frame_t* f,
+                       uint64_t ts_ns)
+{
+    struct __wipi_timing_bss_t* b;
+    wipi_beacon_t               wb;
+    int                         raised;
+
+    assert(wt != NULL && f != NULL);
+
+    if (wipi_frame_beacon(f, &wb) < 0)
+        return 0;
+
+    raised = 0;
+
+    pthread_mutex_lock(&wt->lock);
+
+    if ((b = wipi_timing_find(wt, wb.addr)) == NULL)
+        ;
+    else if (WIPI_FC_SUBTYPE(f->fc) == WIPI_ST_PROBE_RESP)
+        wipi_timing_probe_resp(wt, b, &wb);
+    else
+        raised = wipi_timing_tick(wt, b, &wb, f->seq, ts_ns);
+
+    pthread_mutex_unlock(&wt->lock);
+
+    return raised;
+}
+
+void wipi_timing_frame(void* ctx,
+                       const struct __wipi_frame_t* f,
+                       uint64_t ts_ns)
+{
+    wipi_timing_update((struct __wipi_timing_t*)ctx, f, ts_ns);
+}
+
+int wipi_timing_bss(struct __wipi_timing_t* wt,
+                    struct __wipi_timing_bss_t* out,
+                    int max)
+{
+    int n;
+
+    pthread_mutex_lock(&wt->lock);
+
+    /* Probe responses alone leave a record with no timing in it */
+    for (size_t i = n = 0; i < wt->cap && n < max; i++)
+    {
+        if (wt->bss[i].key && wt->bss[i].beacons)
+            out[n++] = wt->bss[i];
+    }
+
+    pthread_mutex_unlock(&wt->lock);
+
+    return n;
+}
+
+int wipi_timing_beacon(struct __wipi_timing_t* wt,
+                       struct __wipi_beacon_t* wb)
+{
+    struct __wipi_timing_bss_t* b;
+    int                         found;
+
+    assert(wt != NULL && wb != NULL);
+
+    pthread_mutex_lock(&wt->lock);
+
+    b = wipi_timing_slot(wt->bss, wt->cap, wipi_mac_key(wb->addr) | WIPI_TIMING_USED);
+    found = b->key != 0;
+
+    if (found)
+    {
+        if (wb->ssid[0] == '\0')
+            memcpy(wb->ssid, b->ssid, WIPI_MAX_SSID);
+
+        if (b->beacons)
+        {
+            wb->tsf = b->tsf;
+            wb->beacon_int = b->beacon_int;
+        }
+    }
+
+    pthread_mutex_unlock(&wt->lock);
+
+    return found ? 0 : -1;
+}
+
+void wipi_timing_free(struct __wipi_timing_t* wt)
+{
+    if (wt == NULL)
+        return;
+
+    pthread_mutex_destroy(&wt->lock);
+
+    free(wt->bss);
+    free(wt);
+}
@@ -0,0 +1,111 @@
+/*    wipi_timing.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Beacon timing analysis and hidden SSID resolution for WiPi.
+ * See wipi_timing.c for source definitions.
+ *
+ * Every captured beacon carries the AP's TSF timer (microseconds
+ * since it came up), its beacon interval and a sequence number. Per
+ * BSSID this keeps the last of each plus the TSF's offset from the
+ * capture clock, in an open addressing hash table, so each beacon is
+ * a constant time update. The table stops growing at WIPI_TIMING_MAX
+ * slots, then about a quarter of it, the BSSIDs heard from longest
+ * ago, is forgotten to make room:
+ *
+ *   uptime  - the TSF, carried forward from the last beacon
+ *   missed  - TSF gaps longer than one beacon interval, a measure of
+ *             how lossy the link to the AP is
+ *   resets  - the offset jumping by more than the slack, the AP was
+ *             restarted or its timer was changed
+ *   clashes - a jump back to the offset held before the last reset,
+ *             two transmitters with different clocks are sharing
+ *             the BSSID (one of them is spoofing it)
+ *
+ * Beacons with an empty SSID are hidden networks. A probe response
+ * from the same BSSID answers with the real name, which is kept so
+ * scan results can be filled in (see wipi_timing_beacon()).
+ */
+
+#ifndef _WIPI_TIMING_H_
+#define _WIPI_TIMING_H_
+
+#ifndef _WIPI_FRAME_H_
+    #include "wipi_frame.h"
+#endif
+
+/*    INCLUDES    */
+#include <pthread.h>
+
+/*    MACRO DEFS    */
+#define WIPI_TIMING_MIN     256
+#define WIPI_TIMING_MAX     65536       /* BSSID slots, power of 2             */
+#define WIPI_TIMING_SAMPLE  64          /* ages sampled to pick what to evict  */
+#define WIPI_TIMING_TU      1024        /* us per time unit                    */
+#define WIPI_TIMING_SLACK   50000       /* us the TSF offset may move per beacon */
+
+/*    TYPEDEFS    */
+typedef struct __wipi_timing_bss_t
+{
+    uint64_t    key;            /* mac key | WIPI_TIMING_USED, 0 = empty */
+    char        ssid[WIPI_MAX_SSID];    /* as broadcast, or resolved */
+
+    uint64_t    tsf;            /* last beacon, us              */
+    uint64_t    rx;             /* when it was captured, ns     */
+    int64_t     offset;         /* tsf - rx, us                 */
+    int64_t     prev_offset;    /* before the last reset        */
+    uint16_t    beacon_int;     /* TU                           */
+    uint16_t    seq;
+
+    uint64_t    beacons;
+    uint64_t    missed;
+    uint32_t    resets;
+    uint32_t    clashes;
+    uint64_t    reset_at;       /* ns, 0 if never */
+
+    uint8_t     hidden;         /* beacons carry no SSID        */
+    uint8_t     resolved;       /* and a probe response gave it */
+} wipi_timing_bss_t;
+
+typedef struct __wipi_timing_t
+{
+    struct __wipi_timing_bss_t* bss;
+    size_t                      nbss;
+    size_t                      cap;        /* power of 2 */
+    uint64_t                    evicted;
+
+    uint64_t                    beacons;
+    uint64_t                    probe_resps;
+    uint64_t                    resolved;
+    uint64_t                    resets;
+    uint64_t                    clashes;
+
+    pthread_mutex_t             lock;
+} wipi_timing_t;
+
+/*    FUNCTION DECLS    */
+__wur
+struct __wipi_timing_t* wipi_timing_init(void);
+
+int wipi_timing_update(struct __wipi_timing_t* wt,
+                       const struct __wipi_frame_t* f,
+                       uint64_t ts_ns);
+
+void wipi_timing_frame(void* ctx,
+                       const struct __wipi_frame_t* f,
+                       uint64_t ts_ns);
+
+int wipi_timing_bss(struct __wipi_timing_t* wt,
+                    struct __wipi_timing_bss_t* out,
+                    int max);
+
+int wipi_timing_beacon(struct __wipi_timing_t* wt,
+                       struct __wipi_beacon_t* wb);
+
+void wipi_timing_free(struct __wipi_timing_t* wt);
+
+#endif
@@ -0,0 +1,105 @@
+/*    bench_flood.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Deauth/disassoc flood detector replay benchmark for WiPi.
+ *
+ * Writes a synthetic radiotap capture - 40% deauth or disassoc frames
+ * from 256 spoofed sources against 4 BSSIDs, the rest beacons from 64
+ * APs, 10us apart - and times wipi_capture_replay() through the flood
+ * hook. The file is replayed once to warm the page cache first.
+ *
+ *   bench_flood [frames]   (default 2000000)
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_FLOOD_H_
+    #include "wipi_flood.h"
+#endif
+
+/*    FUNCTION DEFINITIONS    */
+int main(int argc, char** argv)
+{
+    struct __wipi_flood_t*  wd;
+    wipi_capture_hook_t     hook;
+    FILE*                   fp;
+    char                    path[64];
+    uint8_t                 pkt[WIPI_TEST_FRAME_MAX], body[64], dst[WIPI_MAC_LEN], src[WIPI_MAC_LEN], bssid[WIPI_MAC_LEN];
+    uint64_t                start, elapsed;
+    size_t                  len, n;
+    long                    frames;
+
+    frames = argc > 1 ? atol(argv[1]) : 2000000;
+
+    if ((fp = wipi_test_pcap_open(path, sizeof(path))) == NULL)
+    {
+        perror("pcap");
+
+        return 1;
+    }
+
+    wipi_test_mac(dst, 0xFFFFFF);
+
+    for (long i = 0; i < frames; i++)
+    {
+        if (i % 5 < 2)
+        {
+            wipi_test_mac(bssid, (uint32_t)(i % 4));
+            wipi_test_mac(src, 0x1000 + (uint32_t)(i % 256));
+
+            body[0] = 7;    /* class 3 frame from nonassociated STA */
+            body[1] = 0;
+
+            len = wipi_test_mgmt(pkt, i % 2 ? WIPI_ST_DEAUTH : WIPI_ST_DISASSOC, dst, src, bssid, (uint16_t)i, body, 2);
+        }
+        else
+        {
+            wipi_test_mac(bssid, 0x100 + (uint32_t)(i % 64));
+
+            n = wipi_test_beacon_body(body, (uint64_t)i * 10, 100, "bench");
+            len = wipi_test_mgmt(pkt, WIPI_ST_BEACON, dst, bssid, bssid, (uint16_t)i, body, n);
+        }
+
+        wipi_test_pcap_frame(fp, 1000000000ULL + (uint64_t)i * 10000, pkt, len);
+    }
+
+    fclose(fp);
+
+    wd = wipi_flood_init(0, 0, 0);
+
+    hook.fn = wipi_flood_frame;
+    hook.ctx = wd;
+
+    wipi_capture_replay(path, &hook, 1);
+
+    wipi_flood_free(wd);
+    wd = wipi_flood_init(0, 0, 0);
+    hook.ctx = wd;
+
+    start = wipi_stats_now();
+    frames = wipi_capture_replay(path, &hook, 1);
+    elapsed = wipi_stats_now() - start;
+
+    printf("%ld frames in %.3fs, %.2fM frames/s, %llu deauth, %llu disassoc, %llu alerts\n",
+           frames,
+           elapsed / 1e9,
+           elapsed ? frames * 1e3 / (double)elapsed : 0.0,
+           (unsigned long long)wd->deauths,
+           (unsigned long long)wd->disassocs,
+           (unsigned long long)(wd->next_id - 1));
+
+    wipi_flood_free(wd);
+    unlink(path);
+
+    return frames < 0;
+}
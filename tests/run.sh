@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# Builds and runs the behaviour tests against the library sources, with
+# the same libraries as build.sh. Pass --bench to run the benchmarks too.
+
+cd "$(dirname "$0")"
+
+shopt -s nullglob
+
+SRCS=$(ls ../src/*.c | grep -v wipi_sensord.c)
+FAILED=0
+
+mkdir -p bin
+
+# Generated by setup.py, an empty table is enough here
+[ -f ../src/wipi_oui_db.h ] || python3 ../src/wipi_oui_gen.py -o ../src/wipi_oui_db.h
+
+for t in test_*.c $([ "$1" == "--bench" ] && ls bench_*.c); do
+	if ! gcc -O2 -I../src -o bin/${t%.c} $t $SRCS -liw -lpthread -lm -lrt; then
+		echo "${t%.c}: build failed"
+		FAILED=1
+		continue
+	fi
+
+	./bin/${t%.c} || FAILED=1
+done
+
+exit $FAILED
@@ -0,0 +1,166 @@
+/*    test_airtime.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Airtime estimator tests for WiPi.
+ *
+ * Feeds beacons straight to wipi_airtime_update() to check the per
+ * BSSID slots are given back, whether their BSSIDs go quiet or more
+ * turn up than the table holds, and that the windows empty out when
+ * a channel does.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_AIRTIME_H_
+    #include "wipi_airtime.h"
+#endif
+
+/*    MACRO DEFS    */
+#define TEST_SEC    1000000000ULL
+
+/*    FUNCTION DEFINITIONS    */
+static void test_update(struct __wipi_airtime_t* wa, uint32_t id, uint64_t ts_ns)
+{
+    wipi_frame_t    f;
+    uint8_t         pkt[WIPI_TEST_FRAME_MAX], body[64], dst[WIPI_MAC_LEN], bssid[WIPI_MAC_LEN];
+    size_t          n, len;
+
+    wipi_test_mac(dst, 0xFFFFFF);
+    wipi_test_mac(bssid, id);
+
+    n = wipi_test_beacon_body(body, ts_ns / 1000, 100, "airtime");
+    len = wipi_test_mgmt(pkt, WIPI_ST_BEACON, dst, bssid, bssid, 0, body, n);
+
+    wipi_test_freq(pkt, 2412);
+
+    if (wipi_frame_parse(&f, pkt, len) == 0)
+        wipi_airtime_update(wa, &f, ts_ns);
+}
+
+/* Whether a BSS report names the BSSID */
+static int test_tracked(struct __wipi_airtime_t* wa, uint32_t id)
+{
+    wipi_airtime_report_t   reports[WIPI_AIRTIME_BSS];
+    uint8_t                 addr[WIPI_MAC_LEN];
+    int                     n;
+
+    wipi_test_mac(addr, id);
+    n = wipi_airtime_bss(wa, reports, WIPI_AIRTIME_BSS);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (memcmp(reports[i].addr, addr, WIPI_MAC_LEN) == 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+static void test_aging(void)
+{
+    struct __wipi_airtime_t*    wa;
+    uint64_t                    t;
+
+    wa = wipi_airtime_init();
+
+    /* 1 beacons for a minute then goes quiet, 2 carries on */
+    for (t = 1; t <= 60; t++)
+    {
+        test_update(wa, 1, t * TEST_SEC);
+        test_update(wa, 2, t * TEST_SEC);
+    }
+
+    WIPI_CHECK(wa->nbss == 2 && test_tracked(wa, 1) && test_tracked(wa, 2));
+
+    for (; t <= 60 + WIPI_AIRTIME_BSS_AGE + 1; t++)
+        test_update(wa, 2, t * TEST_SEC);
+
+    WIPI_CHECK(wa->nbss == 1 && wa->evicted == 1);
+    WIPI_CHECK(!test_tracked(wa, 1) && test_tracked(wa, 2));
+
+    /* Back again it starts from nothing, none of its old airtime */
+    test_update(wa, 1, t * TEST_SEC);
+    test_update(wa, 2, ++t * TEST_SEC);
+
+    WIPI_CHECK(wa->nbss == 2 && test_tracked(wa, 1));
+
+    wipi_airtime_free(wa);
+}
+
+static void test_eviction(void)
+{
+    struct __wipi_airtime_t*    wa;
+    uint64_t                    untracked;
+
+    wa = wipi_airtime_init();
+
+    /* Four times what the table holds, a new BSSID every 10ms */
+    for (uint32_t i = 0; i < 4 * WIPI_AIRTIME_BSS; i++)
+        test_update(wa, i, TEST_SEC + i * (TEST_SEC / 100));
+
+    WIPI_CHECK(wa->evicted > 0);
+    WIPI_CHECK(wa->nbss > 0 && wa->nbss <= WIPI_AIRTIME_BSS);
+
+    /* Once rolled the table is back under 3/4, the newest still in it */
+    test_update(wa, 4 * WIPI_AIRTIME_BSS - 1, 100 * TEST_SEC);
+
+    WIPI_CHECK(wa->nbss * 4 <= WIPI_AIRTIME_BSS * 3);
+    WIPI_CHECK(test_tracked(wa, 4 * WIPI_AIRTIME_BSS - 1));
+
+    /* And there is room for more */
+    untracked = wa->untracked;
+
+    for (uint32_t i = 0; i < WIPI_AIRTIME_BSS / 8; i++)
+        test_update(wa, 0x10000 + i, 100 * TEST_SEC + i);
+
+    WIPI_CHECK(wa->untracked == untracked);
+    WIPI_CHECK(test_tracked(wa, 0x10000) && test_tracked(wa, 0x10000 + WIPI_AIRTIME_BSS / 8 - 1));
+
+    wipi_airtime_free(wa);
+}
+
+static void test_quiet(void)
+{
+    struct __wipi_airtime_t*    wa;
+    wipi_airtime_report_t       r;
+
+    wa = wipi_airtime_init();
+
+    /* Ten beacons a second for half a minute */
+    for (uint64_t i = 0; i < 300; i++)
+        test_update(wa, 1, TEST_SEC + i * (TEST_SEC / 10));
+
+    WIPI_CHECK(wipi_airtime_channels(wa, &r, 1) == 1 && r.busy[0] > 0 && r.busy[1] > 0);
+
+    /* Five seconds pass with nothing heard, the 1s window empties */
+    wa->rolled -= 5 * TEST_SEC;
+
+    WIPI_CHECK(wipi_airtime_channels(wa, &r, 1) == 1 && r.busy[0] == 0 && r.busy[1] > 0 && r.busy[2] > 0);
+
+    /* And a minute on, all of them */
+    wa->rolled -= 60 * TEST_SEC;
+
+    WIPI_CHECK(wipi_airtime_bss(wa, &r, 1) == 1 && r.busy[0] == 0 && r.busy[1] == 0 && r.busy[2] == 0);
+    WIPI_CHECK(wipi_airtime_channels(wa, &r, 1) == 1 && r.busy[2] == 0 && r.frames == 300);
+
+    wipi_airtime_free(wa);
+}
+
+int main(void)
+{
+    test_aging();
+    test_eviction();
+    test_quiet();
+
+    return wipi_test_done("test_airtime");
+}
@@ -0,0 +1,299 @@
+/*    test_aptable.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* AP table query tests for WiPi.
+ *
+ * Random tables are queried through wipi_aptable_query() and every
+ * answer is compared with a plain filter and sort over the records,
+ * so the indexes can never disagree with what they stand for.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_APTABLE_H_
+    #include "wipi_aptable.h"
+#endif
+
+/*    MACRO DEFS    */
+#define TEST_APS        700     /* over a few bitmap words, not a multiple of 64 */
+#define TEST_QUERIES    4000
+
+/*    STATIC DEFS    */
+static const char* TEST_SSIDS[] = { "home", "home-5g", "cafe", "corp", "", "hotel" };
+
+static struct __wipi_aptable_t* test_table;
+static int                      test_sort;
+
+/*    FUNCTION DEFINITIONS    */
+static void test_random_ap(wipi_beacon_t* wb, uint32_t id)
+{
+    memset( wb, 0, sizeof(wipi_beacon_t) );
+
+    wipi_test_mac(wb->addr, id);
+    snprintf(wb->ssid, WIPI_MAX_SSID, "%s%s", TEST_SSIDS[rand() % 6], rand() % 2 ? "" : "-x");
+
+    wb->band = WIPI_BAND_2G + rand() % 3;
+    wb->channel = wb->band == WIPI_BAND_2G ? 1 + rand() % 13 : 36 + 4 * (rand() % 8);
+    wb->db = (int8_t)(-90 + rand() % 60);
+    wb->caps.security = rand() % 7;
+    wb->radios = 1 + rand() % 7;
+}
+
+static void test_random_query(wipi_query_t* q)
+{
+    memset( q, 0, sizeof(wipi_query_t) );
+
+    q->min_db = INT8_MIN;
+
+    if (rand() % 3 == 0)
+    {
+        q->ssid = TEST_SSIDS[rand() % 6];
+        q->substring = rand() % 2;
+    }
+
+    if (rand() % 4 == 0)
+    {
+        /* Ids are below 0x300, so short prefixes match many */
+        q->bssid = wipi_mac_key((uint8_t[WIPI_MAC_LEN]){ 0x02, 0, 0, 0, (uint8_t)(rand() % 3), (uint8_t)rand() });
+        q->bssid_bits = 24 + rand() % 25;
+    }
+
+    if (rand() % 3 == 0)
+        q->bands = (uint8_t)(rand() % 16);
+
+    if (rand() % 3 == 0)
+        q->security = (uint8_t)(rand() % 128);
+
+    if (rand() % 4 == 0)
+        q->channel = rand() % 3 ? 1 + rand() % 13 : 36 + 4 * (rand() % 10);
+
+    if (rand() % 3 == 0)
+        q->min_db = -90 + rand() % 60;
+
+    if (rand() % 4 == 0)
+        q->radios = 1 + rand() % 7;
+
+    q->sort = (WIPI_SORT)(rand() % WIPI_SORTS);
+    q->desc = rand() % 2;
+    q->offset = rand() % 2 ? 0 : (size_t)(rand() % 200);
+    q->limit = rand() % 2 ? 0 : (size_t)(1 + rand() % 50);
+}
+
+static int test_match(const wipi_beacon_t* ap, const wipi_query_t* q)
+{
+    size_t  len;
+    int     shift;
+
+    if (q->ssid && q->ssid[0])
+    {
+        len = strlen(q->ssid);
+
+        if (q->substring ? memmem(ap->ssid, strnlen(ap->ssid, WIPI_MAX_SSID), q->ssid, len) == NULL : strncmp(ap->ssid, q->ssid, len) != 0)
+            return 0;
+    }
+
+    shift = 48 - q->bssid_bits;
+
+    if (q->bssid_bits && wipi_mac_key(ap->addr) >> shift != (q->bssid & 0xFFFFFFFFFFFFULL) >> shift)
+        return 0;
+
+    return (!q->bands || (q->bands & (1 << ap->band))) &&
+           (!q->security || (q->security & (1 << ap->caps.security))) &&
+           (!q->channel || ap->channel == q->channel) &&
+           ap->db >= q->min_db &&
+           (!q->radios || (ap->radios & q->radios));
+}
+
+/* The order the indexes promise, table order breaking ties */
+static int test_cmp(const void* a, const void* b)
+{
+    const wipi_beacon_t*    x, *y;
+    uint32_t                i, j;
+    int64_t                 d;
+
+    i = *(const uint32_t*)a;
+    j = *(const uint32_t*)b;
+    x = &test_table->aps[i];
+    y = &test_table->aps[j];
+
+    switch (test_sort)
+    {
+        case WIPI_SORT_SSID:
+            d = strcmp(x->ssid, y->ssid);
+            break;
+        case WIPI_SORT_BSSID:
+            d = (int64_t)wipi_mac_key(x->addr) - (int64_t)wipi_mac_key(y->addr);
+            break;
+        case WIPI_SORT_DB:
+            d = x->db - y->db;
+            break;
+        case WIPI_SORT_CHANNEL:
+            d = x->band != y->band ? x->band - y->band : x->channel - y->channel;
+            break;
+        default:
+            d = 0;
+    }
+
+    return d ? (d > 0) - (d < 0) : (i > j) - (i < j);
+}
+
+static int test_query(struct __wipi_aptable_t* t, const wipi_query_t* q)
+{
+    uint32_t    want[TEST_APS], got[TEST_APS], tmp;
+    size_t      n, total, from, to;
+    int         ngot;
+
+    n = 0;
+
+    for (uint32_t i = 0; i < t->count; i++)
+    {
+        if (test_match(&t->aps[i], q))
+            want[n++] = i;
+    }
+
+    test_table = t;
+    test_sort = q->sort;
+
+    qsort(want, n, sizeof(uint32_t), test_cmp);
+
+    if (q->desc)
+    {
+        for (size_t i = 0; i < n / 2; i++)
+        {
+            tmp = want[i];
+            want[i] = want[n - 1 - i];
+            want[n - 1 - i] = tmp;
+        }
+    }
+
+    from = q->offset < n ? q->offset : n;
+    to = q->limit && from + q->limit < n ? from + q->limit : n;
+
+    ngot = wipi_aptable_query(t, q, got, TEST_APS, &total);
+
+    return ngot >= 0 && total == n && (size_t)ngot == to - from &&
+           memcmp(got, want + from, (to - from) * sizeof(uint32_t)) == 0;
+}
+
+static void test_random(void)
+{
+    struct __wipi_aptable_t*    t;
+    wipi_beacon_t               wb;
+    wipi_query_t                q;
+    int                         failed;
+
+    srand(30038);
+
+    t = wipi_aptable_init(0);
+
+    for (uint32_t i = 0; i < TEST_APS / 2; i++)
+    {
+        test_random_ap(&wb, (uint32_t)rand() % 0x300);
+        wipi_aptable_merge(t, &wb, WIPI_MERGE_RECENT);
+    }
+
+    failed = 0;
+
+    for (int i = 0; i < TEST_QUERIES; i++)
+    {
+        /* Change the table now and then, the indexes must follow */
+        if (i == TEST_QUERIES / 2)
+        {
+            for (uint32_t k = 0; k < TEST_APS / 2; k++)
+            {
+                test_random_ap(&wb, (uint32_t)rand() % 0x300);
+                wipi_aptable_merge(t, &wb, WIPI_MERGE_RECENT);
+            }
+        }
+
+        test_random_query(&q);
+
+        if (!test_query(t, &q))
+            failed++;
+    }
+
+    WIPI_CHECK(t->count > TEST_APS / 4 && t->count < TEST_APS);
+    WIPI_CHECK(failed == 0);
+
+    wipi_aptable_free(t);
+}
+
+static void test_edges(void)
+{
+    struct __wipi_aptable_t*    t;
+    wipi_beacon_t               wb;
+    wipi_query_t                q;
+    uint32_t                    out[4];
+    size_t                      total;
+
+    t = wipi_aptable_init(0);
+
+    memset( &q, 0, sizeof(wipi_query_t) );
+    q.min_db = INT8_MIN;
+
+    /* Empty */
+    WIPI_CHECK(wipi_aptable_query(t, &q, out, 4, &total) == 0 && total == 0);
+
+    test_random_ap(&wb, 1);
+    wipi_aptable_merge(t, &wb, WIPI_MERGE_RECENT);
+
+    /* A channel nobody is on, or out of range */
+    q.channel = 200;
+    WIPI_CHECK(wipi_aptable_query(t, &q, out, 4, &total) == 0 && total == 0);
+
+    q.channel = -1;
+    WIPI_CHECK(wipi_aptable_query(t, &q, out, 4, &total) == 0 && total == 0);
+
+    /* Bad sort or prefix length */
+    q.channel = 0;
+    q.sort = WIPI_SORTS;
+    WIPI_CHECK(wipi_aptable_query(t, &q, out, 4, &total) < 0);
+
+    q.sort = WIPI_SORT_NONE;
+    q.bssid_bits = 49;
+    WIPI_CHECK(wipi_aptable_query(t, &q, out, 4, &total) < 0);
+
+    /* A full 48 bit prefix is an exact match */
+    q.bssid = wipi_mac_key(wb.addr);
+    q.bssid_bits = 48;
+    WIPI_CHECK(wipi_aptable_query(t, &q, out, 4, &total) == 1 && total == 1 && out[0] == 0);
+
+    /* A page past the last match is empty, the total is not */
+    q.bssid_bits = 0;
+    q.offset = 1;
+    WIPI_CHECK(wipi_aptable_query(t, &q, out, 4, &total) == 0 && total == 1);
+
+    /* A full 32 byte SSID has no NUL, a match may end on its last byte but not past it */
+    test_random_ap(&wb, 2);
+    memcpy(wb.ssid, "0123456789abcdef0123456789abcdef", WIPI_MAX_SSID);
+    snprintf(wb.bssid, WIPI_MAX_BSSID, "02:00:00:00:00:02");
+    wipi_aptable_merge(t, &wb, WIPI_MERGE_RECENT);
+
+    q.offset = 0;
+    q.substring = 1;
+    q.ssid = "cdef";
+    WIPI_CHECK(wipi_aptable_query(t, &q, out, 4, &total) == 1 && total == 1 && out[0] == 1);
+
+    q.ssid = "cdef02";
+    WIPI_CHECK(wipi_aptable_query(t, &q, out, 4, &total) == 0 && total == 0);
+
+    wipi_aptable_free(t);
+}
+
+int main(void)
+{
+    test_random();
+    test_edges();
+
+    return wipi_test_done("test_aptable");
+}
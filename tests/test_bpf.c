@@ -0,0 +1,90 @@
+/*    test_bpf.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Monitor socket filter tests for WiPi.
+ *
+ * A compiled program is attached to one end of a datagram socket
+ * pair, so the kernel runs it on radiotap packets sent from the other
+ * end exactly as it would on a monitor socket.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_BPF_H_
+    #include "wipi_bpf.h"
+#endif
+
+#include <sys/socket.h>
+
+/*    FUNCTION DEFINITIONS    */
+/* Whether a frame of this type and subtype from the BSSID gets through */
+static int test_passes(const char* expr, uint8_t type, uint8_t subtype, uint32_t bssid_id)
+{
+    wipi_bpf_t  bpf;
+    uint8_t     pkt[WIPI_TEST_FRAME_MAX], body[1], dst[WIPI_MAC_LEN], bssid[WIPI_MAC_LEN];
+    size_t      len;
+    int         sv[2], passed;
+
+    if (wipi_bpf_compile(&bpf, expr) < 0 || socketpair(AF_UNIX, SOCK_DGRAM, 0, sv) < 0)
+        return -1;
+
+    wipi_test_mac(dst, 0xFFFFFF);
+    wipi_test_mac(bssid, bssid_id);
+
+    len = wipi_test_mgmt(pkt, subtype, dst, bssid, bssid, 0, body, 0);
+    pkt[WIPI_TEST_RT_LEN] = (uint8_t)(type << 2 | subtype << 4);
+
+    passed = -1;
+
+    if (wipi_bpf_attach(sv[1], &bpf) == 0 && send(sv[0], pkt, len, 0) == (ssize_t)len)
+        passed = recv(sv[1], pkt, sizeof(pkt), MSG_DONTWAIT) == (ssize_t)len;
+
+    close(sv[0]);
+    close(sv[1]);
+
+    return passed;
+}
+
+static void test_kinds(void)
+{
+    wipi_bpf_t  bpf;
+
+    /* Empty, everything */
+    WIPI_CHECK(test_passes("", WIPI_FT_DATA, 0, 1) == 1);
+
+    /* Types and subtypes are OR'd together */
+    WIPI_CHECK(test_passes("data beacon", WIPI_FT_DATA, 0, 1) == 1);
+    WIPI_CHECK(test_passes("data beacon", WIPI_FT_MGMT, WIPI_ST_BEACON, 1) == 1);
+    WIPI_CHECK(test_passes("data beacon", WIPI_FT_MGMT, WIPI_ST_PROBE_RESP, 1) == 0);
+    WIPI_CHECK(test_passes("data beacon", WIPI_FT_CTRL, 0, 1) == 0);
+
+    /* A subtype under its own type adds nothing */
+    WIPI_CHECK(test_passes("mgmt beacon", WIPI_FT_MGMT, WIPI_ST_PROBE_RESP, 1) == 1);
+    WIPI_CHECK(test_passes("mgmt beacon", WIPI_FT_DATA, 0, 1) == 0);
+
+    /* And frame terms are AND'd with BSSIDs */
+    WIPI_CHECK(test_passes("beacon bssid 02:00:00:00:00:01", WIPI_FT_MGMT, WIPI_ST_BEACON, 1) == 1);
+    WIPI_CHECK(test_passes("beacon bssid 02:00:00:00:00:01", WIPI_FT_MGMT, WIPI_ST_BEACON, 2) == 0);
+    WIPI_CHECK(test_passes("beacon bssid 02:00:00:00:00:01", WIPI_FT_DATA, 0, 1) == 0);
+    WIPI_CHECK(test_passes("bssid 02:00:00:00:00:01 bssid 02:00:00:00:00:02", WIPI_FT_DATA, 0, 2) == 1);
+
+    WIPI_CHECK(wipi_bpf_compile(&bpf, "beacons") < 0);
+    WIPI_CHECK(wipi_bpf_compile(&bpf, "bssid 02:00:00") < 0);
+}
+
+int main(void)
+{
+    test_kinds();
+
+    return wipi_test_done("test_bpf");
+}
@@ -0,0 +1,270 @@
+/*    test_enc.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Response body encoder tests for WiPi.
+ *
+ * Each case is written through both encoders and compared byte for
+ * byte with what Python's json.dumps(separators=(",", ":")) and
+ * msgpack.packb() produce for the same value.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_ENC_H_
+    #include "wipi_enc.h"
+#endif
+
+/*    MACRO DEFS    */
+#define TEST_BUF    256
+
+/* Compares what was encoded with the expected bytes */
+#define TEST_BYTES(e, s)    ( !(e)->overflow && (e)->len == sizeof(s) - 1 && \
+                              memcmp((e)->buf, s, sizeof(s) - 1) == 0 )
+
+/*    FUNCTION DEFINITIONS    */
+/* {"ssid":"a\"b","ch":[1,-1,300],"ok":true,"db":null,"f":0.5} */
+static void test_doc(struct __wipi_enc_t* e)
+{
+    wipi_enc_map(e, 5);
+
+    wipi_enc_key(e, "ssid");
+    wipi_enc_str(e, "a\"b", 32);
+
+    wipi_enc_key(e, "ch");
+    wipi_enc_array(e, 3);
+    wipi_enc_int(e, 1);
+    wipi_enc_int(e, -1);
+    wipi_enc_int(e, 300);
+    wipi_enc_end(e);
+
+    wipi_enc_key(e, "ok");
+    wipi_enc_bool(e, 1);
+
+    wipi_enc_key(e, "db");
+    wipi_enc_null(e);
+
+    wipi_enc_key(e, "f");
+    wipi_enc_float(e, 0.5);
+
+    wipi_enc_end(e);
+}
+
+static void test_nested(void)
+{
+    wipi_enc_t  e;
+    uint8_t     buf[TEST_BUF];
+
+    wipi_enc_init(&e, WIPI_ENC_JSON, buf, sizeof(buf));
+    test_doc(&e);
+
+    WIPI_CHECK(TEST_BYTES(&e, "{\"ssid\":\"a\\\"b\",\"ch\":[1,-1,300],\"ok\":true,\"db\":null,\"f\":0.5}"));
+    WIPI_CHECK(e.depth == 0);
+
+    wipi_enc_init(&e, WIPI_ENC_MSGPACK, buf, sizeof(buf));
+    test_doc(&e);
+
+    WIPI_CHECK(TEST_BYTES(&e, "\x85"
+                              "\xA4" "ssid" "\xA3" "a\"b"
+                              "\xA2" "ch" "\x93" "\x01" "\xFF" "\xCD\x01\x2C"
+                              "\xA2" "ok" "\xC3"
+                              "\xA2" "db" "\xC0"
+                              "\xA1" "f" "\xCB\x3F\xE0\x00\x00\x00\x00\x00\x00"));
+
+    /* Empty containers, and arrays of maps need separators too */
+    wipi_enc_init(&e, WIPI_ENC_JSON, buf, sizeof(buf));
+    wipi_enc_array(&e, 2);
+    wipi_enc_map(&e, 0);
+    wipi_enc_end(&e);
+    wipi_enc_array(&e, 0);
+    wipi_enc_end(&e);
+    wipi_enc_end(&e);
+
+    WIPI_CHECK(TEST_BYTES(&e, "[{},[]]"));
+}
+
+/* The smallest MessagePack form at each edge */
+static void test_ints(void)
+{
+    static const struct
+    {
+        int64_t     v;
+        const char* bytes;
+        size_t      len;
+    } cases[] = {
+        { 0,            "\x00",                                 1 },
+        { 127,          "\x7F",                                 1 },
+        { 128,          "\xCC\x80",                             2 },
+        { 255,          "\xCC\xFF",                             2 },
+        { 256,          "\xCD\x01\x00",                         3 },
+        { 65536,        "\xCE\x00\x01\x00\x00",                 5 },
+        { 4294967296LL, "\xCF\x00\x00\x00\x01\x00\x00\x00\x00", 9 },
+        { -32,          "\xE0",                                 1 },
+        { -33,          "\xD0\xDF",                             2 },
+        { -129,         "\xD1\xFF\x7F",                         3 },
+        { -32769,       "\xD2\xFF\xFF\x7F\xFF",                 5 },
+        { INT64_MIN,    "\xD3\x80\x00\x00\x00\x00\x00\x00\x00", 9 }
+    };
+
+    wipi_enc_t  e;
+    uint8_t     buf[TEST_BUF];
+    char        num[24];
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        wipi_enc_init(&e, WIPI_ENC_MSGPACK, buf, sizeof(buf));
+        wipi_enc_int(&e, cases[i].v);
+
+        WIPI_CHECK(e.len == cases[i].len && memcmp(buf, cases[i].bytes, cases[i].len) == 0);
+
+        wipi_enc_init(&e, WIPI_ENC_JSON, buf, sizeof(buf));
+        wipi_enc_int(&e, cases[i].v);
+
+        snprintf(num, sizeof(num), "%lld", (long long)cases[i].v);
+        WIPI_CHECK(e.len == strlen(num) && memcmp(buf, num, e.len) == 0);
+    }
+}
+
+/* JSON floats read back exactly, as repr() writes them */
+static void test_floats(void)
+{
+    static const struct
+    {
+        double      v;
+        const char* json;
+    } cases[] = {
+        { 0.1,           "0.1"                },
+        { 2.0,           "2.0"                },
+        { -0.0,          "-0.0"               },
+        { 1e22,          "1e+22"              },
+        { 1.0 / 3.0,     "0.3333333333333333" },
+        { 123456789.125, "123456789.125"      }
+    };
+
+    wipi_enc_t  e;
+    uint8_t     buf[TEST_BUF];
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        wipi_enc_init(&e, WIPI_ENC_JSON, buf, sizeof(buf));
+        wipi_enc_float(&e, cases[i].v);
+
+        WIPI_CHECK(e.len == strlen(cases[i].json) && memcmp(buf, cases[i].json, e.len) == 0);
+    }
+
+    /* Not representable in JSON */
+    wipi_enc_init(&e, WIPI_ENC_JSON, buf, sizeof(buf));
+    wipi_enc_array(&e, 2);
+    wipi_enc_float(&e, NAN);
+    wipi_enc_float(&e, INFINITY);
+    wipi_enc_end(&e);
+
+    WIPI_CHECK(TEST_BYTES(&e, "[null,null]"));
+}
+
+/* Invalid UTF-8 becomes U+FFFD per maximal subpart, like bytes.decode("utf-8", "replace") */
+static void test_strings(void)
+{
+    static const struct
+    {
+        const char* in;
+        const char* out;
+    } cases[] = {
+        { "ab\xFF" "c",           "ab\xEF\xBF\xBD" "c"                                     },
+        { "\xE2\x82",             "\xEF\xBF\xBD"                                           },
+        { "\xED\xA0\x80x",        "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBDx"                  },
+        { "\xF0\x9F\x98\x80",     "\xF0\x9F\x98\x80"                                       },
+        { "\xC0\xAF",             "\xEF\xBF\xBD\xEF\xBF\xBD"                               },
+        { "\xF4\x90\x80\x80",     "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD"       },
+        { "caf\xC3\xA9\xE2",      "caf\xC3\xA9\xEF\xBF\xBD"                                }
+    };
+
+    wipi_enc_t  e;
+    uint8_t     buf[TEST_BUF];
+    size_t      n;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        n = strlen(cases[i].out);
+
+        wipi_enc_init(&e, WIPI_ENC_JSON, buf, sizeof(buf));
+        wipi_enc_str(&e, cases[i].in, 32);
+
+        WIPI_CHECK(e.len == n + 2 && memcmp(buf + 1, cases[i].out, n) == 0);
+
+        /* The MessagePack header counts the cleaned bytes */
+        wipi_enc_init(&e, WIPI_ENC_MSGPACK, buf, sizeof(buf));
+        wipi_enc_str(&e, cases[i].in, 32);
+
+        WIPI_CHECK(e.len == n + 1 && buf[0] == (0xA0 | n) && memcmp(buf + 1, cases[i].out, n) == 0);
+    }
+
+    /* Control characters are escaped, max stops the read */
+    wipi_enc_init(&e, WIPI_ENC_JSON, buf, sizeof(buf));
+    wipi_enc_str(&e, "a\n\t\x01\\bcdef", 6);
+
+    WIPI_CHECK(TEST_BYTES(&e, "\"a\\n\\t\\u0001\\\\b\""));
+
+    /* Backspace and form feed have short forms too */
+    wipi_enc_init(&e, WIPI_ENC_JSON, buf, sizeof(buf));
+    wipi_enc_str(&e, "\b", 8);
+
+    WIPI_CHECK(TEST_BYTES(&e, "\"\\b\""));
+
+    wipi_enc_init(&e, WIPI_ENC_JSON, buf, sizeof(buf));
+    wipi_enc_str(&e, "a\fb\v", 8);
+
+    WIPI_CHECK(TEST_BYTES(&e, "\"a\\fb\\u000b\""));
+
+    /* Past 31 bytes MessagePack needs str8 */
+    wipi_enc_init(&e, WIPI_ENC_MSGPACK, buf, sizeof(buf));
+    wipi_enc_str(&e, "0123456789012345678901234567890123456789", 64);
+
+    WIPI_CHECK(e.len == 42 && buf[0] == 0xD9 && buf[1] == 40);
+}
+
+static void test_overflow(void)
+{
+    wipi_enc_t  e;
+    uint8_t     buf[16];
+
+    /* Running out of room drops everything after, nothing is half written past cap */
+    memset( buf, 0xAA, sizeof(buf) );
+
+    wipi_enc_init(&e, WIPI_ENC_JSON, buf, 8);
+    wipi_enc_array(&e, 3);
+    wipi_enc_str(&e, "abcdefgh", 16);
+    wipi_enc_int(&e, 1);
+    wipi_enc_end(&e);
+
+    WIPI_CHECK(e.overflow);
+    WIPI_CHECK(e.len <= 8 && buf[8] == 0xAA);
+
+    /* Nesting past WIPI_ENC_DEPTH is an overflow too */
+    wipi_enc_init(&e, WIPI_ENC_MSGPACK, buf, sizeof(buf));
+
+    for (int i = 0; i <= WIPI_ENC_DEPTH; i++)
+        wipi_enc_array(&e, 1);
+
+    WIPI_CHECK(e.overflow && e.depth == WIPI_ENC_DEPTH);
+}
+
+int main(void)
+{
+    test_nested();
+    test_ints();
+    test_floats();
+    test_strings();
+    test_overflow();
+
+    return wipi_test_done("test_enc");
+}
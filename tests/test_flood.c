@@ -0,0 +1,151 @@
+/*    test_flood.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Deauth/disassoc flood detector tests for WiPi.
+ *
+ * Writes a capture with a few kinds of traffic and replays it through
+ * the flood hook, so windows and hold-offs run on capture time.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_FLOOD_H_
+    #include "wipi_flood.h"
+#endif
+
+/*    MACRO DEFS    */
+#define TEST_T0     1577836800000000000ULL
+#define TEST_SEC    1000000000ULL
+#define TEST_MS     1000000ULL
+
+#define TEST_REASON 7   /* class 3 frame from nonassociated STA */
+
+/*    FUNCTION DEFINITIONS    */
+static void test_deauth(FILE* fp, uint8_t subtype, uint32_t bssid_id, uint32_t src_id, uint64_t ts_ns)
+{
+    uint8_t pkt[WIPI_TEST_FRAME_MAX], body[2], dst[WIPI_MAC_LEN], src[WIPI_MAC_LEN], bssid[WIPI_MAC_LEN];
+    size_t  len;
+
+    wipi_test_mac(dst, 0xFFFFFF);
+    wipi_test_mac(src, src_id);
+    wipi_test_mac(bssid, bssid_id);
+
+    body[0] = TEST_REASON;
+    body[1] = 0;
+
+    len = wipi_test_mgmt(pkt, subtype, dst, src, bssid, 0, body, 2);
+
+    wipi_test_freq(pkt, 2437);
+    wipi_test_pcap_frame(fp, ts_ns, pkt, len);
+}
+
+static void test_beacon(FILE* fp, uint32_t id, uint64_t ts_ns)
+{
+    uint8_t pkt[WIPI_TEST_FRAME_MAX], body[64], dst[WIPI_MAC_LEN], bssid[WIPI_MAC_LEN];
+    size_t  n, len;
+
+    wipi_test_mac(dst, 0xFFFFFF);
+    wipi_test_mac(bssid, id);
+
+    n = wipi_test_beacon_body(body, ts_ns / 1000, 100, "flood");
+    len = wipi_test_mgmt(pkt, WIPI_ST_BEACON, dst, bssid, bssid, 0, body, n);
+
+    wipi_test_pcap_frame(fp, ts_ns, pkt, len);
+}
+
+static void test_replay(void)
+{
+    struct __wipi_flood_t*  wd;
+    wipi_flood_alert_t      alerts[8];
+    wipi_capture_hook_t     hook;
+    FILE*                   fp;
+    char                    path[64];
+    uint64_t                t;
+    int                     n;
+
+    fp = wipi_test_pcap_open(path, sizeof(path));
+    WIPI_CHECK(fp != NULL);
+
+    if (fp == NULL)
+        return;
+
+    /* 0s: one sender deauths 0xA 40 times in 400ms, beacons in between */
+    for (int i = 0; i < 40; i++)
+    {
+        test_deauth(fp, WIPI_ST_DEAUTH, 0xA, 0x100, TEST_T0 + i * 10 * TEST_MS);
+        test_beacon(fp, 0xA, TEST_T0 + i * 10 * TEST_MS + TEST_MS);
+    }
+
+    /* 1s: a trickle at 0xB, 1 a second for a minute, never 30 in a window */
+    for (int i = 0; i < 60; i++)
+        test_deauth(fp, WIPI_ST_DISASSOC, 0xB, 0x200, TEST_T0 + (1 + i) * TEST_SEC);
+
+    /* 70s: 150 spoofed senders at 0xC, 1 each, is a flood of the BSSID only */
+    for (int i = 0; i < 150; i++)
+        test_deauth(fp, WIPI_ST_DEAUTH, 0xC, 0x1000 + i, TEST_T0 + 70 * TEST_SEC + i * TEST_MS);
+
+    /* 90s: held off long gone, the first sender is back */
+    for (int i = 0; i < 30; i++)
+        test_deauth(fp, WIPI_ST_DEAUTH, 0xA, 0x100, TEST_T0 + 90 * TEST_SEC + i * TEST_MS);
+
+    fclose(fp);
+
+    wd = wipi_flood_init(0, 0, 0);
+
+    hook.fn = wipi_flood_frame;
+    hook.ctx = wd;
+
+    WIPI_CHECK(wipi_capture_replay(path, &hook, 1) == 40 * 2 + 60 + 150 + 30);
+
+    WIPI_CHECK(wd->frames == 40 * 2 + 60 + 150 + 30);
+    WIPI_CHECK(wd->deauths == 40 + 150 + 30);
+    WIPI_CHECK(wd->disassocs == 60);
+
+    n = wipi_flood_alerts(wd, 0, alerts, 8);
+    WIPI_CHECK(n == 3);
+
+    if (n == 3)
+    {
+        /* The 30th frame from the sender, then nothing more for it */
+        t = TEST_T0 + 29 * 10 * TEST_MS;
+
+        WIPI_CHECK(alerts[0].scope == WIPI_FLOOD_SENDER && alerts[0].ts == t);
+        WIPI_CHECK(alerts[0].subtype == WIPI_ST_DEAUTH && alerts[0].reason == TEST_REASON);
+        WIPI_CHECK(alerts[0].bssid[5] == 0xA && alerts[0].src[4] == 0x01 && alerts[0].src[5] == 0x00);
+        WIPI_CHECK(alerts[0].count == 30 && alerts[0].channel == 6);
+
+        /* The 100th spoofed frame */
+        t = TEST_T0 + 70 * TEST_SEC + 99 * TEST_MS;
+
+        WIPI_CHECK(alerts[1].scope == WIPI_FLOOD_BSSID && alerts[1].ts == t);
+        WIPI_CHECK(alerts[1].bssid[5] == 0xC && alerts[1].count >= 100);
+
+        t = TEST_T0 + 90 * TEST_SEC + 29 * TEST_MS;
+
+        WIPI_CHECK(alerts[2].scope == WIPI_FLOOD_SENDER && alerts[2].ts == t);
+        WIPI_CHECK(alerts[2].bssid[5] == 0xA);
+    }
+
+    /* Only what came after an id */
+    WIPI_CHECK(wipi_flood_alerts(wd, 2, alerts, 8) == 1 && alerts[0].id == 3);
+
+    wipi_flood_free(wd);
+    unlink(path);
+}
+
+int main(void)
+{
+    test_replay();
+
+    return wipi_test_done("test_flood");
+}
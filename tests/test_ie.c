@@ -0,0 +1,303 @@
+/*    test_ie.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Information element and beacon parsing tests for WiPi.
+ *
+ * IE lists are copied into buffers of exactly their length before
+ * being parsed, so a read past the end of a truncated or lying
+ * element shows up under a sanitizer, not just as a wrong answer.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_IE_H_
+    #include "wipi_ie.h"
+#endif
+
+/*    MACRO DEFS    */
+#define TEST_SSID32 "0123456789abcdef0123456789abcdef"
+
+/*    FUNCTION DEFINITIONS    */
+/* Appends an element, returns the new length of the list */
+static size_t test_add(uint8_t* ie, size_t off, uint8_t id, const void* body, uint8_t n)
+{
+    ie[off] = id;
+    ie[off + 1] = n;
+
+    memcpy(ie + off + 2, body, n);
+
+    return off + 2 + n;
+}
+
+static void test_parse(const uint8_t* ie, size_t len, uint16_t capab, wipi_caps_t* caps)
+{
+    uint8_t*    exact;
+
+    exact = (uint8_t*)malloc( len ? len : 1 );
+    assert(exact != NULL);
+
+    memcpy(exact, ie, len);
+    wipi_ie_parse(exact, len, capab, caps);
+
+    free(exact);
+}
+
+static void test_rsn(void)
+{
+    /* Version 1, CCMP group, 1 CCMP pairwise, 1 PSK AKM, PMF capable */
+    static const uint8_t rsn[] = { 0x01, 0x00,
+                                   0x00, 0x0F, 0xAC, 0x04,
+                                   0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+                                   0x01, 0x00, 0x00, 0x0F, 0xAC, 0x02,
+                                   0x80, 0x00 };
+
+    /* Counts far past what follows */
+    static const uint8_t pairwise[] = { 0x01, 0x00,
+                                        0x00, 0x0F, 0xAC, 0x04,
+                                        0xFF, 0xFF, 0x00, 0x0F, 0xAC, 0x04 };
+
+    static const uint8_t akms[] = { 0x01, 0x00,
+                                    0x00, 0x0F, 0xAC, 0x04,
+                                    0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+                                    0xFF, 0xFF, 0x00, 0x0F, 0xAC, 0x08 };
+
+    wipi_caps_t caps;
+    uint8_t     ie[WIPI_TEST_FRAME_MAX];
+    size_t      len;
+
+    len = test_add(ie, 0, WIPI_IE_RSN, rsn, sizeof(rsn));
+    test_parse(ie, len, WIPI_CAPAB_PRIVACY, &caps);
+
+    WIPI_CHECK(caps.rsn && caps.security == WIPI_SEC_WPA2 && !caps.enterprise);
+    WIPI_CHECK(caps.group == WIPI_CIPHER_CCMP && caps.pairwise == WIPI_CIPHER_CCMP);
+    WIPI_CHECK(caps.akm == WIPI_AKM_PSK && caps.pmf == 1);
+
+    /* Zero length: RSN with nothing said, taken as the 802.1X default */
+    len = test_add(ie, 0, WIPI_IE_RSN, "", 0);
+    test_parse(ie, len, WIPI_CAPAB_PRIVACY, &caps);
+
+    WIPI_CHECK(caps.rsn && caps.security == WIPI_SEC_WPA2);
+    WIPI_CHECK(caps.akm == WIPI_AKM_8021X && caps.enterprise && caps.pmf == 0);
+
+    len = test_add(ie, 0, WIPI_IE_RSN, pairwise, sizeof(pairwise));
+    test_parse(ie, len, WIPI_CAPAB_PRIVACY, &caps);
+
+    WIPI_CHECK(caps.rsn && caps.pairwise == WIPI_CIPHER_CCMP && caps.akm == WIPI_AKM_8021X);
+
+    len = test_add(ie, 0, WIPI_IE_RSN, akms, sizeof(akms));
+    test_parse(ie, len, WIPI_CAPAB_PRIVACY, &caps);
+
+    WIPI_CHECK(caps.rsn && caps.akm == WIPI_AKM_SAE && caps.security == WIPI_SEC_WPA3 && caps.pmf == 0);
+}
+
+static void test_truncated(void)
+{
+    static const uint8_t rsn[] = { 0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04 };
+
+    wipi_caps_t caps;
+    uint8_t     ie[WIPI_TEST_FRAME_MAX], n;
+    size_t      len;
+
+    /* A country, then an RSN element claiming more than is left */
+    len = test_add(ie, 0, WIPI_IE_COUNTRY, "US\x04", 3);
+    len = test_add(ie, len, WIPI_IE_RSN, rsn, sizeof(rsn));
+    ie[len - sizeof(rsn) - 1] = 20;
+
+    test_parse(ie, len, WIPI_CAPAB_PRIVACY, &caps);
+
+    WIPI_CHECK(memcmp(caps.country, "US", 2) == 0);
+    WIPI_CHECK(!caps.rsn && caps.security == WIPI_SEC_WEP);
+
+    WIPI_CHECK(wipi_ie_find(ie, len, WIPI_IE_COUNTRY, -1, &n) == ie + 2 && n == 3);
+    WIPI_CHECK(wipi_ie_find(ie, len, WIPI_IE_RSN, -1, &n) == NULL);
+
+    /* A lone id byte with no length, and nothing at all */
+    len = test_add(ie, 0, WIPI_IE_COUNTRY, "GB\x04", 3);
+    ie[len++] = WIPI_IE_RSN;
+
+    test_parse(ie, len, 0, &caps);
+    WIPI_CHECK(memcmp(caps.country, "GB", 2) == 0 && caps.security == WIPI_SEC_OPEN);
+
+    test_parse(ie, 0, 0, &caps);
+    WIPI_CHECK(caps.security == WIPI_SEC_OPEN && !caps.ht && caps.nss == 0);
+
+    /* An extension element with no extension id */
+    len = test_add(ie, 0, WIPI_IE_EXT, "", 0);
+    test_parse(ie, len, 0, &caps);
+
+    WIPI_CHECK(!caps.he);
+    WIPI_CHECK(wipi_ie_find(ie, len, WIPI_IE_EXT, WIPI_IE_EXT_HE_CAP, &n) == NULL);
+}
+
+static void test_phy(void)
+{
+    uint8_t     ie[WIPI_TEST_FRAME_MAX], b[32];
+    wipi_caps_t caps;
+    size_t      len;
+
+    /* HT: two streams of MCS, 40 MHz above */
+    memset( b, 0, sizeof(b) );
+    b[3] = b[4] = 0xFF;
+    len = test_add(ie, 0, WIPI_IE_HT_CAP, b, 26);
+
+    memset( b, 0, sizeof(b) );
+    b[0] = 1;
+    b[1] = 0x05;
+    len = test_add(ie, len, WIPI_IE_HT_OP, b, 22);
+
+    test_parse(ie, len, 0, &caps);
+
+    WIPI_CHECK(caps.ht && !caps.vht && !caps.he);
+    WIPI_CHECK(caps.nss == 2 && caps.width == WIPI_WIDTH_40);
+
+    /* VHT: three streams, 80 MHz */
+    memset( b, 0, sizeof(b) );
+    b[4] = 0xEA;
+    b[5] = 0xFF;
+    len = test_add(ie, len, WIPI_IE_VHT_CAP, b, 12);
+
+    memset( b, 0, sizeof(b) );
+    b[0] = 1;
+    b[1] = 42;
+    len = test_add(ie, len, WIPI_IE_VHT_OP, b, 5);
+
+    test_parse(ie, len, 0, &caps);
+
+    WIPI_CHECK(caps.ht && caps.vht && caps.nss == 3 && caps.width == WIPI_WIDTH_80);
+
+    /* HE: four streams */
+    memset( b, 0, sizeof(b) );
+    b[0] = WIPI_IE_EXT_HE_CAP;
+    b[18] = 0xAA;
+    b[19] = 0xFF;
+    len = test_add(ie, len, WIPI_IE_EXT, b, 1 + 17 + 2 + 2);
+
+    test_parse(ie, len, 0, &caps);
+
+    WIPI_CHECK(caps.he && caps.nss == 4 && caps.width == WIPI_WIDTH_80);
+
+    /* Segments 8 channels apart are 160 MHz, further are 80+80 */
+    memset( b, 0, sizeof(b) );
+    b[0] = 1;
+    b[1] = 42;
+    b[2] = 50;
+    len = test_add(ie, 0, WIPI_IE_VHT_OP, b, 3);
+
+    test_parse(ie, len, 0, &caps);
+    WIPI_CHECK(caps.width == WIPI_WIDTH_160);
+
+    b[2] = 106;
+    len = test_add(ie, 0, WIPI_IE_VHT_OP, b, 3);
+
+    test_parse(ie, len, 0, &caps);
+    WIPI_CHECK(caps.width == WIPI_WIDTH_80P80);
+
+    /* HE operation with 6 GHz info, 160 MHz */
+    memset( b, 0, sizeof(b) );
+    b[0] = WIPI_IE_EXT_HE_OP;
+    b[3] = 0x02;                    /* 6 GHz operation info present */
+    b[7] = 1;                       /* primary */
+    b[8] = 3;                       /* control: 160 MHz */
+    b[9] = 7;
+    b[10] = 15;
+    len = test_add(ie, 0, WIPI_IE_EXT, b, 1 + 6 + 5);
+
+    test_parse(ie, len, 0, &caps);
+    WIPI_CHECK(!caps.he && caps.width == WIPI_WIDTH_160);
+
+    /* Same, cut short of the 6 GHz info */
+    len = test_add(ie, 0, WIPI_IE_EXT, b, 1 + 6 + 4);
+
+    test_parse(ie, len, 0, &caps);
+    WIPI_CHECK(caps.width == WIPI_WIDTH_20);
+
+    /* Caps too short for the fields read from them */
+    memset( b, 0xFF, sizeof(b) );
+    len = test_add(ie, 0, WIPI_IE_HT_CAP, b, 4);
+    len = test_add(ie, len, WIPI_IE_VHT_CAP, b, 5);
+
+    b[0] = WIPI_IE_EXT_HE_CAP;
+    len = test_add(ie, len, WIPI_IE_EXT, b, 1 + 17 + 1);
+
+    test_parse(ie, len, 0, &caps);
+    WIPI_CHECK(caps.ht && caps.vht && caps.he && caps.nss == 1);
+}
+
+/* Parses a beacon from BSSID 1 with body, as captured on 2412 MHz */
+static int test_beacon(const uint8_t* body, size_t n, uint8_t subtype, wipi_beacon_t* wb)
+{
+    wipi_frame_t    f;
+    uint8_t         pkt[WIPI_TEST_FRAME_MAX], dst[WIPI_MAC_LEN], bssid[WIPI_MAC_LEN];
+    size_t          len;
+
+    wipi_test_mac(dst, 0xFFFFFF);
+    wipi_test_mac(bssid, 1);
+
+    len = wipi_test_mgmt(pkt, subtype, dst, bssid, bssid, 0, body, n);
+    wipi_test_freq(pkt, 2412);
+
+    if (wipi_frame_parse(&f, pkt, len) < 0)
+        return -1;
+
+    return wipi_frame_beacon(&f, wb);
+}
+
+static void test_frame(void)
+{
+    wipi_beacon_t   wb;
+    uint8_t         body[WIPI_TEST_FRAME_MAX];
+    size_t          n;
+
+    /* A full 32 byte SSID, heard on channel 1 from an AP on 6 */
+    n = wipi_test_beacon_body(body, 0x0102030405060708ULL, 100, TEST_SSID32);
+    n = test_add(body, n, WIPI_IE_DS_PARAMS, "\x06", 1);
+
+    WIPI_CHECK(test_beacon(body, n, WIPI_ST_BEACON, &wb) == 0);
+    WIPI_CHECK(memcmp(wb.ssid, TEST_SSID32, WIPI_MAX_SSID) == 0);
+    WIPI_CHECK(strcmp(wb.bssid, "02:00:00:00:00:01") == 0);
+    WIPI_CHECK(wb.channel == 6 && wb.freq_mhz == 2437);
+    WIPI_CHECK(wb.tsf == 0x0102030405060708ULL && wb.beacon_int == 100);
+    WIPI_CHECK(wb.ie_len == n - WIPI_BEACON_FIXED);
+
+    /* Probe responses too, one byte short of full */
+    n = wipi_test_beacon_body(body, 0, 100, TEST_SSID32 + 1);
+
+    WIPI_CHECK(test_beacon(body, n, WIPI_ST_PROBE_RESP, &wb) == 0);
+    WIPI_CHECK(strcmp(wb.ssid, TEST_SSID32 + 1) == 0 && wb.channel == 1);
+
+    /* An SSID element longer than any SSID is cut to 32 bytes */
+    n = wipi_test_beacon_body(body, 0, 100, TEST_SSID32 TEST_SSID32);
+
+    WIPI_CHECK(test_beacon(body, n, WIPI_ST_BEACON, &wb) == 0);
+    WIPI_CHECK(memcmp(wb.ssid, TEST_SSID32, WIPI_MAX_SSID) == 0);
+
+    /* One running past the frame is no SSID at all */
+    n = wipi_test_beacon_body(body, 0, 100, "cut");
+    body[13] = 10;
+
+    WIPI_CHECK(test_beacon(body, n, WIPI_ST_BEACON, &wb) == 0 && wb.ssid[0] == '\0');
+
+    /* Short of the fixed fields, or not a beacon */
+    WIPI_CHECK(test_beacon(body, WIPI_BEACON_FIXED - 1, WIPI_ST_BEACON, &wb) < 0);
+    WIPI_CHECK(test_beacon(body, n, WIPI_ST_DEAUTH, &wb) < 0);
+}
+
+int main(void)
+{
+    test_rsn();
+    test_truncated();
+    test_phy();
+    test_frame();
+
+    return wipi_test_done("test_ie");
+}
@@ -0,0 +1,188 @@
+/*    test_rogue.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Rogue AP rule tests for WiPi.
+ *
+ * Replays beacons through wipi_rogue_frame() so the channel window is
+ * judged on capture time, not on how fast the file is read back.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_ROGUE_H_
+    #include "wipi_rogue.h"
+#endif
+
+/*    MACRO DEFS    */
+#define TEST_T0     1577836800000000000ULL  /* 2020-01-01, before boot */
+#define TEST_SEC    1000000000ULL
+
+/*    FUNCTION DEFINITIONS    */
+static void test_beacon(FILE* fp, uint32_t id, uint8_t channel, uint64_t ts_ns)
+{
+    uint8_t pkt[WIPI_TEST_FRAME_MAX], body[64], dst[WIPI_MAC_LEN], bssid[WIPI_MAC_LEN];
+    size_t  n, len;
+
+    wipi_test_mac(dst, 0xFFFFFF);
+    wipi_test_mac(bssid, id);
+
+    n = wipi_test_beacon_body(body, ts_ns / 1000, 100, "rogue");
+    len = wipi_test_mgmt(pkt, WIPI_ST_BEACON, dst, bssid, bssid, 0, body, n);
+
+    wipi_test_freq(pkt, (uint16_t)(2407 + 5 * channel));
+    wipi_test_pcap_frame(fp, ts_ns, pkt, len);
+}
+
+static void test_channel_window(void)
+{
+    struct __wipi_rogue_t*  wr;
+    wipi_rogue_alert_t      alerts[8];
+    wipi_capture_hook_t     hook;
+    struct timespec         ts;
+    FILE*                   fp;
+    char                    path[64];
+    uint64_t                wall;
+    int                     n;
+
+    fp = wipi_test_pcap_open(path, sizeof(path));
+    WIPI_CHECK(fp != NULL);
+
+    if (fp == NULL)
+        return;
+
+    /* A hops within the 10s window, B only after a minute */
+    test_beacon(fp, 0xA, 1, TEST_T0);
+    test_beacon(fp, 0xB, 1, TEST_T0);
+    test_beacon(fp, 0xA, 6, TEST_T0 + 1 * TEST_SEC);
+    test_beacon(fp, 0xB, 6, TEST_T0 + 60 * TEST_SEC);
+
+    fclose(fp);
+
+    wr = wipi_rogue_init(0, 0);
+
+    hook.fn = wipi_rogue_frame;
+    hook.ctx = wr;
+
+    WIPI_CHECK(wipi_capture_replay(path, &hook, 1) == 4);
+    WIPI_CHECK(wr->counts[WIPI_ROGUE_CHANNEL] == 1);
+
+    n = wipi_rogue_alerts(wr, 0, alerts, 8);
+    WIPI_CHECK(n == 1);
+
+    if (n == 1)
+    {
+        WIPI_CHECK(alerts[0].rule == WIPI_ROGUE_CHANNEL);
+        WIPI_CHECK(alerts[0].addr[5] == 0xA);
+        WIPI_CHECK(alerts[0].channel == 6 && alerts[0].prev_channel == 1);
+
+        /* Back on the wall clock, the alert is dated by its frame */
+        clock_gettime(CLOCK_REALTIME, &ts);
+        wall = (uint64_t)ts.tv_sec * TEST_SEC + (uint64_t)ts.tv_nsec - (wipi_stats_now() - alerts[0].ts);
+
+        WIPI_CHECK(wall > TEST_T0 + TEST_SEC - TEST_SEC / 100 && wall < TEST_T0 + TEST_SEC + TEST_SEC / 100);
+    }
+
+    wipi_rogue_free(wr);
+    unlink(path);
+}
+
+static void test_eviction(void)
+{
+    struct __wipi_rogue_t*  wr;
+    wipi_beacon_t           wb;
+    uint8_t                 known[WIPI_MAC_LEN];
+    size_t                  naps;
+
+    wr = wipi_rogue_init(0, 0);
+
+    wipi_test_mac(known, 0xFFFFFE);
+    WIPI_CHECK(wipi_rogue_allow(wr, known, "corp", WIPI_SEC_WPA2, 0) == 0);
+
+    memset( &wb, 0, sizeof(wipi_beacon_t) );
+
+    /* Four times what the table holds, from BSSIDs never seen again */
+    for (uint32_t i = 0; i < 4 * WIPI_ROGUE_MAX; i++)
+    {
+        wipi_test_mac(wb.addr, i);
+        wb.seen = 1 + i;
+
+        wipi_rogue_update(wr, &wb);
+    }
+
+    WIPI_CHECK(wr->aps_cap == WIPI_ROGUE_MAX);
+    WIPI_CHECK(wr->naps * 4 <= wr->aps_cap * 3);
+    WIPI_CHECK(wr->evicted > 0);
+
+    /* The newest are still tracked, updating them adds nothing */
+    naps = wr->naps;
+
+    for (uint32_t i = 4 * WIPI_ROGUE_MAX - 1000; i < 4 * WIPI_ROGUE_MAX; i++)
+    {
+        wipi_test_mac(wb.addr, i);
+        wb.seen = 1 + i;
+
+        wipi_rogue_update(wr, &wb);
+    }
+
+    WIPI_CHECK(wr->naps == naps);
+
+    /* And the allow-listed AP was never evicted, its SSID from it is no twin */
+    memcpy(wb.addr, known, WIPI_MAC_LEN);
+    strcpy(wb.ssid, "corp");
+    wb.caps.security = WIPI_SEC_WPA2;
+
+    WIPI_CHECK(wipi_rogue_update(wr, &wb) == 0);
+    WIPI_CHECK(wr->naps == naps);
+
+    wipi_rogue_free(wr);
+}
+
+static void test_full_ssid(void)
+{
+    struct __wipi_rogue_t*  wr;
+    wipi_rogue_alert_t      alert;
+    wipi_beacon_t           wb;
+    uint8_t                 known[WIPI_MAC_LEN];
+
+    wr = wipi_rogue_init(0, 0);
+
+    /* 32 bytes fill the field, one more can never match a beacon */
+    wipi_test_mac(known, 1);
+    WIPI_CHECK(wipi_rogue_allow(wr, known, "0123456789abcdef0123456789abcdef", WIPI_ROGUE_ANY, 0) == 0);
+    WIPI_CHECK(wipi_rogue_allow(wr, known, "0123456789abcdef0123456789abcdefg", WIPI_ROGUE_ANY, 0) < 0);
+
+    memset( &wb, 0, sizeof(wipi_beacon_t) );
+    memcpy(wb.ssid, "0123456789abcdef0123456789abcdef", WIPI_MAX_SSID);
+    wb.seen = 1;
+
+    /* The whole name is the twin, 31 bytes of it is another network */
+    wipi_test_mac(wb.addr, 2);
+    WIPI_CHECK(wipi_rogue_update(wr, &wb) == 1 && wr->counts[WIPI_ROGUE_TWIN] == 1);
+
+    WIPI_CHECK(wipi_rogue_alerts(wr, 0, &alert, 1) == 1 && memcmp(alert.ssid, wb.ssid, WIPI_MAX_SSID) == 0);
+
+    wb.ssid[WIPI_MAX_SSID - 1] = '\0';
+    wipi_test_mac(wb.addr, 3);
+    WIPI_CHECK(wipi_rogue_update(wr, &wb) == 0 && wr->counts[WIPI_ROGUE_TWIN] == 1);
+
+    wipi_rogue_free(wr);
+}
+
+int main(void)
+{
+    test_channel_window();
+    test_eviction();
+    test_full_ssid();
+
+    return wipi_test_done("test_rogue");
+}
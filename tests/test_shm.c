@@ -0,0 +1,226 @@
+/*    test_shm.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Shared memory snapshot tests for WiPi.
+ *
+ * Publishes scans into a segment of its own and reads them back as the
+ * API would, then bumps the writer's sequence number and header fields
+ * by hand to check readers back off a buffer mid-write and refuse a
+ * layout they were not built for.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_SHM_H_
+    #include "wipi_shm.h"
+#endif
+
+/*    MACRO DEFS    */
+#define TEST_SIZE       (64 << 10)
+#define TEST_APS        3
+#define TEST_HDR_LEN    ((sizeof(struct __wipi_shm_hdr_t) + 63) & ~(size_t)63)
+
+/*    STATIC DEFS    */
+static const char*  test_radios[] = { "wlan0", "wlan1" };
+
+/*    FUNCTION DEFINITIONS    */
+/* A scan list of n APs, ended by the empty node scans leave last */
+static void test_scan(struct __wipi_beacon_t* aps, int n)
+{
+    memset( aps, 0, sizeof(struct __wipi_beacon_t) * (n + 1) );
+
+    for (int i = 0; i < n; i++)
+    {
+        snprintf(aps[i].ssid, WIPI_MAX_SSID, "ap%d", i);
+        wipi_test_mac(aps[i].addr, 0x100 + i);
+
+        aps[i].freq_mhz = 2412;
+        aps[i].channel = 1;
+        aps[i].db = -40 - i;
+        aps[i].radio = i & 1;
+        aps[i].radios = 1U << (i & 1);
+        aps[i].next = &aps[i + 1];
+    }
+
+    /* Every byte of the SSID used, no terminator */
+    if (n > 0)
+        memset( aps[0].ssid, 'x', WIPI_MAX_SSID );
+}
+
+static struct __wipi_shm_buf_t* test_current(struct __wipi_shm_t* ws)
+{
+    return (struct __wipi_shm_buf_t*)(ws->map + TEST_HDR_LEN + (size_t)ws->hdr->current * ws->hdr->buf_size);
+}
+
+static void test_publish(const char* name)
+{
+    struct __wipi_shm_t*            ws, *rd;
+    const struct __wipi_shm_buf_t*  snap;
+    const struct __wipi_shm_ap_t*   ap;
+    const struct __wipi_shm_if_t*   wi;
+    struct __wipi_beacon_t          aps[TEST_APS + 1];
+    struct __wipi_shm_if_t          iface;
+    struct __wipi_shm_buf_t*        buf;
+    const char*                     body;
+    uint32_t                        count;
+    uint64_t                        seq;
+
+    ws = wipi_shm_create(name, TEST_SIZE);
+    WIPI_CHECK(ws != NULL);
+
+    if (ws == NULL)
+        return;
+
+    /* Nothing published yet, a reader sees no scan rather than an error */
+    rd = wipi_shm_open(name);
+    WIPI_CHECK(rd != NULL);
+
+    if (rd == NULL)
+    {
+        wipi_shm_free(ws);
+        return;
+    }
+
+    snap = wipi_shm_snapshot(rd);
+    WIPI_CHECK(snap != NULL && snap->generation == 0);
+
+    memset( &iface, 0, sizeof(iface) );
+    strcpy(iface.name, "wlan0");
+    iface.mon = 1;
+
+    test_scan(aps, TEST_APS);
+
+    WIPI_CHECK(wipi_shm_publish(ws, aps, &iface, 1, test_radios, 2, NULL) == TEST_APS);
+
+    snap = wipi_shm_snapshot(rd);
+    WIPI_CHECK(snap != NULL && snap->generation == 1);
+
+    if (snap == NULL)
+    {
+        wipi_shm_free(rd);
+        wipi_shm_free(ws);
+        return;
+    }
+
+    ap = (const struct __wipi_shm_ap_t*)wipi_shm_section(snap, WIPI_SHM_APS, &count);
+
+    WIPI_CHECK(count == TEST_APS);
+    WIPI_CHECK(memcmp(ap[0].ssid, aps[0].ssid, WIPI_MAX_SSID) == 0 && ap[0].ssid[WIPI_MAX_SSID] == '\0');
+    WIPI_CHECK(strcmp(ap[2].ssid, "ap2") == 0 && memcmp(ap[2].addr, aps[2].addr, WIPI_MAC_LEN) == 0);
+    WIPI_CHECK(ap[1].db == -41 && ap[1].radio == 1 && ap[1].freq_mhz == 2412);
+
+    wi = (const struct __wipi_shm_if_t*)wipi_shm_section(snap, WIPI_SHM_IFACES, &count);
+    WIPI_CHECK(count == 1 && strcmp(wi[0].name, "wlan0") == 0 && wi[0].mon == 1);
+
+    /* The encoded bodies are complete responses */
+    body = (const char*)wipi_shm_section(snap, WIPI_SHM_APS_BODY + WIPI_ENC_JSON, &count);
+
+    WIPI_CHECK(count == TEST_APS && snap->sections[WIPI_SHM_APS_BODY + WIPI_ENC_JSON].len > 0);
+    WIPI_CHECK(strncmp(body, "{\"success\":true,\"data\":{\"message\":[", 35) == 0);
+
+    WIPI_CHECK(rd->hdr->nradios == 2 && strcmp(rd->hdr->radios[1], "wlan1") == 0);
+
+    /* Unchanged, the same copy comes back */
+    WIPI_CHECK(wipi_shm_snapshot(rd) == snap && snap->generation == 1);
+
+    /* A writer part way through a publish, the reader backs off */
+    buf = test_current(ws);
+    seq = buf->seq;
+    buf->seq = seq + 1;
+
+    WIPI_CHECK(wipi_shm_snapshot(rd) == NULL && WIPI_ERRNO == WIPI_ERR_BUSY);
+
+    buf->seq = seq;
+
+    WIPI_CHECK(wipi_shm_snapshot(rd) != NULL && rd->snap->generation == 1);
+
+    /* A smaller scan replaces it */
+    test_scan(aps, 1);
+
+    WIPI_CHECK(wipi_shm_publish(ws, aps, &iface, 1, test_radios, 2, NULL) == 1);
+
+    snap = wipi_shm_snapshot(rd);
+    WIPI_CHECK(snap != NULL && snap->generation == 2);
+
+    if (snap)
+    {
+        wipi_shm_section(snap, WIPI_SHM_APS, &count);
+        WIPI_CHECK(count == 1);
+    }
+
+    /* A failed sweep keeps the last scan and its generation, from the other buffer */
+    WIPI_CHECK(wipi_shm_republish(ws, NULL) == 1);
+
+    snap = wipi_shm_snapshot(rd);
+    WIPI_CHECK(snap != NULL && snap->generation == 2 && rd->from == ws->hdr->current);
+
+    wipi_shm_free(rd);
+    wipi_shm_free(ws);
+}
+
+/* Readers built from other sources refuse the segment */
+static void test_layout(const char* name)
+{
+    struct __wipi_shm_t*    ws, *rd;
+    uint32_t                version, ap_size;
+
+    ws = wipi_shm_create(name, TEST_SIZE);
+    WIPI_CHECK(ws != NULL);
+
+    if (ws == NULL)
+        return;
+
+    version = ws->hdr->version;
+    ap_size = ws->hdr->ap_size;
+
+    ws->hdr->version = version + 1;
+    WIPI_ERRNO = WIPI_ERR_OK;
+
+    WIPI_CHECK(wipi_shm_open(name) == NULL && WIPI_ERRNO == WIPI_ERR_RANGE);
+
+    ws->hdr->version = version;
+    ws->hdr->ap_size = ap_size - 8;
+    WIPI_ERRNO = WIPI_ERR_OK;
+
+    WIPI_CHECK(wipi_shm_open(name) == NULL && WIPI_ERRNO == WIPI_ERR_RANGE);
+
+    /* Buffers that would run past the end of the mapping */
+    ws->hdr->ap_size = ap_size;
+    ws->hdr->buf_size *= 2;
+
+    WIPI_CHECK(wipi_shm_open(name) == NULL && WIPI_ERRNO == WIPI_ERR_RANGE);
+
+    ws->hdr->buf_size /= 2;
+
+    /* Put back as it was made, it opens */
+    rd = wipi_shm_open(name);
+    WIPI_CHECK(rd != NULL);
+
+    wipi_shm_free(rd);
+    wipi_shm_free(ws);
+
+    /* And with no segment at all */
+    WIPI_CHECK(wipi_shm_open(name) == NULL && WIPI_ERRNO == WIPI_ERR_IO);
+}
+
+int main(void)
+{
+    char    name[64];
+
+    snprintf(name, sizeof(name), "/wipi-test-%d", (int)getpid());
+
+    test_publish(name);
+    test_layout(name);
+
+    return wipi_test_done("test_shm");
+}
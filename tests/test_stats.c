@@ -0,0 +1,86 @@
+/*    test_stats.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Instrumentation tests for WiPi.
+ *
+ * Observes durations either side of the histogram bounds and checks
+ * each lands in the bucket Prometheus expects, whose le is inclusive.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_STATS_H_
+    #include "wipi_stats.h"
+#endif
+
+/*    FUNCTION DEFINITIONS    */
+/* The bucket one observation of ns went to */
+static int test_bucket(uint64_t ns)
+{
+    wipi_stats_t    before, after;
+
+    wipi_stats_snapshot(&before);
+    wipi_stats_observe(WIPI_HIST_QUERY, ns);
+    wipi_stats_snapshot(&after);
+
+    for (int b = 0; b < WIPI_HIST_BUCKETS; b++)
+    {
+        if (after.hists[WIPI_HIST_QUERY].buckets[b] != before.hists[WIPI_HIST_QUERY].buckets[b])
+            return b;
+    }
+
+    return -1;
+}
+
+static void test_bounds(void)
+{
+    uint64_t    bound;
+
+    WIPI_CHECK(test_bucket(0) == 0);
+    WIPI_CHECK(test_bucket(1) == 0);
+
+    /* Exactly on a bound is inside it, one over is the next */
+    for (int b = 0; b < WIPI_HIST_BUCKETS - 1; b++)
+    {
+        bound = 1ULL << (b + WIPI_HIST_SHIFT);
+
+        WIPI_CHECK(test_bucket(bound) == b);
+        WIPI_CHECK(test_bucket(bound + 1) == b + 1);
+        WIPI_CHECK(wipi_stats_bucket_bound(b) * 1e9 == (double)bound);
+    }
+
+    WIPI_CHECK(test_bucket(UINT64_MAX) == WIPI_HIST_BUCKETS - 1);
+}
+
+static void test_totals(void)
+{
+    wipi_stats_t    before, after;
+
+    wipi_stats_snapshot(&before);
+
+    wipi_stats_observe(WIPI_HIST_SCAN, 256);
+    wipi_stats_observe(WIPI_HIST_SCAN, 1000);
+
+    wipi_stats_snapshot(&after);
+
+    WIPI_CHECK(after.hists[WIPI_HIST_SCAN].count - before.hists[WIPI_HIST_SCAN].count == 2);
+    WIPI_CHECK(after.hists[WIPI_HIST_SCAN].sum_ns - before.hists[WIPI_HIST_SCAN].sum_ns == 1256);
+}
+
+int main(void)
+{
+    test_bounds();
+    test_totals();
+
+    return wipi_test_done("test_stats");
+}
@@ -0,0 +1,205 @@
+/*    test_timing.c    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Beacon timing tests for WiPi.
+ *
+ * Replays a written capture through the timing hook to check what is
+ * read from TSFs and sequence numbers, then feeds beacons straight to
+ * wipi_timing_update() to check the per BSSID table stays within its
+ * cap.
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include "wipi_test.h"
+
+#ifndef _WIPI_TIMING_H_
+    #include "wipi_timing.h"
+#endif
+
+/*    MACRO DEFS    */
+#define TEST_T0     1577836800000000000ULL
+#define TEST_SEC    1000000000ULL
+#define TEST_PERIOD (100 * WIPI_TIMING_TU * 1000ULL)   /* ns, 100 TU */
+
+/*    FUNCTION DEFINITIONS    */
+static void test_update(struct __wipi_timing_t* wt, uint32_t id, uint64_t ts_ns)
+{
+    wipi_frame_t    f;
+    uint8_t         pkt[WIPI_TEST_FRAME_MAX], body[64], dst[WIPI_MAC_LEN], bssid[WIPI_MAC_LEN];
+    size_t          n, len;
+
+    wipi_test_mac(dst, 0xFFFFFF);
+    wipi_test_mac(bssid, id);
+
+    n = wipi_test_beacon_body(body, ts_ns / 1000, 100, "timing");
+    len = wipi_test_mgmt(pkt, WIPI_ST_BEACON, dst, bssid, bssid, 0, body, n);
+
+    wipi_test_freq(pkt, 2412);
+
+    if (wipi_frame_parse(&f, pkt, len) == 0)
+        wipi_timing_update(wt, &f, ts_ns);
+}
+
+static void test_frame(FILE* fp, uint8_t subtype, uint32_t id, uint16_t seq, uint64_t tsf, uint64_t ts_ns, const char* ssid)
+{
+    uint8_t pkt[WIPI_TEST_FRAME_MAX], body[64], dst[WIPI_MAC_LEN], bssid[WIPI_MAC_LEN];
+    size_t  n, len;
+
+    wipi_test_mac(dst, 0xFFFFFF);
+    wipi_test_mac(bssid, id);
+
+    n = wipi_test_beacon_body(body, tsf, 100, ssid);
+    len = wipi_test_mgmt(pkt, subtype, dst, bssid, bssid, seq, body, n);
+
+    wipi_test_freq(pkt, 2412);
+    wipi_test_pcap_frame(fp, ts_ns, pkt, len);
+}
+
+static const wipi_timing_bss_t* test_bss(const wipi_timing_bss_t* records, int n, uint32_t id)
+{
+    for (int i = 0; i < n; i++)
+    {
+        if ((uint32_t)records[i].key == id)
+            return &records[i];
+    }
+
+    return NULL;
+}
+
+static void test_replay(void)
+{
+    struct __wipi_timing_t*     wt;
+    const wipi_timing_bss_t*    b;
+    wipi_timing_bss_t           records[8];
+    wipi_capture_hook_t         hook;
+    wipi_beacon_t               wb;
+    FILE*                       fp;
+    char                        path[64];
+    uint64_t                    ts, up;
+    int                         n;
+
+    fp = wipi_test_pcap_open(path, sizeof(path));
+    WIPI_CHECK(fp != NULL);
+
+    if (fp == NULL)
+        return;
+
+    /* An hour after boot, beacons every 100 TU */
+    up = 3600ULL * 1000000;
+
+    for (uint16_t i = 0; i < 20; i++)
+    {
+        ts = TEST_T0 + i * TEST_PERIOD;
+
+        /* 1: the 10th beacon is lost, the 5th sent twice */
+        if (i != 10)
+            test_frame(fp, WIPI_ST_BEACON, 1, i, up + (ts - TEST_T0) / 1000, ts, "one");
+
+        if (i == 5)
+            test_frame(fp, WIPI_ST_BEACON, 1, i, up + (ts - TEST_T0) / 1000, ts + 1000, "one");
+
+        /* 2: restarted just before the 10th, its TSF starts again near 0 */
+        test_frame(fp, WIPI_ST_BEACON, 2, i, i < 10 ? up + (ts - TEST_T0) / 1000 : (ts - TEST_T0) / 1000 - 1000000, ts, "two");
+
+        /* 3: a second transmitter, up only a minute, sends the 10th beacon */
+        test_frame(fp, WIPI_ST_BEACON, 3, i, (i == 10 ? 60000000 : up) + (ts - TEST_T0) / 1000, ts, "three");
+
+        /* 4: hidden, named by a probe response half way through */
+        test_frame(fp, WIPI_ST_BEACON, 4, i, up + (ts - TEST_T0) / 1000, ts, "");
+
+        if (i == 10)
+            test_frame(fp, WIPI_ST_PROBE_RESP, 4, i, up + (ts - TEST_T0) / 1000, ts + 1000, "secret");
+    }
+
+    fclose(fp);
+
+    wt = wipi_timing_init();
+
+    hook.fn = wipi_timing_frame;
+    hook.ctx = wt;
+
+    WIPI_CHECK(wipi_capture_replay(path, &hook, 1) == 19 + 1 + 20 * 3 + 1);
+    WIPI_CHECK(wt->beacons == 19 + 1 + 20 * 3 && wt->probe_resps == 1);
+
+    n = wipi_timing_bss(wt, records, 8);
+    WIPI_CHECK(n == 4);
+
+    if ((b = test_bss(records, n, 1)) != NULL)
+    {
+        WIPI_CHECK(b->beacons == 19 && b->missed == 1);
+        WIPI_CHECK(b->resets == 0 && b->clashes == 0);
+        WIPI_CHECK(b->tsf == up + 19 * TEST_PERIOD / 1000 && b->beacon_int == 100);
+    }
+
+    if ((b = test_bss(records, n, 2)) != NULL)
+    {
+        WIPI_CHECK(b->resets == 1 && b->clashes == 0 && b->missed == 0);
+        WIPI_CHECK(b->reset_at == TEST_T0 + 10 * TEST_PERIOD);
+    }
+
+    if ((b = test_bss(records, n, 3)) != NULL)
+        WIPI_CHECK(b->resets == 1 && b->clashes == 1);
+
+    if ((b = test_bss(records, n, 4)) != NULL)
+        WIPI_CHECK(b->hidden && b->resolved && strcmp(b->ssid, "secret") == 0);
+
+    WIPI_CHECK(test_bss(records, n, 1) && test_bss(records, n, 2) && test_bss(records, n, 3) && test_bss(records, n, 4));
+    WIPI_CHECK(wt->resets == 2 && wt->clashes == 1 && wt->resolved == 1);
+
+    /* Scan results for the hidden network get its name */
+    memset( &wb, 0, sizeof(wipi_beacon_t) );
+    wipi_test_mac(wb.addr, 4);
+
+    WIPI_CHECK(wipi_timing_beacon(wt, &wb) == 0 && strcmp(wb.ssid, "secret") == 0);
+
+    wipi_test_mac(wb.addr, 5);
+    WIPI_CHECK(wipi_timing_beacon(wt, &wb) < 0);
+
+    wipi_timing_free(wt);
+    unlink(path);
+}
+
+static void test_eviction(void)
+{
+    struct __wipi_timing_t* wt;
+    size_t                  nbss;
+
+    wt = wipi_timing_init();
+
+    /* Four times what the table holds, from BSSIDs never heard again */
+    for (uint32_t i = 0; i < 4 * WIPI_TIMING_MAX; i++)
+        test_update(wt, i, (1 + i) * TEST_SEC);
+
+    WIPI_CHECK(wt->beacons == 4 * WIPI_TIMING_MAX);
+    WIPI_CHECK(wt->cap == WIPI_TIMING_MAX);
+    WIPI_CHECK(wt->nbss * 4 <= wt->cap * 3);
+    WIPI_CHECK(wt->evicted > 0);
+
+    /* The newest are still tracked, another beacon from them adds nothing */
+    nbss = wt->nbss;
+
+    for (uint32_t i = 4 * WIPI_TIMING_MAX - 1000; i < 4 * WIPI_TIMING_MAX; i++)
+        test_update(wt, i, (1 + i) * TEST_SEC + 100 * 1024 * 1000);
+
+    WIPI_CHECK(wt->nbss == nbss);
+    WIPI_CHECK(wt->resets == 0);
+
+    wipi_timing_free(wt);
+}
+
+int main(void)
+{
+    test_replay();
+    test_eviction();
+
+    return wipi_test_done("test_timing");
+}
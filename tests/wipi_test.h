@@ -0,0 +1,176 @@
+/*    wipi_test.h    */
+
+/*
+ * Author: ripmeep
+ * GitHub: https://github.com/ripmeep/
+ * Date  : 19/10/2026
+ */
+
+/* Shared helpers for the WiPi behaviour tests and benchmarks.
+ *
+ * WIPI_CHECK() records a failure and carries on, so one run reports
+ * every broken expectation. The capture helpers write radiotap pcap
+ * files that wipi_capture_replay() reads back, so the capture hooks
+ * can be driven without a monitor mode radio.
+ */
+
+#ifndef _WIPI_TEST_H_
+#define _WIPI_TEST_H_
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+/*    INCLUDES    */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifndef _WIPI_CAPTURE_H_
+    #include "wipi_capture.h"
+#endif
+
+/*    MACRO DEFS    */
+#define WIPI_TEST_PCAP_MAGIC_NS 0xA1B23C4D
+#define WIPI_TEST_RT_LEN        12      /* radiotap header, channel field only */
+#define WIPI_TEST_FRAME_MAX     512
+
+#define WIPI_CHECK(cond)                                                    \
+    do {                                                                    \
+        wipi_test_checks++;                                                 \
+                                                                            \
+        if (!(cond))                                                        \
+        {                                                                   \
+            wipi_test_failures++;                                           \
+            fprintf(stderr, "%s:%d: check failed: %s\n",                    \
+                    __FILE__, __LINE__, #cond);                             \
+        }                                                                   \
+    } while (0)
+
+/*    STATIC DEFS    */
+static int wipi_test_checks;
+static int wipi_test_failures;
+
+/*    FUNCTION DECLS    */
+static inline int wipi_test_done(const char* name)
+{
+    printf("%s: %d checks, %d failed\n", name, wipi_test_checks, wipi_test_failures);
+
+    return wipi_test_failures ? 1 : 0;
+}
+
+/* A pcap file in a fresh temporary path, written to path */
+static inline FILE* wipi_test_pcap_open(char* path, size_t len)
+{
+    uint32_t    hdr[6];
+    FILE*       fp;
+    int         fd;
+
+    snprintf(path, len, "/tmp/wipi-test-XXXXXX");
+
+    if ((fd = mkstemp(path)) < 0 || (fp = fdopen(fd, "wb")) == NULL)
+        return NULL;
+
+    hdr[0] = WIPI_TEST_PCAP_MAGIC_NS;
+    hdr[1] = 2 | 4 << 16;                   /* version 2.4 */
+    hdr[2] = 0;
+    hdr[3] = 0;
+    hdr[4] = 65535;
+    hdr[5] = WIPI_PCAPNG_LINKTYPE;
+
+    fwrite(hdr, sizeof(hdr), 1, fp);
+
+    return fp;
+}
+
+static inline void wipi_test_pcap_frame(FILE* fp,
+                                        uint64_t ts_ns,
+                                        const uint8_t* pkt,
+                                        size_t len)
+{
+    uint32_t    rec[4];
+
+    rec[0] = (uint32_t)(ts_ns / 1000000000ULL);
+    rec[1] = (uint32_t)(ts_ns % 1000000000ULL);
+    rec[2] = rec[3] = (uint32_t)len;
+
+    fwrite(rec, sizeof(rec), 1, fp);
+    fwrite(pkt, len, 1, fp);
+}
+
+static inline void wipi_test_mac(uint8_t* mac, uint32_t id)
+{
+    mac[0] = 0x02;  /* locally administered */
+    mac[1] = 0x00;
+    mac[2] = (uint8_t)(id >> 24);
+    mac[3] = (uint8_t)(id >> 16);
+    mac[4] = (uint8_t)(id >> 8);
+    mac[5] = (uint8_t)id;
+}
+
+/* Radiotap + management header + body, returns the packet length */
+static inline size_t wipi_test_mgmt(uint8_t* pkt,
+                                    uint8_t subtype,
+                                    const uint8_t* dst,
+                                    const uint8_t* src,
+                                    const uint8_t* bssid,
+                                    uint16_t seq,
+                                    const uint8_t* body,
+                                    size_t body_len)
+{
+    uint8_t*    h;
+
+    memset( pkt, 0, WIPI_TEST_RT_LEN + WIPI_MGMT_HDR_LEN );
+
+    pkt[2] = WIPI_TEST_RT_LEN;
+    pkt[4] = 1 << 3;    /* channel present, frequency 0 until wipi_test_freq() */
+
+    h = pkt + WIPI_TEST_RT_LEN;
+    h[0] = (uint8_t)(WIPI_FT_MGMT << 2 | subtype << 4);
+
+    memcpy(h + 4, dst, WIPI_MAC_LEN);
+    memcpy(h + 10, src, WIPI_MAC_LEN);
+    memcpy(h + 16, bssid, WIPI_MAC_LEN);
+
+    h[22] = (uint8_t)(seq << 4);
+    h[23] = (uint8_t)(seq >> 4);
+
+    memcpy(h + WIPI_MGMT_HDR_LEN, body, body_len);
+
+    return WIPI_TEST_RT_LEN + WIPI_MGMT_HDR_LEN + body_len;
+}
+
+/* Sets the radiotap channel frequency of a packet from wipi_test_mgmt() */
+static inline void wipi_test_freq(uint8_t* pkt, uint16_t mhz)
+{
+    pkt[8] = (uint8_t)mhz;
+    pkt[9] = (uint8_t)(mhz >> 8);
+}
+
+/* Beacon or probe response body: timestamp, interval, capability, SSID IE */
+static inline size_t wipi_test_beacon_body(uint8_t* body,
+                                           uint64_t tsf,
+                                           uint16_t interval,
+                                           const char* ssid)
+{
+    size_t  n;
+
+    n = strlen(ssid);
+
+    for (int i = 0; i < 8; i++)
+        body[i] = (uint8_t)(tsf >> (8 * i));
+
+    body[8] = (uint8_t)interval;
+    body[9] = (uint8_t)(interval >> 8);
+    body[10] = 0x01;    /* ESS */
+    body[11] = 0x00;
+    body[12] = 0;       /* SSID IE */
+    body[13] = (uint8_t)n;
+
+    memcpy(body + 14, ssid, n);
+
+    return 14 + n;
+}
+
+#endif
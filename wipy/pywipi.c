@@ -21,8 +21,19 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <ctype.h>
 
 #include "wipi.h"
+#include "wipi_group.h"
+#include "wipi_bpf.h"
+#include "wipi_capture.h"
+#include "wipi_rogue.h"
+#include "wipi_flood.h"
+#include "wipi_airtime.h"
+#include "wipi_timing.h"
+#include "wipi_job.h"
+#include "wipi_oui.h"
+#include "wipi_shm.h"
 #include "Python.h"
 #include "structmember.h"
 
@@ -57,10 +68,85 @@ typedef struct __py_wipi_beacon_t
     PyObject*  quality;
     PyObject*  db;
     PyObject*  channel;
+    PyObject*  band;
+    PyObject*  radio;
+    PyObject*  radios;
+    PyObject*  security;
+    PyObject*  capabilities;
+    PyObject*  ies;
+    PyObject*  airtime;
+    PyObject*  utilization;
+    PyObject*  vendor;      /* looked up on first access */
 
     struct __wipi_beacon_t*     wb;
 } py_wipi_beacon_t;
 
+typedef struct __py_wipi_scanner_group_t
+{
+    PyObject_HEAD
+
+    struct __wipi_scanner_group_t*  wg;
+} py_wipi_scanner_group_t;
+
+typedef struct __py_wipi_capture_t
+{
+    PyObject_HEAD
+
+    PyObject*                   hooked;     /* keeps hook contexts alive */
+
+    struct __wipi_capture_t*    wc;
+} py_wipi_capture_t;
+
+typedef struct __py_wipi_rogue_t
+{
+    PyObject_HEAD
+
+    struct __wipi_rogue_t*  wr;
+} py_wipi_rogue_t;
+
+typedef struct __py_wipi_flood_t
+{
+    PyObject_HEAD
+
+    struct __wipi_flood_t*  wd;
+} py_wipi_flood_t;
+
+typedef struct __py_wipi_airtime_t
+{
+    PyObject_HEAD
+
+    struct __wipi_airtime_t*    wa;
+} py_wipi_airtime_t;
+
+typedef struct __py_wipi_timing_t
+{
+    PyObject_HEAD
+
+    struct __wipi_timing_t* wt;
+} py_wipi_timing_t;
+
+typedef struct __py_wipi_jobs_t
+{
+    PyObject_HEAD
+
+    struct __wipi_jobs_t*   wj;
+} py_wipi_jobs_t;
+
+typedef struct __py_wipi_snapshot_t
+{
+    PyObject_HEAD
+
+    struct __wipi_shm_t*        shm;
+
+    struct __wipi_aptable_t*    table;      /* indexed copy for query() */
+    uint64_t                    generation; /* of the copy */
+} py_wipi_snapshot_t;
+
+/* rogue.check() reads snapshots, which are defined further down */
+static PyTypeObject py_wipi_snapshot_type;
+
+static struct __wipi_aptable_t* py_wipi_snapshot_load(py_wipi_snapshot_t* self);
+
 static void py_wipi_interface_dealloc(py_wipi_interface_t* self)
 {
     wipi_interface_t*   wi;
@@ -141,6 +227,15 @@ static void py_wipi_beacon_dealloc(py_wipi_beacon_t* self)
     Py_XDECREF(self->quality);
     Py_XDECREF(self->db);
     Py_XDECREF(self->channel);
+    Py_XDECREF(self->band);
+    Py_XDECREF(self->radio);
+    Py_XDECREF(self->radios);
+    Py_XDECREF(self->security);
+    Py_XDECREF(self->capabilities);
+    Py_XDECREF(self->ies);
+    Py_XDECREF(self->airtime);
+    Py_XDECREF(self->utilization);
+    Py_XDECREF(self->vendor);
 
     wb = self->wb->head;
 
@@ -165,6 +260,14 @@ static PyObject* py_wipi_beacon_new(PyTypeObject* type, PyObject* args, PyObject
         self->quality   = PyFloat_FromDouble(0.0);
         self->db        = PyLong_FromLong(0);
         self->channel   = PyLong_FromLong(0);
+        self->band      = Py_None;
+        self->radio     = Py_None;
+        self->radios    = Py_None;
+        self->security     = Py_None;
+        self->capabilities = Py_None;
+        self->ies          = Py_None;
+        self->airtime      = Py_None;
+        self->utilization  = Py_None;
     }
 
     return (PyObject*)self;
@@ -179,6 +282,14 @@ static int py_wipi_beacon_init(py_wipi_beacon_t* self, PyObject* args, PyObject*
     Py_INCREF(self->quality);
     Py_INCREF(self->db);
     Py_INCREF(self->channel);
+    Py_INCREF(self->band);
+    Py_INCREF(self->radio);
+    Py_INCREF(self->radios);
+    Py_INCREF(self->security);
+    Py_INCREF(self->capabilities);
+    Py_INCREF(self->ies);
+    Py_INCREF(self->airtime);
+    Py_INCREF(self->utilization);
 
     return 0;
 }
@@ -274,15 +385,72 @@ static PyMemberDef py_wipi_beacon_members[] = {
     {"ssid",         T_OBJECT_EX, offsetof(py_wipi_beacon_t, ssid),         READONLY, "The SSID of the access point beacon"          },
     {"bssid",        T_OBJECT_EX, offsetof(py_wipi_beacon_t, bssid),        READONLY, "The BSSID of the access point beacon"         },
     {"stats",        T_OBJECT_EX, offsetof(py_wipi_beacon_t, stats),        READONLY, "The stats of the access point beacon"         },
-    {"frequency",    T_OBJECT_EX, offsetof(py_wipi_beacon_t, frequency),    READONLY, "The frequency of the access point beacon (Hz)"},
+    {"frequency",    T_OBJECT_EX, offsetof(py_wipi_beacon_t, frequency),    READONLY, "The frequency of the access point beacon (GHz)"},
     {"quality",      T_OBJECT_EX, offsetof(py_wipi_beacon_t, quality),      READONLY, "The quality % of the access point beacon"     },
     {"db",           T_OBJECT_EX, offsetof(py_wipi_beacon_t, db),           READONLY, "The decibels of the access point beacon (sig)"},
     {"channel",      T_OBJECT_EX, offsetof(py_wipi_beacon_t, channel),      READONLY, "The channel of the access point beacon"       },
+    {"band",         T_OBJECT_EX, offsetof(py_wipi_beacon_t, band),         READONLY, "The band of the access point beacon (GHz)"    },
+    {"radio",        T_OBJECT_EX, offsetof(py_wipi_beacon_t, radio),        READONLY, "The interface the kept observation came from" },
+    {"radios",       T_OBJECT_EX, offsetof(py_wipi_beacon_t, radios),       READONLY, "Every interface that saw the access point"    },
+    {"security",     T_OBJECT_EX, offsetof(py_wipi_beacon_t, security),     READONLY, "The security mode of the access point beacon" },
+    {"capabilities", T_OBJECT_EX, offsetof(py_wipi_beacon_t, capabilities), READONLY, "The decoded capabilities of the access point" },
+    {"ies",          T_OBJECT_EX, offsetof(py_wipi_beacon_t, ies),          READONLY, "The raw information elements of the beacon"   },
+    {"airtime",      T_OBJECT_EX, offsetof(py_wipi_beacon_t, airtime),      READONLY, "Share of the channel the BSS used over 10s"   },
+    {"utilization",  T_OBJECT_EX, offsetof(py_wipi_beacon_t, utilization),  READONLY, "Busy fraction of the channel over 10s"        },
+    {NULL}
+};
+
+static PyObject* py_wipi_beacon_ie(py_wipi_beacon_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*    kwlist[] = { "id", "ext", NULL };
+    const uint8_t*  ie;
+    uint8_t         len;
+    int             id, ext;
+
+    ext = -1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "i|i", kwlist, &id, &ext))
+        return NULL;
+
+    if (!PyBytes_Check(self->ies) || id < 0 || id > 0xFF)
+        Py_RETURN_NONE;
+
+    ie = wipi_ie_find((const uint8_t*)PyBytes_AS_STRING(self->ies),
+                      PyBytes_GET_SIZE(self->ies),
+                      (uint8_t)id,
+                      ext,
+                      &len);
+
+    if (ie == NULL)
+        Py_RETURN_NONE;
+
+    return PyBytes_FromStringAndSize((const char*)ie, len);
+}
+
+static PyObject* py_wipi_beacon_vendor(py_wipi_beacon_t* self, void* Py_UNUSED(closure))
+{
+    const char* vendor;
+    uint8_t     addr[WIPI_MAC_LEN];
+
+    if (self->vendor == NULL)
+    {
+        vendor = PyUnicode_Check(self->bssid) && wipi_mac_aton(PyUnicode_AsUTF8(self->bssid), addr) == 0 ? wipi_oui_lookup(addr) : NULL;
+        self->vendor = vendor ? PyUnicode_DecodeUTF8(vendor, strlen(vendor), "replace") : (Py_INCREF(Py_None), Py_None);
+    }
+
+    Py_INCREF(self->vendor);
+
+    return self->vendor;
+}
+
+static PyGetSetDef py_wipi_beacon_getset[] = {
+    {"vendor", (getter)py_wipi_beacon_vendor, NULL, "The manufacturer of the BSSID from the IEEE OUI registry", NULL},
     {NULL}
 };
 
 static PyMethodDef py_wipi_beacon_methods[] = {
     {"deauth", (PyCFunction)py_wipi_beacon_deauth, METH_VARARGS, "Deauthenticate a specified beacon with a specified interface"},
+    {"ie",     (PyCFunction)py_wipi_beacon_ie,     METH_VARARGS | METH_KEYWORDS, "Get the body of an information element by id (and extension id)"},
 	{NULL}
 };
 
@@ -297,9 +465,244 @@ static PyTypeObject py_wipi_beacon_type = {
     .tp_init      = (initproc)py_wipi_beacon_init,
 //  .tp_dealloc   = (destructor)py_wipi_beacon_dealloc,
 	.tp_methods   = py_wipi_beacon_methods,
-    .tp_members   = py_wipi_beacon_members
+    .tp_members   = py_wipi_beacon_members,
+    .tp_getset    = py_wipi_beacon_getset
 };
 
+static PyObject* py_wipi_names(uint32_t mask, const char** names, int count)
+{
+    PyObject*   py_list, *py_name;
+
+    py_list = PyList_New(0);
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!(mask & (1U << i)) || names[i] == NULL)
+            continue;
+
+        py_name = PyUnicode_FromString(names[i]);
+        PyList_Append(py_list, py_name);
+        Py_DECREF(py_name);
+    }
+
+    return py_list;
+}
+
+static PyObject* py_wipi_caps_dict(const wipi_caps_t* caps)
+{
+    static const char*  pmf[] = { "disabled", "capable", "required" };
+
+    return Py_BuildValue("{s:N,s:N,s:N,s:i,s:i,s:O,s:O,s:O,s:O,s:O,s:s,s:N,s:i}",
+                         "akm",        py_wipi_names(caps->akm, WIPI_AKM_NAMES, WIPI_AKMS),
+                         "pairwise",   py_wipi_names(caps->pairwise, WIPI_CIPHER_NAMES, WIPI_CIPHERS),
+                         "group",      py_wipi_names(caps->group, WIPI_CIPHER_NAMES, WIPI_CIPHERS),
+                         "width",      WIPI_WIDTH_MHZ[caps->width],
+                         "nss",        caps->nss,
+                         "enterprise", caps->enterprise ? Py_True : Py_False,
+                         "ht",         caps->ht ? Py_True : Py_False,
+                         "vht",        caps->vht ? Py_True : Py_False,
+                         "he",         caps->he ? Py_True : Py_False,
+                         "wps",        caps->wps ? Py_True : Py_False,
+                         "pmf",        pmf[caps->pmf < 3 ? caps->pmf : 0],
+                         "country",    caps->country[0] ? PyUnicode_FromStringAndSize(caps->country, 2) : (Py_INCREF(Py_None), Py_None),
+                         "vendor_ies", caps->vendor_ies);
+}
+
+static py_wipi_beacon_t* py_wipi_beacon_from(wipi_beacon_t* wb, const char** radios, int nradios)
+{
+    py_wipi_beacon_t*   py_beacon;
+
+    py_beacon = (py_wipi_beacon_t*)py_wipi_beacon_new(&py_wipi_beacon_type, NULL, NULL);
+    py_wipi_beacon_init(py_beacon, NULL, NULL);
+
+    py_beacon->ssid      = PyUnicode_DecodeUTF8(wb->ssid, strnlen(wb->ssid, WIPI_MAX_SSID), "replace");
+    py_beacon->bssid     = PyUnicode_FromString(wb->bssid);
+    py_beacon->stats     = PyUnicode_FromString(wb->stats);
+    py_beacon->frequency = PyFloat_FromDouble(wb->freq);
+    py_beacon->quality   = PyFloat_FromDouble((double)wb->qual);
+    py_beacon->db        = PyLong_FromLong((long)wb->db);
+    py_beacon->channel   = PyLong_FromLong((long)wb->channel);
+    py_beacon->band      = PyUnicode_FromString(WIPI_BAND_NAMES[wb->band]);
+    py_beacon->radio     = wb->radio < nradios ? PyUnicode_FromString(radios[wb->radio]) : (Py_INCREF(Py_None), Py_None);
+    py_beacon->radios    = PyList_New(0);
+    py_beacon->security  = PyUnicode_FromString(WIPI_SECURITY_NAMES[wb->caps.security]);
+    py_beacon->ies       = PyBytes_FromStringAndSize((const char*)wb->ie, wb->ie ? wb->ie_len : 0);
+
+    py_beacon->capabilities = py_wipi_caps_dict(&wb->caps);
+
+    for (int i = 0; i < nradios; i++)
+    {
+        PyObject*   py_name;
+
+        if (!(wb->radios & (1U << i)))
+            continue;
+
+        py_name = PyUnicode_FromString(radios[i]);
+        PyList_Append(py_beacon->radios, py_name);
+        Py_DECREF(py_name);
+    }
+
+    return py_beacon;
+}
+
+static int py_wipi_query_names(PyObject* py_names, const char** names, int count, uint8_t* mask)
+{
+    PyObject*   py_seq, *py_name;
+    const char* name;
+    int         i;
+
+    *mask = 0;
+
+    if (py_names == NULL || py_names == Py_None)
+        return 0;
+
+    /* One name or a list of them */
+    if (PyUnicode_Check(py_names))
+        py_seq = PyTuple_Pack(1, py_names);
+    else
+        py_seq = PySequence_Fast(py_names, "Expected a name or a list of names");
+
+    if (py_seq == NULL)
+        return -1;
+
+    for (Py_ssize_t j = 0; j < PySequence_Fast_GET_SIZE(py_seq); j++)
+    {
+        py_name = PySequence_Fast_GET_ITEM(py_seq, j);
+        name = PyUnicode_Check(py_name) ? PyUnicode_AsUTF8(py_name) : NULL;
+
+        for (i = 0; name && i < count && strcasecmp(name, names[i]); i++)
+            ;
+
+        if (name == NULL || i == count)
+        {
+            Py_DECREF(py_seq);
+            PyErr_Format(PyExc_ValueError, "Unknown filter value %R", py_name);
+
+            return -1;
+        }
+
+        *mask |= 1 << i;
+    }
+
+    Py_DECREF(py_seq);
+
+    return 0;
+}
+
+static int py_wipi_query_parse(PyObject* args, PyObject* kwds, wipi_query_t* q, const char** radios, int nradios)
+{
+    static char*    kwlist[] = { "ssid", "match", "bssid", "band", "channel", "min_rssi", "security",
+                                 "radios", "sort", "order", "offset", "limit", NULL };
+    const char*     ssid, *match, *bssid, *sort, *order;
+    PyObject*       py_band, *py_security, *py_radios;
+    Py_ssize_t      offset, limit;
+    int             channel, min_rssi, digits;
+    uint8_t         mask;
+
+    ssid = bssid = NULL;
+    match = "prefix";
+    sort = "none";
+    order = "asc";
+    py_band = py_security = py_radios = NULL;
+    channel = 0;
+    min_rssi = INT8_MIN;
+    offset = limit = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|zszOiiOOssnn", kwlist, &ssid, &match, &bssid, &py_band,
+                                     &channel, &min_rssi, &py_security, &py_radios, &sort, &order, &offset, &limit))
+        return -1;
+
+    memset( q, 0, sizeof(wipi_query_t) );
+
+    q->ssid = ssid;
+    q->substring = strcmp(match, "substring") == 0;
+    q->channel = channel;
+    q->min_db = min_rssi;
+    q->desc = strcmp(order, "desc") == 0;
+    q->offset = offset > 0 ? (size_t)offset : 0;
+    q->limit = limit > 0 ? (size_t)limit : 0;
+
+    if ((!q->substring && strcmp(match, "prefix")) || (!q->desc && strcmp(order, "asc")))
+    {
+        PyErr_SetString(PyExc_ValueError, "match must be 'prefix' or 'substring' and order 'asc' or 'desc'");
+
+        return -1;
+    }
+
+    for (q->sort = WIPI_SORT_NONE; q->sort < WIPI_SORTS && strcmp(sort, WIPI_SORT_NAMES[q->sort]); q->sort++)
+        ;
+
+    if (q->sort == WIPI_SORTS)
+    {
+        PyErr_Format(PyExc_ValueError, "Unknown sort key %s", sort);
+
+        return -1;
+    }
+
+    /* "AA:BB:C" style prefix, any separators */
+    for (digits = 0; bssid && *bssid; bssid++)
+    {
+        if (*bssid == ':' || *bssid == '-' || *bssid == '.')
+            continue;
+
+        if (!isxdigit((unsigned char)*bssid) || digits == 12)
+        {
+            PyErr_SetString(PyExc_ValueError, "Invalid BSSID prefix");
+
+            return -1;
+        }
+
+        q->bssid |= (uint64_t)(isdigit((unsigned char)*bssid) ? *bssid - '0' : (tolower(*bssid) - 'a' + 10)) << (44 - 4 * digits++);
+    }
+
+    q->bssid_bits = digits * 4;
+
+    if (py_wipi_query_names(py_band, WIPI_BAND_NAMES, WIPI_APTABLE_BANDS, &q->bands) < 0 ||
+        py_wipi_query_names(py_security, WIPI_SECURITY_NAMES, sizeof(WIPI_SECURITY_NAMES) / sizeof(WIPI_SECURITY_NAMES[0]), &q->security) < 0 ||
+        py_wipi_query_names(py_radios, radios, nradios, &mask) < 0)
+        return -1;
+
+    q->radios = mask;
+
+    return 0;
+}
+
+static PyObject* py_wipi_query_run(wipi_aptable_t* t, wipi_query_t* q, const char** radios, int nradios)
+{
+    uint32_t*           recs;
+    PyObject*           py_list;
+    py_wipi_beacon_t*   py_beacon;
+    size_t              max, total;
+    int                 n;
+
+    max = q->limit && q->limit < t->count ? q->limit : t->count;
+    recs = (uint32_t*)PyMem_Malloc( (max ? max : 1) * sizeof(uint32_t) );
+
+    if (recs == NULL)
+        return PyErr_NoMemory();
+
+    if ((n = wipi_aptable_query(t, q, recs, max, &total)) < 0)
+    {
+        PyMem_Free(recs);
+        PyErr_SetString(PyExc_ValueError, WIPI_STRERRS[WIPI_ERRNO]);
+
+        return NULL;
+    }
+
+    /* Only the requested page becomes Python objects */
+    py_list = PyList_New(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        py_beacon = py_wipi_beacon_from(&t->aps[recs[i]], radios, nradios);
+        PyList_SET_ITEM(py_list, i, (PyObject*)py_beacon);
+    }
+
+    PyMem_Free(recs);
+
+    return Py_BuildValue("(nN)", (Py_ssize_t)total, py_list);
+}
+
 static void py_wipi_scanner_dealloc(py_wipi_scanner_t* self)
 {
     memset( self->ws, 0, sizeof(wipi_scanner_t) );
@@ -368,17 +771,12 @@ static PyObject* py_wipi_scanner_scan(py_wipi_scanner_t* self, PyObject* Py_UNUS
 
     for (wb = wb; wb->next; wb = wb->next)
     {
-        py_beacon = (py_wipi_beacon_t*)py_wipi_beacon_new(&py_wipi_beacon_type, NULL, NULL);
-        py_wipi_beacon_init(py_beacon, NULL, NULL);
+        wb->radios = 1;
 
-		py_beacon->ssid      = PyUnicode_FromString(wb->ssid);
-		py_beacon->bssid     = PyUnicode_FromString(wb->bssid);
-        py_beacon->stats     = PyUnicode_FromString(wb->stats);
-        py_beacon->frequency = PyFloat_FromDouble(wb->freq);
-        py_beacon->quality   = PyFloat_FromDouble((double)wb->qual);
-        py_beacon->db        = PyLong_FromLong((long)wb->channel);
+        py_beacon = py_wipi_beacon_from(wb, (const char**)&self->ws->iface, 1);
 
         PyList_Append(py_list, (PyObject*)py_beacon);
+        Py_DECREF(py_beacon);
     }
 
     return py_list;
@@ -409,46 +807,2018 @@ static PyTypeObject py_wipi_scanner_type = {
     .tp_methods   = py_wipi_scanner_methods,
 };
 
-static PyObject* py_wipi_get_interfaces(PyObject* self, PyObject* args, PyObject* kwds)
+static void py_wipi_scanner_group_dealloc(py_wipi_scanner_group_t* self)
 {
-    int                     sa_family;
-    wipi_interface_t*       wi;
-    PyObject*               py_sa_family, *py_list;
-    py_wipi_interface_t*    py_interface;
+    wipi_scanner_group_free(self->wg);
 
-    if (!PyArg_ParseTuple(args, "O", &py_sa_family))
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* py_wipi_scanner_group_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    py_wipi_scanner_group_t*    self;
+
+    self = (py_wipi_scanner_group_t*)type->tp_alloc(type, 0);
+
+    return (PyObject*)self;
+}
+
+static int py_wipi_scanner_group_init(py_wipi_scanner_group_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*    kwlist[] = { "radios", "policy", NULL };
+    PyObject*       py_radios, *py_radio, *py_iface, *py_freqs;
+    const char*     policy, *iface;
+    int             freqs[IW_MAX_FREQUENCIES], nfreqs;
+    Py_ssize_t      n;
+
+    policy = "strongest";
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|s", kwlist, &py_radios, &policy))
+        return -1;
+
+    if (!PySequence_Check(py_radios) || (n = PySequence_Size(py_radios)) <= 0 || n > WIPI_MAX_RADIOS)
     {
-        PyErr_SetString(PyExc_Exception, "Integer parameter required");
+        PyErr_Format(PyExc_ValueError, "Expected a list of 1 to %d radios", WIPI_MAX_RADIOS);
+
+        return -1;
+    }
+
+    if (strcmp(policy, "strongest") && strcmp(policy, "recent"))
+    {
+        PyErr_SetString(PyExc_ValueError, "Merge policy must be 'strongest' or 'recent'");
+
+        return -1;
+    }
+
+    wipi_scanner_group_free(self->wg);
+    self->wg = wipi_scanner_group_init( strcmp(policy, "recent") ? WIPI_MERGE_STRONGEST : WIPI_MERGE_RECENT );
+
+    for (Py_ssize_t i = 0; i < n; i++)
+    {
+        py_radio = PySequence_GetItem(py_radios, i);
+        py_freqs = NULL;
+        nfreqs = 0;
+
+        /* Either "wlan0", ("wlan0", "2.4") or ("wlan0", [2412, 2437, 2462]) */
+        if (PyTuple_Check(py_radio) && PyTuple_Size(py_radio) == 2)
+        {
+            py_iface = PyTuple_GET_ITEM(py_radio, 0);
+            py_freqs = PyTuple_GET_ITEM(py_radio, 1);
+        }
+        else
+            py_iface = py_radio;
+
+        iface = PyUnicode_Check(py_iface) ? PyUnicode_AsUTF8(py_iface) : NULL;
+
+        /* ("wlan0", "5") scans the whole band */
+        if (py_freqs && PyUnicode_Check(py_freqs))
+        {
+            WIPI_BAND   band = wipi_band_from_name( PyUnicode_AsUTF8(py_freqs) );
+
+            if (band == WIPI_BAND_UNKNOWN)
+            {
+                Py_DECREF(py_radio);
+                PyErr_SetString(PyExc_ValueError, "Band must be '2.4', '5' or '6'");
+
+                return -1;
+            }
+
+            nfreqs = wipi_band_freqs(band, freqs, IW_MAX_FREQUENCIES);
+        }
+        else if (py_freqs && PySequence_Check(py_freqs))
+        {
+            for (Py_ssize_t j = 0; j < PySequence_Size(py_freqs) && nfreqs < IW_MAX_FREQUENCIES; j++)
+            {
+                PyObject*   py_freq = PySequence_GetItem(py_freqs, j);
+
+                freqs[nfreqs++] = (int)PyLong_AsLong(py_freq);
+                Py_XDECREF(py_freq);
+            }
+        }
+
+        if (iface == NULL || PyErr_Occurred() || wipi_scanner_group_add(self->wg, iface, freqs, nfreqs) < 0)
+        {
+            Py_DECREF(py_radio);
+
+            if (!PyErr_Occurred())
+                PyErr_Format( PyExc_RuntimeError, "Failed to add radio %zd to scanner group - %s", i, strerror(errno) );
+
+            return -1;
+        }
+
+        Py_DECREF(py_radio);
+    }
+
+    return 0;
+}
+
+static PyObject* py_wipi_scanner_group_scan(py_wipi_scanner_group_t* self, PyObject* Py_UNUSED(ignored))
+{
+    int found;
+
+    if (self->wg == NULL)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Scanner group is not initialized");
 
         return NULL;
     }
 
-    sa_family = PyLong_AsLong(py_sa_family);
+    Py_BEGIN_ALLOW_THREADS
+    found = wipi_scanner_group_scan(self->wg);
+    Py_END_ALLOW_THREADS
 
-    py_list = PyList_New(0);
+    if (found < 0)
+    {
+        PyErr_Format( PyExc_RuntimeError, "Scan failed on every radio - %s", strerror(errno) );
 
-    wi = wipi_get_interfaces(sa_family);
+        return NULL;
+    }
 
-    for (wi = wi; wi->next; wi = wi->next)
+    /* Results stay in the table, read them with query() */
+    return PyLong_FromLong(found);
+}
+
+static PyObject* py_wipi_scanner_group_query(py_wipi_scanner_group_t* self, PyObject* args, PyObject* kwds)
+{
+    wipi_query_t    q;
+    const char*     radios[WIPI_MAX_RADIOS];
+
+    if (self->wg == NULL)
     {
-        py_interface = (py_wipi_interface_t*)py_wipi_interface_new(&py_wipi_interface_type, NULL, NULL);
-        py_wipi_interface_init(py_interface, NULL, NULL);
+        PyErr_SetString(PyExc_RuntimeError, "Scanner group is not initialized");
 
-        py_interface->name         = PyUnicode_FromString(wi->if_name);
-        py_interface->addr         = PyUnicode_FromString(wi->if_addr);
-        py_interface->mask         = PyUnicode_FromString(wi->if_mask);
-        py_interface->flags        = PyLong_FromLong(wi->if_flags);
-        py_interface->monitor_mode = wi->if_mon ? Py_True : Py_False;
+        return NULL;
+    }
 
-        PyList_Append(py_list, (PyObject*)py_interface);
+    for (int i = 0; i < self->wg->count; i++)
+        radios[i] = self->wg->radios[i].ws->iface;
+
+    if (py_wipi_query_parse(args, kwds, &q, radios, self->wg->count) < 0)
+        return NULL;
+
+    return py_wipi_query_run(self->wg->table, &q, radios, self->wg->count);
+}
+
+static PyObject* py_wipi_scanner_group_status(py_wipi_scanner_group_t* self, PyObject* Py_UNUSED(ignored))
+{
+    PyObject*   py_dict, *py_status;
+
+    py_dict = PyDict_New();
+
+    for (int i = 0; self->wg && i < self->wg->count; i++)
+    {
+        py_status = PyUnicode_FromString(WIPI_STRERRS[self->wg->radios[i].status]);
+        PyDict_SetItemString(py_dict, self->wg->radios[i].ws->iface, py_status);
+        Py_DECREF(py_status);
     }
 
-    return py_list;
+    return py_dict;
+}
+
+static PyMethodDef py_wipi_scanner_group_methods[] = {
+    {"scan",   (PyCFunction)py_wipi_scanner_group_scan,   METH_NOARGS,                  "Scan every radio concurrently, returns the merged access point count"},
+    {"query",  (PyCFunction)py_wipi_scanner_group_query,  METH_VARARGS | METH_KEYWORDS, "Filter, sort and page the last scan, returns (total, page)"       },
+    {"status", (PyCFunction)py_wipi_scanner_group_status, METH_NOARGS,                  "The status of each radio after the last scan"                     },
+    {NULL}
+};
+
+static PyTypeObject py_wipi_scanner_group_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name      = "wipi.scanner_group",
+    .tp_doc       = "Wipi multi-radio scanner group object",
+    .tp_basicsize = sizeof(py_wipi_scanner_group_t),
+    .tp_itemsize  = 0,
+    .tp_flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new       = py_wipi_scanner_group_new,
+    .tp_init      = (initproc)py_wipi_scanner_group_init,
+    .tp_dealloc   = (destructor)py_wipi_scanner_group_dealloc,
+    .tp_methods   = py_wipi_scanner_group_methods,
+};
+
+static void py_wipi_capture_dealloc(py_wipi_capture_t* self)
+{
+    Py_BEGIN_ALLOW_THREADS
+    wipi_capture_free(self->wc);
+    Py_END_ALLOW_THREADS
+
+    Py_XDECREF(self->hooked);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* py_wipi_capture_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    py_wipi_capture_t*  self;
+
+    self = (py_wipi_capture_t*)type->tp_alloc(type, 0);
+
+    if (self)
+        self->hooked = PyList_New(0);
+
+    return (PyObject*)self;
+}
+
+static int py_wipi_capture_init(py_wipi_capture_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*    kwlist[] = { "interface", "filter", NULL };
+    const char*     iface, *filter;
+
+    filter = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|z", kwlist, &iface, &filter))
+        return -1;
+
+    wipi_capture_free(self->wc);
+    self->wc = wipi_capture_init(iface, filter);
+
+    if (self->wc == NULL)
+    {
+        if (WIPI_ERRNO == WIPI_ERR_FILTER)
+            PyErr_Format(PyExc_ValueError, "Invalid filter expression '%s'", filter);
+        else if (WIPI_ERRNO == WIPI_ERR_NOMON)
+            PyErr_Format(PyExc_RuntimeError, "Interface %s is not in monitor mode", iface);
+        else
+            PyErr_Format( PyExc_RuntimeError, "Failed to open capture on %s - %s", iface, strerror(errno) );
+
+        return -1;
+    }
+
+    return 0;
+}
+
+static PyObject* py_wipi_capture_record(py_wipi_capture_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*        kwlist[] = { "directory", "prefix", "file_size", "file_seconds", "budget", NULL };
+    const char*         dir, *prefix;
+    unsigned long long  file_size, file_time, budget;
+    int                 ret;
+
+    dir = NULL;
+    prefix = "wipi";
+    file_size = file_time = budget = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|zsKKK", kwlist, &dir, &prefix, &file_size, &file_time, &budget))
+        return NULL;
+
+    if (self->wc == NULL)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Capture is not initialized");
+
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    ret = wipi_capture_record(self->wc, dir, prefix, file_size, file_time, budget);
+    Py_END_ALLOW_THREADS
+
+    if (ret < 0)
+    {
+        PyErr_Format( PyExc_OSError, "Failed to record to %s - %s", dir, strerror(errno) );
+
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* py_wipi_capture_start(py_wipi_capture_t* self, PyObject* Py_UNUSED(ignored))
+{
+    if (self->wc == NULL || wipi_capture_start(self->wc) < 0)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to start capture thread");
+
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* py_wipi_capture_stop(py_wipi_capture_t* self, PyObject* Py_UNUSED(ignored))
+{
+    if (self->wc)
+    {
+        Py_BEGIN_ALLOW_THREADS
+        wipi_capture_stop(self->wc);
+        Py_END_ALLOW_THREADS
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* py_wipi_capture_poll(py_wipi_capture_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*    kwlist[] = { "timeout", NULL };
+    int             timeout_ms, frames;
+
+    timeout_ms = WIPI_CAPTURE_BLOCK_TMO * 2;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i", kwlist, &timeout_ms))
+        return NULL;
+
+    if (self->wc == NULL || self->wc->running)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Capture is not initialized or is running on its own thread");
+
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    frames = wipi_capture_poll(self->wc, timeout_ms);
+    Py_END_ALLOW_THREADS
+
+    if (frames < 0)
+    {
+        PyErr_Format( PyExc_RuntimeError, "Capture poll failed - %s", strerror(errno) );
+
+        return NULL;
+    }
+
+    return PyLong_FromLong(frames);
+}
+
+static PyObject* py_wipi_capture_stats(py_wipi_capture_t* self, PyObject* Py_UNUSED(ignored))
+{
+    wipi_capture_t* wc;
+    wipi_pcapng_t*  wp;
+    PyObject*       py_dict, *py_record;
+
+    if ((wc = self->wc) == NULL)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Capture is not initialized");
+
+        return NULL;
+    }
+
+    pthread_mutex_lock(&wc->lock);
+
+    wp = wc->writer;
+    py_record = wp ? Py_BuildValue("{s:s,s:i,s:K,s:K,s:K,s:K}",
+                                   "directory", wp->dir,
+                                   "files",     wp->nfiles + 1,
+                                   "disk",      (unsigned long long)wp->total,
+                                   "frames",    (unsigned long long)wp->frames,
+                                   "bytes",     (unsigned long long)wp->bytes,
+                                   "drops",     (unsigned long long)wp->drops)
+                   : (Py_INCREF(Py_None), Py_None);
+
+    pthread_mutex_unlock(&wc->lock);
+
+    py_dict = Py_BuildValue("{s:s,s:O,s:K,s:K,s:K,s:s,s:N}",
+                            "interface", wc->iface,
+                            "running",   wc->running ? Py_True : Py_False,
+                            "frames",    (unsigned long long)wc->frames,
+                            "bytes",     (unsigned long long)wc->bytes,
+                            "drops",     (unsigned long long)wc->drops,
+                            "status",    WIPI_STRERRS[wc->status],
+                            "record",    py_record);
+
+    return py_dict;
+}
+
+static PyMethodDef py_wipi_capture_methods[] = {
+    {"record", (PyCFunction)py_wipi_capture_record, METH_VARARGS | METH_KEYWORDS, "Record frames to rotating pcapng files, or stop recording with no directory"},
+    {"start",  (PyCFunction)py_wipi_capture_start,  METH_NOARGS,                  "Capture on a background thread"                                                },
+    {"stop",   (PyCFunction)py_wipi_capture_stop,   METH_NOARGS,                  "Stop the background capture thread"                                            },
+    {"poll",   (PyCFunction)py_wipi_capture_poll,   METH_VARARGS | METH_KEYWORDS, "Process ready ring blocks, waiting up to timeout ms, and return the frame count"},
+    {"stats",  (PyCFunction)py_wipi_capture_stats,  METH_NOARGS,                  "Capture and recording counters"                                                },
+    {NULL}
+};
+
+static PyTypeObject py_wipi_capture_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name      = "wipi.capture",
+    .tp_doc       = "Wipi monitor mode capture object",
+    .tp_basicsize = sizeof(py_wipi_capture_t),
+    .tp_itemsize  = 0,
+    .tp_flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new       = py_wipi_capture_new,
+    .tp_init      = (initproc)py_wipi_capture_init,
+    .tp_dealloc   = (destructor)py_wipi_capture_dealloc,
+    .tp_methods   = py_wipi_capture_methods,
+};
+
+static void py_wipi_rogue_dealloc(py_wipi_rogue_t* self)
+{
+    wipi_rogue_free(self->wr);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* py_wipi_rogue_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    py_wipi_rogue_t*    self;
+
+    self = (py_wipi_rogue_t*)type->tp_alloc(type, 0);
+
+    return (PyObject*)self;
+}
+
+static int py_wipi_rogue_init(py_wipi_rogue_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*    kwlist[] = { "allow", "rssi_jump", "channel_window", NULL };
+    const char*     path;
+    int             rssi_jump, channel_window;
+
+    path = NULL;
+    rssi_jump = channel_window = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|zii", kwlist, &path, &rssi_jump, &channel_window))
+        return -1;
+
+    wipi_rogue_free(self->wr);
+    self->wr = wipi_rogue_init(rssi_jump, channel_window);
+
+    if (path && wipi_rogue_load(self->wr, path) < 0)
+    {
+        PyErr_Format( PyExc_OSError, "Failed to load allow-list %s - %s", path, strerror(errno) );
+
+        return -1;
+    }
+
+    return 0;
+}
+
+static int py_wipi_security_from(PyObject* py_security)
+{
+    const char* name;
+
+    if (py_security == NULL || py_security == Py_None)
+        return WIPI_ROGUE_ANY;
+
+    if (!PyUnicode_Check(py_security) || (name = PyUnicode_AsUTF8(py_security)) == NULL)
+        return -1;
+
+    for (size_t i = 0; i < sizeof(WIPI_SECURITY_NAMES) / sizeof(WIPI_SECURITY_NAMES[0]); i++)
+    {
+        if (strcasecmp(name, WIPI_SECURITY_NAMES[i]) == 0)
+            return (int)i;
+    }
+
+    return strcasecmp(name, "any") == 0 ? WIPI_ROGUE_ANY : -1;
+}
+
+static PyObject* py_wipi_rogue_alert_dict(const wipi_rogue_alert_t* a)
+{
+    struct timespec now;
+    char            bssid[WIPI_MAX_BSSID];
+    double          wall;
+
+    /* Alerts carry monotonic time, report wall clock */
+    clock_gettime(CLOCK_REALTIME, &now);
+    wall = (double)now.tv_sec + now.tv_nsec / 1e9 - (double)(wipi_stats_now() - a->ts) / 1e9;
+
+    snprintf(bssid,
+             sizeof(bssid),
+             "%02X:%02X:%02X:%02X:%02X:%02X",
+             a->addr[0], a->addr[1], a->addr[2],
+             a->addr[3], a->addr[4], a->addr[5]);
+
+    return Py_BuildValue("{s:K,s:d,s:s,s:s,s:N,s:i,s:i,s:i,s:i,s:s,s:N}",
+                         "id",            (unsigned long long)a->id,
+                         "time",          wall,
+                         "rule",          WIPI_ROGUE_NAMES[a->rule],
+                         "bssid",         bssid,
+                         "ssid",          PyUnicode_DecodeUTF8(a->ssid, strnlen(a->ssid, WIPI_MAX_SSID), "replace"),
+                         "channel",       a->channel,
+                         "prev_channel",  a->prev_channel,
+                         "db",            a->db,
+                         "prev_db",       a->prev_db,
+                         "security",      WIPI_SECURITY_NAMES[a->security],
+                         "prev_security", a->prev_security == WIPI_ROGUE_ANY ? (Py_INCREF(Py_None), Py_None)
+                                                                             : PyUnicode_FromString(WIPI_SECURITY_NAMES[a->prev_security]));
+}
+
+static PyObject* py_wipi_rogue_allow(py_wipi_rogue_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*    kwlist[] = { "bssid", "ssid", "security", "channel", NULL };
+    const char*     bssid, *ssid;
+    PyObject*       py_security;
+    uint8_t         addr[WIPI_MAC_LEN];
+    int             security, channel;
+
+    ssid = NULL;
+    py_security = NULL;
+    channel = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|zOi", kwlist, &bssid, &ssid, &py_security, &channel))
+        return NULL;
+
+    if (wipi_mac_aton(bssid, addr) < 0 || (security = py_wipi_security_from(py_security)) < 0 ||
+        channel < 0 || channel > 255)
+    {
+        PyErr_SetString(PyExc_ValueError, "Invalid BSSID, security or channel");
+
+        return NULL;
+    }
+
+    if (wipi_rogue_allow(self->wr, addr, ssid, (uint8_t)security, (uint8_t)channel) < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "SSID longer than 32 bytes, or the allow-list is full");
+
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* py_wipi_rogue_load(py_wipi_rogue_t* self, PyObject* args)
+{
+    const char* path;
+    int         count;
+
+    if (!PyArg_ParseTuple(args, "s", &path))
+        return NULL;
+
+    if ((count = wipi_rogue_load(self->wr, path)) < 0)
+    {
+        PyErr_Format( PyExc_OSError, "Failed to load allow-list %s - %s", path, strerror(errno) );
+
+        return NULL;
+    }
+
+    return PyLong_FromLong(count);
+}
+
+/* Runs the rules over a C table without building a Python object per AP.
+ * The GIL stays held, a snapshot's table is shared with query().
+ */
+static void py_wipi_rogue_table(py_wipi_rogue_t* self, struct __wipi_aptable_t* table)
+{
+    for (size_t i = 0; i < table->count; i++)
+        wipi_rogue_update(self->wr, &table->aps[i]);
+}
+
+static PyObject* py_wipi_rogue_check(py_wipi_rogue_t* self, PyObject* args)
+{
+    PyObject*           py_beacons, *py_iter, *py_item;
+    py_wipi_beacon_t*   py_beacon;
+    wipi_beacon_t       wb;
+    wipi_aptable_t*     table;
+    const char*         ssid;
+    int                 security;
+    uint64_t            since;
+
+    if (!PyArg_ParseTuple(args, "O", &py_beacons))
+        return NULL;
+
+    /* A capture thread may be raising alerts meanwhile */
+    pthread_mutex_lock(&self->wr->lock);
+    since = self->wr->next_id - 1;
+    pthread_mutex_unlock(&self->wr->lock);
+
+    if (PyObject_TypeCheck(py_beacons, &py_wipi_scanner_group_type))
+    {
+        if (((py_wipi_scanner_group_t*)py_beacons)->wg == NULL)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "Scanner group is not initialized");
+
+            return NULL;
+        }
+
+        py_wipi_rogue_table(self, ((py_wipi_scanner_group_t*)py_beacons)->wg->table);
+
+        return PyObject_CallMethod((PyObject*)self, "alerts", "K", (unsigned long long)since);
+    }
+
+    if (PyObject_TypeCheck(py_beacons, &py_wipi_snapshot_type))
+    {
+        if ((table = py_wipi_snapshot_load((py_wipi_snapshot_t*)py_beacons)) == NULL)
+            return NULL;
+
+        py_wipi_rogue_table(self, table);
+
+        return PyObject_CallMethod((PyObject*)self, "alerts", "K", (unsigned long long)since);
+    }
+
+    if ((py_iter = PyObject_GetIter(py_beacons)) == NULL)
+        return NULL;
+
+    while ((py_item = PyIter_Next(py_iter)) != NULL)
+    {
+        if (!PyObject_TypeCheck(py_item, &py_wipi_beacon_type))
+        {
+            Py_DECREF(py_item);
+            continue;
+        }
+
+        py_beacon = (py_wipi_beacon_t*)py_item;
+
+        memset( &wb, 0, sizeof(wipi_beacon_t) );
+
+        ssid = PyUnicode_Check(py_beacon->ssid) ? PyUnicode_AsUTF8(py_beacon->ssid) : NULL;
+        security = py_wipi_security_from(py_beacon->security);
+
+        if (ssid)
+            strncpy(wb.ssid, ssid, WIPI_MAX_SSID);
+
+        wb.caps.security = security >= 0 && security != WIPI_ROGUE_ANY ? security : WIPI_SEC_OPEN;
+        wb.channel = PyLong_Check(py_beacon->channel) ? (int)PyLong_AsLong(py_beacon->channel) : 0;
+        wb.db = PyLong_Check(py_beacon->db) ? (int8_t)PyLong_AsLong(py_beacon->db) : 0;
+
+        if (PyUnicode_Check(py_beacon->bssid) && wipi_mac_aton(PyUnicode_AsUTF8(py_beacon->bssid), wb.addr) == 0)
+            wipi_rogue_update(self->wr, &wb);
+
+        Py_DECREF(py_item);
+    }
+
+    Py_DECREF(py_iter);
+
+    if (PyErr_Occurred())
+        return NULL;
+
+    return PyObject_CallMethod((PyObject*)self, "alerts", "K", (unsigned long long)since);
+}
+
+static PyObject* py_wipi_rogue_alerts(py_wipi_rogue_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*            kwlist[] = { "since", NULL };
+    unsigned long long      since;
+    wipi_rogue_alert_t*     alerts;
+    PyObject*               py_list, *py_alert;
+    int                     n;
+
+    since = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|K", kwlist, &since))
+        return NULL;
+
+    alerts = (wipi_rogue_alert_t*)PyMem_Malloc( WIPI_ROGUE_ALERTS * sizeof(wipi_rogue_alert_t) );
+
+    if (alerts == NULL)
+        return PyErr_NoMemory();
+
+    n = wipi_rogue_alerts(self->wr, since, alerts, WIPI_ROGUE_ALERTS);
+    py_list = PyList_New(0);
+
+    for (int i = 0; i < n; i++)
+    {
+        py_alert = py_wipi_rogue_alert_dict(&alerts[i]);
+        PyList_Append(py_list, py_alert);
+        Py_DECREF(py_alert);
+    }
+
+    PyMem_Free(alerts);
+
+    return py_list;
+}
+
+static PyObject* py_wipi_rogue_watch(py_wipi_rogue_t* self, PyObject* args)
+{
+    py_wipi_capture_t*  py_capture;
+
+    if (!PyArg_ParseTuple(args, "O!", &py_wipi_capture_type, &py_capture))
+        return NULL;
+
+    if (py_capture->wc == NULL || wipi_capture_hook(py_capture->wc, wipi_rogue_frame, self->wr) < 0)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to hook capture");
+
+        return NULL;
+    }
+
+    /* The capture thread uses the engine until the capture is freed */
+    PyList_Append(py_capture->hooked, (PyObject*)self);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* py_wipi_rogue_stats(py_wipi_rogue_t* self, PyObject* Py_UNUSED(ignored))
+{
+    PyObject*   py_dict, *py_count;
+
+    pthread_mutex_lock(&self->wr->lock);
+
+    py_dict = Py_BuildValue("{s:n,s:K,s:n,s:K}",
+                            "tracked", (Py_ssize_t)self->wr->naps,
+                            "evicted", (unsigned long long)self->wr->evicted,
+                            "ssids",   (Py_ssize_t)self->wr->nssids,
+                            "last_id", (unsigned long long)(self->wr->next_id - 1));
+
+    for (int i = 0; i < WIPI_ROGUE_RULES; i++)
+    {
+        py_count = PyLong_FromUnsignedLongLong(self->wr->counts[i]);
+        PyDict_SetItemString(py_dict, WIPI_ROGUE_NAMES[i], py_count);
+        Py_DECREF(py_count);
+    }
+
+    pthread_mutex_unlock(&self->wr->lock);
+
+    return py_dict;
+}
+
+static PyMethodDef py_wipi_rogue_methods[] = {
+    {"allow",  (PyCFunction)py_wipi_rogue_allow,  METH_VARARGS | METH_KEYWORDS, "Add a known AP to the allow-list"                              },
+    {"load",   (PyCFunction)py_wipi_rogue_load,   METH_VARARGS,                 "Load an allow-list file and return the number of APs added"   },
+    {"check",  (PyCFunction)py_wipi_rogue_check,  METH_VARARGS,                 "Run a scanner group, snapshot or beacons through the rules"   },
+    {"watch",  (PyCFunction)py_wipi_rogue_watch,  METH_VARARGS,                 "Run every beacon from a capture through the rules"            },
+    {"alerts", (PyCFunction)py_wipi_rogue_alerts, METH_VARARGS | METH_KEYWORDS, "Recent alerts with an id greater than since"                  },
+    {"stats",  (PyCFunction)py_wipi_rogue_stats,  METH_NOARGS,                  "Tracked AP count and alert totals per rule"                   },
+    {NULL}
+};
+
+static PyTypeObject py_wipi_rogue_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name      = "wipi.rogue",
+    .tp_doc       = "Wipi rogue AP detection engine",
+    .tp_basicsize = sizeof(py_wipi_rogue_t),
+    .tp_itemsize  = 0,
+    .tp_flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new       = py_wipi_rogue_new,
+    .tp_init      = (initproc)py_wipi_rogue_init,
+    .tp_dealloc   = (destructor)py_wipi_rogue_dealloc,
+    .tp_methods   = py_wipi_rogue_methods,
+};
+
+static void py_wipi_flood_dealloc(py_wipi_flood_t* self)
+{
+    wipi_flood_free(self->wd);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* py_wipi_flood_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    py_wipi_flood_t*    self;
+
+    self = (py_wipi_flood_t*)type->tp_alloc(type, 0);
+
+    return (PyObject*)self;
+}
+
+static int py_wipi_flood_init(py_wipi_flood_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*    kwlist[] = { "window", "threshold", "bssid_threshold", NULL };
+    int             window;
+    unsigned int    threshold, bssid_threshold;
+
+    window = 0;
+    threshold = bssid_threshold = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|iII", kwlist, &window, &threshold, &bssid_threshold))
+        return -1;
+
+    wipi_flood_free(self->wd);
+    self->wd = wipi_flood_init(window, threshold, bssid_threshold);
+
+    return 0;
+}
+
+static PyObject* py_wipi_mac_str(const uint8_t* mac)
+{
+    char    str[WIPI_MAX_BSSID];
+
+    snprintf(str,
+             sizeof(str),
+             "%02X:%02X:%02X:%02X:%02X:%02X",
+             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+    return PyUnicode_FromString(str);
+}
+
+static PyObject* py_wipi_flood_alert_dict(const wipi_flood_alert_t* a)
+{
+    return Py_BuildValue("{s:K,s:d,s:s,s:s,s:N,s:N,s:N,s:i,s:i,s:I}",
+                         "id",      (unsigned long long)a->id,
+                         "time",    (double)a->ts / 1e9,
+                         "scope",   a->scope == WIPI_FLOOD_BSSID ? "bssid" : "sender",
+                         "type",    a->subtype == WIPI_ST_DEAUTH ? "deauth" : "disassoc",
+                         "bssid",   py_wipi_mac_str(a->bssid),
+                         "source",  py_wipi_mac_str(a->src),
+                         "target",  py_wipi_mac_str(a->dst),
+                         "reason",  a->reason,
+                         "channel", a->channel,
+                         "count",   a->count);
+}
+
+static PyObject* py_wipi_flood_alerts(py_wipi_flood_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*            kwlist[] = { "since", NULL };
+    unsigned long long      since;
+    wipi_flood_alert_t*     alerts;
+    PyObject*               py_list, *py_alert;
+    int                     n;
+
+    since = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|K", kwlist, &since))
+        return NULL;
+
+    alerts = (wipi_flood_alert_t*)PyMem_Malloc( WIPI_FLOOD_ALERTS * sizeof(wipi_flood_alert_t) );
+
+    if (alerts == NULL)
+        return PyErr_NoMemory();
+
+    n = wipi_flood_alerts(self->wd, since, alerts, WIPI_FLOOD_ALERTS);
+    py_list = PyList_New(0);
+
+    for (int i = 0; i < n; i++)
+    {
+        py_alert = py_wipi_flood_alert_dict(&alerts[i]);
+        PyList_Append(py_list, py_alert);
+        Py_DECREF(py_alert);
+    }
+
+    PyMem_Free(alerts);
+
+    return py_list;
+}
+
+static PyObject* py_wipi_flood_watch(py_wipi_flood_t* self, PyObject* args)
+{
+    py_wipi_capture_t*  py_capture;
+
+    if (!PyArg_ParseTuple(args, "O!", &py_wipi_capture_type, &py_capture))
+        return NULL;
+
+    if (py_capture->wc == NULL || wipi_capture_hook(py_capture->wc, wipi_flood_frame, self->wd) < 0)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to hook capture");
+
+        return NULL;
+    }
+
+    PyList_Append(py_capture->hooked, (PyObject*)self);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* py_wipi_flood_replay(py_wipi_flood_t* self, PyObject* args)
+{
+    wipi_capture_hook_t hook;
+    const char*         path;
+    uint64_t            start, elapsed;
+    int                 frames;
+
+    if (!PyArg_ParseTuple(args, "s", &path))
+        return NULL;
+
+    hook.fn = wipi_flood_frame;
+    hook.ctx = self->wd;
+
+    Py_BEGIN_ALLOW_THREADS
+    start = wipi_stats_now();
+    frames = wipi_capture_replay(path, &hook, 1);
+    elapsed = wipi_stats_now() - start;
+    Py_END_ALLOW_THREADS
+
+    if (frames < 0)
+    {
+        PyErr_Format( PyExc_OSError, "Failed to replay %s - %s", path, errno ? strerror(errno) : "not a radiotap pcap/pcapng file" );
+
+        return NULL;
+    }
+
+    return Py_BuildValue("{s:i,s:d,s:d}",
+                         "frames",  frames,
+                         "seconds", (double)elapsed / 1e9,
+                         "fps",     elapsed ? frames * 1e9 / (double)elapsed : 0.0);
+}
+
+static PyObject* py_wipi_flood_stats(py_wipi_flood_t* self, PyObject* Py_UNUSED(ignored))
+{
+    uint64_t    deauths, disassocs, last_id;
+
+    pthread_mutex_lock(&self->wd->lock);
+
+    deauths = self->wd->deauths;
+    disassocs = self->wd->disassocs;
+    last_id = self->wd->next_id - 1;
+
+    pthread_mutex_unlock(&self->wd->lock);
+
+    return Py_BuildValue("{s:K,s:K,s:K,s:K}",
+                         "frames",    (unsigned long long)__atomic_load_n(&self->wd->frames, __ATOMIC_RELAXED),
+                         "deauth",    (unsigned long long)deauths,
+                         "disassoc",  (unsigned long long)disassocs,
+                         "last_id",   (unsigned long long)last_id);
+}
+
+static PyMethodDef py_wipi_flood_methods[] = {
+    {"watch",  (PyCFunction)py_wipi_flood_watch,  METH_VARARGS,                 "Count deauth/disassoc frames from a capture"                     },
+    {"replay", (PyCFunction)py_wipi_flood_replay, METH_VARARGS,                 "Run a pcap/pcapng file through the detector and time it"         },
+    {"alerts", (PyCFunction)py_wipi_flood_alerts, METH_VARARGS | METH_KEYWORDS, "Recent alerts with an id greater than since"                     },
+    {"stats",  (PyCFunction)py_wipi_flood_stats,  METH_NOARGS,                  "Frame counts and the last alert id"                              },
+    {NULL}
+};
+
+static PyTypeObject py_wipi_flood_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name      = "wipi.flood",
+    .tp_doc       = "Wipi deauth/disassoc flood detector",
+    .tp_basicsize = sizeof(py_wipi_flood_t),
+    .tp_itemsize  = 0,
+    .tp_flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new       = py_wipi_flood_new,
+    .tp_init      = (initproc)py_wipi_flood_init,
+    .tp_dealloc   = (destructor)py_wipi_flood_dealloc,
+    .tp_methods   = py_wipi_flood_methods,
+};
+
+static void py_wipi_airtime_dealloc(py_wipi_airtime_t* self)
+{
+    wipi_airtime_free(self->wa);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* py_wipi_airtime_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    py_wipi_airtime_t*  self;
+
+    self = (py_wipi_airtime_t*)type->tp_alloc(type, 0);
+
+    return (PyObject*)self;
+}
+
+static int py_wipi_airtime_init(py_wipi_airtime_t* self, PyObject* args, PyObject* kwds)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return -1;
+
+    wipi_airtime_free(self->wa);
+    self->wa = wipi_airtime_init();
+
+    return 0;
+}
+
+static PyObject* py_wipi_airtime_windows(const float* v)
+{
+    return Py_BuildValue("{s:d,s:d,s:d}",
+                         "1s",  (double)v[0],
+                         "10s", (double)v[1],
+                         "60s", (double)v[2]);
+}
+
+static PyObject* py_wipi_airtime_report_dict(const wipi_airtime_report_t* r, int bss)
+{
+    if (bss)
+        return Py_BuildValue("{s:N,s:i,s:i,s:K,s:N}",
+                             "bssid",     py_wipi_mac_str(r->addr),
+                             "frequency", r->freq,
+                             "channel",   wipi_freq_channel(r->freq),
+                             "frames",    (unsigned long long)r->frames,
+                             "busy",      py_wipi_airtime_windows(r->busy));
+
+    return Py_BuildValue("{s:i,s:i,s:s,s:K,s:N,s:N,s:N}",
+                         "frequency", r->freq,
+                         "channel",   wipi_freq_channel(r->freq),
+                         "band",      WIPI_BAND_NAMES[wipi_freq_band(r->freq)],
+                         "frames",    (unsigned long long)r->frames,
+                         "busy",      py_wipi_airtime_windows(r->busy),
+                         "retry",     py_wipi_airtime_windows(r->retry),
+                         "beacon",    py_wipi_airtime_windows(r->beacon));
+}
+
+static PyObject* py_wipi_airtime_list(py_wipi_airtime_t* self, int bss)
+{
+    wipi_airtime_report_t*  reports;
+    PyObject*               py_list, *py_report;
+    int                     n;
+
+    reports = (wipi_airtime_report_t*)PyMem_Malloc( WIPI_AIRTIME_BSS * sizeof(wipi_airtime_report_t) );
+
+    if (reports == NULL)
+        return PyErr_NoMemory();
+
+    n = bss ? wipi_airtime_bss(self->wa, reports, WIPI_AIRTIME_BSS)
+            : wipi_airtime_channels(self->wa, reports, WIPI_AIRTIME_CHANNELS);
+
+    py_list = PyList_New(0);
+
+    for (int i = 0; i < n; i++)
+    {
+        py_report = py_wipi_airtime_report_dict(&reports[i], bss);
+        PyList_Append(py_list, py_report);
+        Py_DECREF(py_report);
+    }
+
+    PyMem_Free(reports);
+
+    return py_list;
+}
+
+static PyObject* py_wipi_airtime_channels(py_wipi_airtime_t* self, PyObject* Py_UNUSED(ignored))
+{
+    return py_wipi_airtime_list(self, 0);
+}
+
+static PyObject* py_wipi_airtime_bss(py_wipi_airtime_t* self, PyObject* Py_UNUSED(ignored))
+{
+    return py_wipi_airtime_list(self, 1);
+}
+
+static PyObject* py_wipi_airtime_annotate(py_wipi_airtime_t* self, PyObject* args)
+{
+    PyObject*           py_beacons, *py_iter, *py_item;
+    py_wipi_beacon_t*   py_beacon;
+    wipi_beacon_t       wb;
+
+    if (!PyArg_ParseTuple(args, "O", &py_beacons))
+        return NULL;
+
+    if ((py_iter = PyObject_GetIter(py_beacons)) == NULL)
+        return NULL;
+
+    while ((py_item = PyIter_Next(py_iter)) != NULL)
+    {
+        if (!PyObject_TypeCheck(py_item, &py_wipi_beacon_type))
+        {
+            Py_DECREF(py_item);
+            continue;
+        }
+
+        py_beacon = (py_wipi_beacon_t*)py_item;
+
+        memset( &wb, 0, sizeof(wipi_beacon_t) );
+
+        wb.airtime = wb.utilization = -1;
+        wb.freq_mhz = PyFloat_Check(py_beacon->frequency) ? (uint16_t)lround(PyFloat_AsDouble(py_beacon->frequency) * 1000) : 0;
+
+        if (PyUnicode_Check(py_beacon->bssid) && wipi_mac_aton(PyUnicode_AsUTF8(py_beacon->bssid), wb.addr) == 0 &&
+            wipi_airtime_beacon(self->wa, &wb) == 0)
+        {
+            Py_XDECREF(py_beacon->airtime);
+            Py_XDECREF(py_beacon->utilization);
+
+            py_beacon->airtime = wb.airtime < 0 ? (Py_INCREF(Py_None), Py_None) : PyFloat_FromDouble(wb.airtime);
+            py_beacon->utilization = wb.utilization < 0 ? (Py_INCREF(Py_None), Py_None) : PyFloat_FromDouble(wb.utilization);
+        }
+
+        Py_DECREF(py_item);
+    }
+
+    Py_DECREF(py_iter);
+
+    if (PyErr_Occurred())
+        return NULL;
+
+    Py_INCREF(py_beacons);
+
+    return py_beacons;
+}
+
+static PyObject* py_wipi_airtime_watch(py_wipi_airtime_t* self, PyObject* args)
+{
+    py_wipi_capture_t*  py_capture;
+
+    if (!PyArg_ParseTuple(args, "O!", &py_wipi_capture_type, &py_capture))
+        return NULL;
+
+    if (py_capture->wc == NULL || wipi_capture_hook(py_capture->wc, wipi_airtime_frame, self->wa) < 0)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to hook capture");
+
+        return NULL;
+    }
+
+    PyList_Append(py_capture->hooked, (PyObject*)self);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* py_wipi_airtime_replay(py_wipi_airtime_t* self, PyObject* args)
+{
+    wipi_capture_hook_t hook;
+    const char*         path;
+    int                 frames;
+
+    if (!PyArg_ParseTuple(args, "s", &path))
+        return NULL;
+
+    hook.fn = wipi_airtime_frame;
+    hook.ctx = self->wa;
+
+    Py_BEGIN_ALLOW_THREADS
+    frames = wipi_capture_replay(path, &hook, 1);
+    Py_END_ALLOW_THREADS
+
+    if (frames < 0)
+    {
+        PyErr_Format( PyExc_OSError, "Failed to replay %s - %s", path, errno ? strerror(errno) : "not a radiotap pcap/pcapng file" );
+
+        return NULL;
+    }
+
+    return PyLong_FromLong(frames);
+}
+
+static PyObject* py_wipi_airtime_stats(py_wipi_airtime_t* self, PyObject* Py_UNUSED(ignored))
+{
+    int channels;
+
+    channels = 0;
+
+    for (int i = 0; i < WIPI_AIRTIME_CHANNELS; i++)
+        channels += self->wa->freqs[i] != 0;
+
+    return Py_BuildValue("{s:i,s:i,s:K,s:K,s:K}",
+                         "channels",  channels,
+                         "bss",       self->wa->nbss,
+                         "evicted",   (unsigned long long)self->wa->evicted,
+                         "untracked", (unsigned long long)self->wa->untracked,
+                         "seconds",   (unsigned long long)(self->wa->first ? self->wa->second - self->wa->first : 0));
+}
+
+static PyMethodDef py_wipi_airtime_methods[] = {
+    {"watch",    (PyCFunction)py_wipi_airtime_watch,    METH_VARARGS, "Account the airtime of every frame from a capture"            },
+    {"replay",   (PyCFunction)py_wipi_airtime_replay,   METH_VARARGS, "Account the airtime of every frame in a pcap/pcapng file"     },
+    {"channels", (PyCFunction)py_wipi_airtime_channels, METH_NOARGS,  "Busy, retry and beacon share of each channel over 1s/10s/60s"},
+    {"bss",      (PyCFunction)py_wipi_airtime_bss,      METH_NOARGS,  "Share of its channel each BSSID used over 1s/10s/60s"       },
+    {"annotate", (PyCFunction)py_wipi_airtime_annotate, METH_VARARGS, "Set airtime and utilization on scan results"                },
+    {"stats",    (PyCFunction)py_wipi_airtime_stats,    METH_NOARGS,  "Tracked channels and BSSIDs, evictions and untracked frames"   },
+    {NULL}
+};
+
+static PyTypeObject py_wipi_airtime_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name      = "wipi.airtime",
+    .tp_doc       = "Wipi channel airtime and utilization estimator",
+    .tp_basicsize = sizeof(py_wipi_airtime_t),
+    .tp_itemsize  = 0,
+    .tp_flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new       = py_wipi_airtime_new,
+    .tp_init      = (initproc)py_wipi_airtime_init,
+    .tp_dealloc   = (destructor)py_wipi_airtime_dealloc,
+    .tp_methods   = py_wipi_airtime_methods,
+};
+
+static void py_wipi_timing_dealloc(py_wipi_timing_t* self)
+{
+    wipi_timing_free(self->wt);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* py_wipi_timing_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    py_wipi_timing_t*   self;
+
+    self = (py_wipi_timing_t*)type->tp_alloc(type, 0);
+
+    return (PyObject*)self;
+}
+
+static int py_wipi_timing_init(py_wipi_timing_t* self, PyObject* args, PyObject* kwds)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return -1;
+
+    wipi_timing_free(self->wt);
+    self->wt = wipi_timing_init();
+
+    return 0;
+}
+
+static PyObject* py_wipi_timing_bss_dict(const wipi_timing_bss_t* b)
+{
+    uint8_t addr[WIPI_MAC_LEN];
+    double  loss;
+
+    for (int i = 0; i < WIPI_MAC_LEN; i++)
+        addr[i] = (uint8_t)(b->key >> (8 * (WIPI_MAC_LEN - 1 - i)));
+
+    loss = b->beacons + b->missed ? (double)b->missed / (b->beacons + b->missed) : 0;
+
+    return Py_BuildValue("{s:N,s:N,s:O,s:O,s:i,s:d,s:d,s:d,s:i,s:K,s:K,s:d,s:I,s:I,s:N}",
+                         "bssid",           py_wipi_mac_str(addr),
+                         "ssid",            PyUnicode_DecodeUTF8(b->ssid, strnlen(b->ssid, WIPI_MAX_SSID), "replace"),
+                         "hidden",          b->hidden ? Py_True : Py_False,
+                         "resolved",        b->resolved ? Py_True : Py_False,
+                         "beacon_interval", (int)b->beacon_int,
+                         "beacon_ms",       b->beacon_int * WIPI_TIMING_TU / 1000.0,
+                         "uptime",          (double)b->tsf / 1e6,
+                         "seen",            (double)b->rx / 1e9,
+                         "seq",             (int)b->seq,
+                         "beacons",         (unsigned long long)b->beacons,
+                         "missed",          (unsigned long long)b->missed,
+                         "loss",            loss,
+                         "resets",          b->resets,
+                         "clashes",         b->clashes,
+                         "last_reset",      b->reset_at ? PyFloat_FromDouble((double)b->reset_at / 1e9) : (Py_INCREF(Py_None), Py_None));
+}
+
+static PyObject* py_wipi_timing_bss(py_wipi_timing_t* self, PyObject* Py_UNUSED(ignored))
+{
+    wipi_timing_bss_t*  records;
+    PyObject*           py_list, *py_record;
+    size_t              max;
+    int                 n;
+
+    /* Unlocked read, only used to size the copy */
+    max = self->wt->nbss + 1;
+    records = (wipi_timing_bss_t*)PyMem_Malloc( max * sizeof(wipi_timing_bss_t) );
+
+    if (records == NULL)
+        return PyErr_NoMemory();
+
+    n = wipi_timing_bss(self->wt, records, (int)max);
+
+    py_list = PyList_New(0);
+
+    for (int i = 0; i < n; i++)
+    {
+        py_record = py_wipi_timing_bss_dict(&records[i]);
+        PyList_Append(py_list, py_record);
+        Py_DECREF(py_record);
+    }
+
+    PyMem_Free(records);
+
+    return py_list;
+}
+
+static PyObject* py_wipi_timing_annotate(py_wipi_timing_t* self, PyObject* args)
+{
+    PyObject*           py_beacons, *py_iter, *py_item;
+    py_wipi_beacon_t*   py_beacon;
+    wipi_beacon_t       wb;
+
+    if (!PyArg_ParseTuple(args, "O", &py_beacons))
+        return NULL;
+
+    if ((py_iter = PyObject_GetIter(py_beacons)) == NULL)
+        return NULL;
+
+    while ((py_item = PyIter_Next(py_iter)) != NULL)
+    {
+        if (!PyObject_TypeCheck(py_item, &py_wipi_beacon_type))
+        {
+            Py_DECREF(py_item);
+            continue;
+        }
+
+        py_beacon = (py_wipi_beacon_t*)py_item;
+
+        memset( &wb, 0, sizeof(wipi_beacon_t) );
+
+        /* Only hidden networks are filled in */
+        if (PyUnicode_Check(py_beacon->ssid) && PyUnicode_GET_LENGTH(py_beacon->ssid) == 0 &&
+            PyUnicode_Check(py_beacon->bssid) && wipi_mac_aton(PyUnicode_AsUTF8(py_beacon->bssid), wb.addr) == 0 &&
+            wipi_timing_beacon(self->wt, &wb) == 0 && wb.ssid[0])
+        {
+            Py_XDECREF(py_beacon->ssid);
+
+            py_beacon->ssid = PyUnicode_DecodeUTF8(wb.ssid, strnlen(wb.ssid, WIPI_MAX_SSID), "replace");
+        }
+
+        Py_DECREF(py_item);
+    }
+
+    Py_DECREF(py_iter);
+
+    if (PyErr_Occurred())
+        return NULL;
+
+    Py_INCREF(py_beacons);
+
+    return py_beacons;
+}
+
+static PyObject* py_wipi_timing_watch(py_wipi_timing_t* self, PyObject* args)
+{
+    py_wipi_capture_t*  py_capture;
+
+    if (!PyArg_ParseTuple(args, "O!", &py_wipi_capture_type, &py_capture))
+        return NULL;
+
+    if (py_capture->wc == NULL || wipi_capture_hook(py_capture->wc, wipi_timing_frame, self->wt) < 0)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to hook capture");
+
+        return NULL;
+    }
+
+    PyList_Append(py_capture->hooked, (PyObject*)self);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* py_wipi_timing_replay(py_wipi_timing_t* self, PyObject* args)
+{
+    wipi_capture_hook_t hook;
+    const char*         path;
+    int                 frames;
+
+    if (!PyArg_ParseTuple(args, "s", &path))
+        return NULL;
+
+    hook.fn = wipi_timing_frame;
+    hook.ctx = self->wt;
+
+    Py_BEGIN_ALLOW_THREADS
+    frames = wipi_capture_replay(path, &hook, 1);
+    Py_END_ALLOW_THREADS
+
+    if (frames < 0)
+    {
+        PyErr_Format( PyExc_OSError, "Failed to replay %s - %s", path, errno ? strerror(errno) : "not a radiotap pcap/pcapng file" );
+
+        return NULL;
+    }
+
+    return PyLong_FromLong(frames);
+}
+
+static PyObject* py_wipi_timing_stats(py_wipi_timing_t* self, PyObject* Py_UNUSED(ignored))
+{
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:K,s:K,s:K}",
+                         "bss",             (unsigned long long)self->wt->nbss,
+                         "evicted",         (unsigned long long)self->wt->evicted,
+                         "beacons",         (unsigned long long)self->wt->beacons,
+                         "probe_responses", (unsigned long long)self->wt->probe_resps,
+                         "resolved",        (unsigned long long)self->wt->resolved,
+                         "resets",          (unsigned long long)self->wt->resets,
+                         "clashes",         (unsigned long long)self->wt->clashes);
+}
+
+static PyMethodDef py_wipi_timing_methods[] = {
+    {"watch",    (PyCFunction)py_wipi_timing_watch,    METH_VARARGS, "Track beacon timing and SSIDs from a capture"                },
+    {"replay",   (PyCFunction)py_wipi_timing_replay,   METH_VARARGS, "Track beacon timing and SSIDs in a pcap/pcapng file"         },
+    {"bss",      (PyCFunction)py_wipi_timing_bss,      METH_NOARGS,  "Uptime, missed beacons and TSF resets of each BSSID"         },
+    {"annotate", (PyCFunction)py_wipi_timing_annotate, METH_VARARGS, "Fill in hidden SSIDs on scan results from probe responses"   },
+    {"stats",    (PyCFunction)py_wipi_timing_stats,    METH_NOARGS,  "Tracked BSSIDs, frames seen, resolved SSIDs, resets, clashes"},
+    {NULL}
+};
+
+static PyTypeObject py_wipi_timing_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name      = "wipi.timing",
+    .tp_doc       = "Wipi beacon timing analyser and hidden SSID resolver",
+    .tp_basicsize = sizeof(py_wipi_timing_t),
+    .tp_itemsize  = 0,
+    .tp_flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new       = py_wipi_timing_new,
+    .tp_init      = (initproc)py_wipi_timing_init,
+    .tp_dealloc   = (destructor)py_wipi_timing_dealloc,
+    .tp_methods   = py_wipi_timing_methods,
+};
+
+static void py_wipi_jobs_dealloc(py_wipi_jobs_t* self)
+{
+    Py_BEGIN_ALLOW_THREADS
+    wipi_jobs_free(self->wj);
+    Py_END_ALLOW_THREADS
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* py_wipi_jobs_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    py_wipi_jobs_t* self;
+
+    self = (py_wipi_jobs_t*)type->tp_alloc(type, 0);
+
+    return (PyObject*)self;
+}
+
+static int py_wipi_jobs_init(py_wipi_jobs_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*    kwlist[] = { "max_running", NULL };
+    int             max_running;
+
+    max_running = WIPI_JOBS_RUNNING;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i", kwlist, &max_running))
+        return -1;
+
+    Py_BEGIN_ALLOW_THREADS
+    wipi_jobs_free(self->wj);
+    Py_END_ALLOW_THREADS
+
+    self->wj = wipi_jobs_init(max_running);
+
+    return 0;
+}
+
+static PyObject* py_wipi_job_dict(const wipi_job_t* job)
+{
+    return Py_BuildValue("{s:K,s:s,s:N,s:i,s:i,s:i,s:s,s:N,s:K,s:N}",
+                         "id",        (unsigned long long)job->id,
+                         "interface", job->iface,
+                         "bssid",     py_wipi_mac_str(job->bssid),
+                         "packets",   job->packets,
+                         "delay",     job->delay,
+                         "sent",      job->sent,
+                         "state",     WIPI_JOB_STATE_NAMES[job->state],
+                         "error",     job->state == WIPI_JOB_FAILED ? PyUnicode_FromString(WIPI_STRERRS[job->status]) : (Py_INCREF(Py_None), Py_None),
+                         "start",     (unsigned long long)job->start,
+                         "end",       job->state == WIPI_JOB_RUNNING ? (Py_INCREF(Py_None), Py_None) : PyLong_FromUnsignedLongLong(job->end));
+}
+
+static PyObject* py_wipi_jobs_deauth(py_wipi_jobs_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*        kwlist[] = { "id", "interface", "bssid", "packets", "delay", NULL };
+    unsigned long long  id;
+    const char*         interface, *bssid;
+    wipi_interface_t    wi;
+    uint8_t             addr[WIPI_MAC_LEN];
+    int                 packets, delay, ret;
+
+    packets = delay = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Kss|ii", kwlist, &id, &interface, &bssid, &packets, &delay))
+        return NULL;
+
+    if (wipi_mac_aton(bssid, addr) < 0)
+    {
+        PyErr_Format(PyExc_ValueError, "Invalid BSSID %s", bssid);
+
+        return NULL;
+    }
+
+    if (strlen(interface) >= IFNAMSIZ || if_nametoindex(interface) == 0)
+    {
+        PyErr_Format(PyExc_ValueError, "No such interface %s", interface);
+
+        return NULL;
+    }
+
+    memset( &wi, 0, sizeof(wi) );
+    wi.if_name = (char*)interface;
+
+    Py_BEGIN_ALLOW_THREADS
+    wi.if_mon = wipi_interface_monitor_mode(&wi);
+    ret = wipi_jobs_deauth(self->wj, id, &wi, addr, packets, delay);
+    Py_END_ALLOW_THREADS
+
+    if (ret < 0)
+    {
+        PyErr_SetString(WIPI_ERRNO == WIPI_ERR_BUSY ? PyExc_BlockingIOError : PyExc_ValueError, WIPI_STRERRS[WIPI_ERRNO]);
+
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* py_wipi_jobs_cancel(py_wipi_jobs_t* self, PyObject* args)
+{
+    unsigned long long  id;
+
+    if (!PyArg_ParseTuple(args, "K", &id))
+        return NULL;
+
+    return PyBool_FromLong( wipi_jobs_cancel(self->wj, id) == 0 );
+}
+
+static PyObject* py_wipi_jobs_wait(py_wipi_jobs_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*        kwlist[] = { "id", "timeout", NULL };
+    unsigned long long  id;
+    double              timeout;
+    wipi_job_t          job;
+    int                 ret;
+
+    timeout = -1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "K|d", kwlist, &id, &timeout))
+        return NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    ret = wipi_jobs_wait(self->wj, id, timeout < 0 ? -1 : (int)(timeout * 1000), &job);
+    Py_END_ALLOW_THREADS
+
+    if (ret < 0)
+        Py_RETURN_NONE;
+
+    return py_wipi_job_dict(&job);
+}
+
+static PyObject* py_wipi_jobs_list(py_wipi_jobs_t* self, PyObject* Py_UNUSED(ignored))
+{
+    wipi_job_t* jobs;
+    PyObject*   py_list, *py_job;
+    int         n;
+
+    jobs = (wipi_job_t*)PyMem_Malloc( WIPI_JOBS_MAX * sizeof(wipi_job_t) );
+
+    if (jobs == NULL)
+        return PyErr_NoMemory();
+
+    n = wipi_jobs_list(self->wj, jobs, WIPI_JOBS_MAX);
+    py_list = PyList_New(0);
+
+    for (int i = 0; i < n; i++)
+    {
+        py_job = py_wipi_job_dict(&jobs[i]);
+        PyList_Append(py_list, py_job);
+        Py_DECREF(py_job);
+    }
+
+    PyMem_Free(jobs);
+
+    return py_list;
+}
+
+static PyMethodDef py_wipi_jobs_methods[] = {
+    {"deauth", (PyCFunction)py_wipi_jobs_deauth, METH_VARARGS | METH_KEYWORDS, "Start a deauth job on its own thread"                          },
+    {"cancel", (PyCFunction)py_wipi_jobs_cancel, METH_VARARGS,                 "Stop a running job, False if it is not running"                },
+    {"wait",   (PyCFunction)py_wipi_jobs_wait,   METH_VARARGS | METH_KEYWORDS, "Wait up to timeout seconds for a job to finish and return it"  },
+    {"list",   (PyCFunction)py_wipi_jobs_list,   METH_NOARGS,                  "Running and recently finished jobs"                            },
+    {NULL}
+};
+
+static PyTypeObject py_wipi_jobs_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name      = "wipi.jobs",
+    .tp_doc       = "Wipi job supervisor",
+    .tp_basicsize = sizeof(py_wipi_jobs_t),
+    .tp_itemsize  = 0,
+    .tp_flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new       = py_wipi_jobs_new,
+    .tp_init      = (initproc)py_wipi_jobs_init,
+    .tp_dealloc   = (destructor)py_wipi_jobs_dealloc,
+    .tp_methods   = py_wipi_jobs_methods,
+};
+
+static void py_wipi_snapshot_dealloc(py_wipi_snapshot_t* self)
+{
+    wipi_shm_free(self->shm);
+    wipi_aptable_free(self->table);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* py_wipi_snapshot_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+    py_wipi_snapshot_t* self;
+
+    self = (py_wipi_snapshot_t*)type->tp_alloc(type, 0);
+
+    return (PyObject*)self;
+}
+
+static int py_wipi_snapshot_init(py_wipi_snapshot_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*    kwlist[] = { "name", NULL };
+    const char*     name;
+
+    name = WIPI_SHM_NAME;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|s", kwlist, &name))
+        return -1;
+
+    wipi_shm_free(self->shm);
+    wipi_aptable_free(self->table);
+
+    self->table = wipi_aptable_init(0);
+    self->generation = 0;
+
+    if ((self->shm = wipi_shm_open(name)) == NULL)
+    {
+        PyErr_Format(WIPI_ERRNO == WIPI_ERR_IO ? PyExc_FileNotFoundError : PyExc_ValueError,
+                     "Could not map snapshot %s (%s)", name, WIPI_STRERRS[WIPI_ERRNO]);
+
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Counters and histograms as wipi.stats() returns them */
+static PyObject* py_wipi_stats_from(const wipi_stats_t* st)
+{
+    PyObject*   py_dict, *py_counters, *py_hists, *py_hist, *py_buckets, *py_item;
+
+    py_dict     = PyDict_New();
+    py_counters = PyDict_New();
+    py_hists    = PyDict_New();
+
+    for (int i = 0; i < WIPI_STAT_COUNTERS; i++)
+    {
+        py_item = PyLong_FromUnsignedLongLong(st->counters[i]);
+        PyDict_SetItemString(py_counters, WIPI_STAT_NAMES[i], py_item);
+        Py_DECREF(py_item);
+    }
+
+    for (int i = 0; i < WIPI_HISTS; i++)
+    {
+        py_hist    = PyDict_New();
+        py_buckets = PyList_New(WIPI_HIST_BUCKETS);
+
+        for (int j = 0; j < WIPI_HIST_BUCKETS; j++)
+            PyList_SET_ITEM(py_buckets, j, Py_BuildValue("(dK)",
+                                                         wipi_stats_bucket_bound(j),
+                                                         (unsigned long long)st->hists[i].buckets[j]));
+
+        PyDict_SetItemString(py_hist, "buckets", py_buckets);
+        Py_DECREF(py_buckets);
+
+        py_item = PyLong_FromUnsignedLongLong(st->hists[i].count);
+        PyDict_SetItemString(py_hist, "count", py_item);
+        Py_DECREF(py_item);
+
+        py_item = PyFloat_FromDouble((double)st->hists[i].sum_ns / 1000000000.0);
+        PyDict_SetItemString(py_hist, "sum", py_item);
+        Py_DECREF(py_item);
+
+        PyDict_SetItemString(py_hists, WIPI_HIST_NAMES[i], py_hist);
+        Py_DECREF(py_hist);
+    }
+
+    PyDict_SetItemString(py_dict, "counters", py_counters);
+    PyDict_SetItemString(py_dict, "histograms", py_hists);
+    Py_DECREF(py_counters);
+    Py_DECREF(py_hists);
+
+    return py_dict;
+}
+
+static const wipi_shm_buf_t* py_wipi_snapshot_get(py_wipi_snapshot_t* self)
+{
+    const wipi_shm_buf_t*   buf;
+
+    if (self->shm == NULL)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Snapshot not open");
+
+        return NULL;
+    }
+
+    if ((buf = wipi_shm_snapshot(self->shm)) == NULL)
+        PyErr_SetString(PyExc_BlockingIOError, "Snapshot kept changing while being read");
+
+    return buf;
+}
+
+static void py_wipi_snapshot_beacon(const wipi_shm_ap_t* ap, wipi_beacon_t* wb)
+{
+    memset( wb, 0, sizeof(wipi_beacon_t) );
+
+    memcpy(wb->ssid, ap->ssid, WIPI_MAX_SSID);
+    memcpy(wb->stats, ap->stats, WIPI_MAX_STATS - 1);
+    memcpy(wb->addr, ap->addr, WIPI_MAC_LEN);
+
+    snprintf(wb->bssid,
+             sizeof(wb->bssid),
+             "%02X:%02X:%02X:%02X:%02X:%02X",
+             ap->addr[0], ap->addr[1], ap->addr[2], ap->addr[3], ap->addr[4], ap->addr[5]);
+
+    wb->freq_mhz = ap->freq_mhz;
+    wb->freq = (double)ap->freq_mhz / 1000;
+    wb->band = ap->band;
+    wb->db = ap->db;
+    wb->qual = ap->qual;
+    wb->channel = ap->channel;
+    wb->caps = ap->caps;
+    wb->radio = ap->radio;
+    wb->radios = ap->radios;
+    wb->seen = ap->seen;
+}
+
+static PyObject* py_wipi_snapshot_aps(py_wipi_snapshot_t* self, PyObject* Py_UNUSED(ignored))
+{
+    const wipi_shm_buf_t*   buf;
+    const wipi_shm_ap_t*    ap;
+    const char*             radios[WIPI_SHM_RADIOS];
+    wipi_beacon_t           wb;
+    py_wipi_beacon_t*       py_beacon;
+    PyObject*               py_list;
+    uint32_t                count;
+
+    if ((buf = py_wipi_snapshot_get(self)) == NULL)
+        return NULL;
+
+    for (uint32_t i = 0; i < self->shm->hdr->nradios; i++)
+        radios[i] = self->shm->hdr->radios[i];
+
+    ap = (const wipi_shm_ap_t*)wipi_shm_section(buf, WIPI_SHM_APS, &count);
+    py_list = PyList_New(0);
+
+    for (uint32_t i = 0; i < count; i++, ap++)
+    {
+        py_wipi_snapshot_beacon(ap, &wb);
+
+        py_beacon = py_wipi_beacon_from(&wb, radios, self->shm->hdr->nradios);
+
+        PyList_Append(py_list, (PyObject*)py_beacon);
+        Py_DECREF(py_beacon);
+    }
+
+    return py_list;
+}
+
+static PyObject* py_wipi_snapshot_interfaces(py_wipi_snapshot_t* self, PyObject* Py_UNUSED(ignored))
+{
+    const wipi_shm_buf_t*   buf;
+    const wipi_shm_if_t*    wi;
+    py_wipi_interface_t*    py_interface;
+    PyObject*               py_list;
+    uint32_t                count;
+
+    if ((buf = py_wipi_snapshot_get(self)) == NULL)
+        return NULL;
+
+    wi = (const wipi_shm_if_t*)wipi_shm_section(buf, WIPI_SHM_IFACES, &count);
+    py_list = PyList_New(0);
+
+    for (uint32_t i = 0; i < count; i++, wi++)
+    {
+        py_interface = (py_wipi_interface_t*)py_wipi_interface_new(&py_wipi_interface_type, NULL, NULL);
+        py_wipi_interface_init(py_interface, NULL, NULL);
+
+        py_interface->name         = PyUnicode_FromStringAndSize(wi->name, strnlen(wi->name, IFNAMSIZ));
+        py_interface->addr         = PyUnicode_FromStringAndSize(wi->addr, strnlen(wi->addr, INET_ADDRSTRLEN));
+        py_interface->mask         = PyUnicode_FromStringAndSize(wi->mask, strnlen(wi->mask, INET_ADDRSTRLEN));
+        py_interface->flags        = PyLong_FromUnsignedLong(wi->flags);
+        py_interface->monitor_mode = wi->mon ? Py_True : Py_False;
+
+        PyList_Append(py_list, (PyObject*)py_interface);
+        Py_DECREF(py_interface);
+    }
+
+    return py_list;
+}
+
+/* Load each generation into the table once, the indexes follow on the first query */
+static struct __wipi_aptable_t* py_wipi_snapshot_load(py_wipi_snapshot_t* self)
+{
+    const wipi_shm_buf_t*   buf;
+    const wipi_shm_ap_t*    ap;
+    wipi_beacon_t           wb;
+    uint32_t                count;
+
+    if ((buf = py_wipi_snapshot_get(self)) == NULL)
+        return NULL;
+
+    if (buf->generation != self->generation)
+    {
+        wipi_aptable_clear(self->table);
+
+        ap = (const wipi_shm_ap_t*)wipi_shm_section(buf, WIPI_SHM_APS, &count);
+
+        for (uint32_t i = 0; i < count; i++, ap++)
+        {
+            py_wipi_snapshot_beacon(ap, &wb);
+            wipi_aptable_merge(self->table, &wb, WIPI_MERGE_RECENT);
+        }
+
+        self->generation = buf->generation;
+    }
+
+    return self->table;
+}
+
+static PyObject* py_wipi_snapshot_query(py_wipi_snapshot_t* self, PyObject* args, PyObject* kwds)
+{
+    const char*             radios[WIPI_SHM_RADIOS];
+    wipi_query_t            q;
+
+    if (self->shm == NULL)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Snapshot not open");
+
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < self->shm->hdr->nradios; i++)
+        radios[i] = self->shm->hdr->radios[i];
+
+    if (py_wipi_query_parse(args, kwds, &q, radios, self->shm->hdr->nradios) < 0 || py_wipi_snapshot_load(self) == NULL)
+        return NULL;
+
+    return py_wipi_query_run(self->table, &q, radios, self->shm->hdr->nradios);
+}
+
+static PyObject* py_wipi_snapshot_body(py_wipi_snapshot_t* self, PyObject* args, PyObject* kwds)
+{
+    static char*            kwlist[] = { "table", "format", NULL };
+    const wipi_shm_buf_t*   buf;
+    const char*             table, *format;
+    const void*             body;
+    int                     fmt, sect;
+
+    format = WIPI_ENC_NAMES[WIPI_ENC_JSON];
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|s", kwlist, &table, &format))
+        return NULL;
+
+    for (fmt = 0; fmt < WIPI_ENCS && strcmp(format, WIPI_ENC_NAMES[fmt]); fmt++)
+        ;
+
+    if (fmt == WIPI_ENCS || (strcmp(table, "aps") && strcmp(table, "interfaces")))
+    {
+        PyErr_SetString(PyExc_ValueError, "Expected 'aps' or 'interfaces' as 'json' or 'msgpack'");
+
+        return NULL;
+    }
+
+    if ((buf = py_wipi_snapshot_get(self)) == NULL)
+        return NULL;
+
+    sect = (strcmp(table, "aps") ? WIPI_SHM_IFACES_BODY : WIPI_SHM_APS_BODY) + fmt;
+
+    /* Did not fit at publish time */
+    if (buf->sections[sect].len == 0)
+        Py_RETURN_NONE;
+
+    body = wipi_shm_section(buf, (WIPI_SHM_SECTION)sect, NULL);
+
+    return PyBytes_FromStringAndSize((const char*)body, buf->sections[sect].len);
+}
+
+static PyObject* py_wipi_snapshot_info(py_wipi_snapshot_t* self, PyObject* Py_UNUSED(ignored))
+{
+    const wipi_shm_buf_t*   buf;
+    struct timespec         ts;
+    PyObject*               py_radios, *py_name, *py_cadence, *py_decisions, *py_count;
+    double                  age, max_age;
+
+    if ((buf = py_wipi_snapshot_get(self)) == NULL)
+        return NULL;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    age = buf->generation ? ((double)ts.tv_sec + ts.tv_nsec / 1e9) - (double)buf->published / 1e9 : -1;
+
+    /* The next sweep is due an interval after this one, allow one to be missed and the next to time out */
+    max_age = (2.0 * buf->cadence.interval_ms + WIPI_SCAN_TIMEOUT_MS) / 1000;
+    py_radios = PyList_New(0);
+
+    for (uint32_t i = 0; i < self->shm->hdr->nradios; i++)
+    {
+        py_name = PyUnicode_FromStringAndSize(self->shm->hdr->radios[i], strnlen(self->shm->hdr->radios[i], IFNAMSIZ));
+        PyList_Append(py_radios, py_name);
+        Py_DECREF(py_name);
+    }
+
+    py_decisions = PyDict_New();
+
+    for (int d = 0; d < WIPI_CADENCE_DECISIONS; d++)
+    {
+        py_count = PyLong_FromUnsignedLongLong(buf->cadence.decisions[d]);
+        PyDict_SetItemString(py_decisions, WIPI_CADENCE_NAMES[d], py_count);
+        Py_DECREF(py_count);
+    }
+
+    py_cadence = Py_BuildValue("{s:I,s:I,s:I,s:I,s:I,s:d,s:d,s:I,s:s,s:N}",
+                               "interval",  buf->cadence.interval_ms,
+                               "min",       buf->cadence.min_ms,
+                               "max",       buf->cadence.max_ms,
+                               "added",     buf->cadence.added,
+                               "lost",      buf->cadence.lost,
+                               "rssi_rms",  (double)buf->cadence.rssi_rms,
+                               "churn",     (double)buf->cadence.churn,
+                               "failures",  buf->cadence.failures,
+                               "decision",  WIPI_CADENCE_NAMES[buf->cadence.decision % WIPI_CADENCE_DECISIONS],
+                               "decisions", py_decisions);
+
+    return Py_BuildValue("{s:K,s:d,s:d,s:d,s:i,s:N,s:I,s:I,s:N}",
+                         "generation", (unsigned long long)buf->generation,
+                         "published",  (double)buf->published / 1e9,
+                         "age",        age,
+                         "max_age",    max_age,
+                         "pid",        (int)self->shm->hdr->pid,
+                         "radios",     py_radios,
+                         "aps",        buf->sections[WIPI_SHM_APS].count,
+                         "interfaces", buf->sections[WIPI_SHM_IFACES].count,
+                         "cadence",    py_cadence);
+}
+
+static PyObject* py_wipi_snapshot_stats(py_wipi_snapshot_t* self, PyObject* Py_UNUSED(ignored))
+{
+    const wipi_shm_buf_t*   buf;
+
+    if ((buf = py_wipi_snapshot_get(self)) == NULL)
+        return NULL;
+
+    return py_wipi_stats_from(&buf->stats);
+}
+
+static PyMethodDef py_wipi_snapshot_methods[] = {
+    {"aps",        (PyCFunction)py_wipi_snapshot_aps,        METH_NOARGS,                  "Access points from the latest published scan"                },
+    {"query",      (PyCFunction)py_wipi_snapshot_query,      METH_VARARGS | METH_KEYWORDS, "Filter, sort and page the latest scan, returns (total, page)"},
+    {"interfaces", (PyCFunction)py_wipi_snapshot_interfaces, METH_NOARGS,                  "Network interfaces as last seen by the sensor daemon"        },
+    {"body",       (PyCFunction)py_wipi_snapshot_body,       METH_VARARGS | METH_KEYWORDS, "Response body encoded at publish time, None if it did not fit"},
+    {"info",       (PyCFunction)py_wipi_snapshot_info,       METH_NOARGS,                  "Generation, age, radios and cadence of the latest snapshot"  },
+    {"stats",      (PyCFunction)py_wipi_snapshot_stats,      METH_NOARGS,                  "The sensor daemon's counters and latency histograms"         },
+    {NULL}
+};
+
+static PyTypeObject py_wipi_snapshot_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name      = "wipi.snapshot",
+    .tp_doc       = "Wipi sensor daemon snapshot reader",
+    .tp_basicsize = sizeof(py_wipi_snapshot_t),
+    .tp_itemsize  = 0,
+    .tp_flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new       = py_wipi_snapshot_new,
+    .tp_init      = (initproc)py_wipi_snapshot_init,
+    .tp_dealloc   = (destructor)py_wipi_snapshot_dealloc,
+    .tp_methods   = py_wipi_snapshot_methods,
+};
+
+static PyObject* py_wipi_get_interfaces(PyObject* self, PyObject* args, PyObject* kwds)
+{
+    int                     sa_family;
+    wipi_interface_t*       wi;
+    PyObject*               py_sa_family, *py_list;
+    py_wipi_interface_t*    py_interface;
+
+    if (!PyArg_ParseTuple(args, "O", &py_sa_family))
+    {
+        PyErr_SetString(PyExc_Exception, "Integer parameter required");
+
+        return NULL;
+    }
+
+    sa_family = PyLong_AsLong(py_sa_family);
+
+    py_list = PyList_New(0);
+
+    wi = wipi_get_interfaces(sa_family);
+
+    for (wi = wi; wi->next; wi = wi->next)
+    {
+        py_interface = (py_wipi_interface_t*)py_wipi_interface_new(&py_wipi_interface_type, NULL, NULL);
+        py_wipi_interface_init(py_interface, NULL, NULL);
+
+        py_interface->name         = PyUnicode_FromString(wi->if_name);
+        py_interface->addr         = PyUnicode_FromString(wi->if_addr);
+        py_interface->mask         = PyUnicode_FromString(wi->if_mask);
+        py_interface->flags        = PyLong_FromLong(wi->if_flags);
+        py_interface->monitor_mode = wi->if_mon ? Py_True : Py_False;
+
+        PyList_Append(py_list, (PyObject*)py_interface);
+    }
+
+    return py_list;
+}
+
+static PyObject* py_wipi_stats(PyObject* self, PyObject* Py_UNUSED(ignored))
+{
+    wipi_stats_t    st;
+
+    Py_BEGIN_ALLOW_THREADS
+    wipi_stats_snapshot(&st);
+    Py_END_ALLOW_THREADS
+
+    return py_wipi_stats_from(&st);
+}
+
+static PyObject* py_wipi_bpf_compile(PyObject* self, PyObject* args)
+{
+    wipi_bpf_t* bpf;
+    const char* expr;
+    PyObject*   py_list;
+
+    if (!PyArg_ParseTuple(args, "s", &expr))
+        return NULL;
+
+    bpf = (wipi_bpf_t*)PyMem_Malloc( sizeof(wipi_bpf_t) );
+
+    if (bpf == NULL)
+        return PyErr_NoMemory();
+
+    if (wipi_bpf_compile(bpf, expr) < 0)
+    {
+        PyMem_Free(bpf);
+        PyErr_Format(PyExc_ValueError, "Invalid filter expression '%s'", expr);
+
+        return NULL;
+    }
+
+    py_list = PyList_New(bpf->ninsns);
+
+    for (int i = 0; i < bpf->ninsns; i++)
+        PyList_SET_ITEM(py_list, i, Py_BuildValue("(HBBI)",
+                                                  bpf->insns[i].code,
+                                                  bpf->insns[i].jt,
+                                                  bpf->insns[i].jf,
+                                                  bpf->insns[i].k));
+
+    PyMem_Free(bpf);
+
+    return py_list;
+}
+
+static PyObject* py_wipi_oui(PyObject* self, PyObject* args)
+{
+    const char* mac, *vendor;
+    uint8_t     addr[WIPI_MAC_LEN];
+
+    if (!PyArg_ParseTuple(args, "s", &mac))
+        return NULL;
+
+    if (wipi_mac_aton(mac, addr) < 0)
+    {
+        PyErr_Format(PyExc_ValueError, "Invalid MAC address %s", mac);
+
+        return NULL;
+    }
+
+    if ((vendor = wipi_oui_lookup(addr)) == NULL)
+        Py_RETURN_NONE;
+
+    return PyUnicode_DecodeUTF8(vendor, strlen(vendor), "replace");
 }
 
 static PyMethodDef py_wipi_methods[] = {
     {"get_interfaces", (PyCFunction)py_wipi_get_interfaces, METH_VARARGS, "List current network interfaces with specified SA family type"},
     {"deauth",         (PyCFunction)py_wipi_deauth,         METH_VARARGS, "Deauth a BSSID from the root module"},
+    {"stats",          (PyCFunction)py_wipi_stats,          METH_NOARGS,  "Snapshot the library counters and latency histograms"},
+    {"bpf_compile",    (PyCFunction)py_wipi_bpf_compile,    METH_VARARGS, "Compile a monitor socket filter expression to classic BPF"},
+    {"oui",            (PyCFunction)py_wipi_oui,            METH_VARARGS, "Look up the manufacturer of a MAC address in the OUI registry"},
     {NULL}
 };
 
@@ -465,6 +2835,14 @@ PyMODINIT_FUNC PyInit_wipi(void)
     PyObject*   m;
 
     if (PyType_Ready(&py_wipi_scanner_type) < 0 ||
+        PyType_Ready(&py_wipi_scanner_group_type) < 0 ||
+        PyType_Ready(&py_wipi_capture_type) < 0 ||
+        PyType_Ready(&py_wipi_rogue_type) < 0 ||
+        PyType_Ready(&py_wipi_flood_type) < 0 ||
+        PyType_Ready(&py_wipi_airtime_type) < 0 ||
+        PyType_Ready(&py_wipi_timing_type) < 0 ||
+        PyType_Ready(&py_wipi_jobs_type) < 0 ||
+        PyType_Ready(&py_wipi_snapshot_type) < 0 ||
         PyType_Ready(&py_wipi_beacon_type) < 0 ||
         PyType_Ready(&py_wipi_interface_type) < 0)
         return NULL;
@@ -475,14 +2853,38 @@ PyMODINIT_FUNC PyInit_wipi(void)
         return NULL;
 
     Py_INCREF(&py_wipi_scanner_type);
+    Py_INCREF(&py_wipi_scanner_group_type);
+    Py_INCREF(&py_wipi_capture_type);
+    Py_INCREF(&py_wipi_rogue_type);
+    Py_INCREF(&py_wipi_flood_type);
+    Py_INCREF(&py_wipi_airtime_type);
+    Py_INCREF(&py_wipi_timing_type);
+    Py_INCREF(&py_wipi_jobs_type);
+    Py_INCREF(&py_wipi_snapshot_type);
     Py_INCREF(&py_wipi_beacon_type);
     Py_INCREF(&py_wipi_interface_type);
 
     if (PyModule_AddObject(m, "scanner", (PyObject*)&py_wipi_scanner_type) < 0 ||
+        PyModule_AddObject(m, "scanner_group", (PyObject*)&py_wipi_scanner_group_type) < 0 ||
+        PyModule_AddObject(m, "capture", (PyObject*)&py_wipi_capture_type) < 0 ||
+        PyModule_AddObject(m, "rogue", (PyObject*)&py_wipi_rogue_type) < 0 ||
+        PyModule_AddObject(m, "flood", (PyObject*)&py_wipi_flood_type) < 0 ||
+        PyModule_AddObject(m, "airtime", (PyObject*)&py_wipi_airtime_type) < 0 ||
+        PyModule_AddObject(m, "timing", (PyObject*)&py_wipi_timing_type) < 0 ||
+        PyModule_AddObject(m, "jobs", (PyObject*)&py_wipi_jobs_type) < 0 ||
+        PyModule_AddObject(m, "snapshot", (PyObject*)&py_wipi_snapshot_type) < 0 ||
         PyModule_AddObject(m, "beacon", (PyObject*)&py_wipi_beacon_type) < 0 ||
         PyModule_AddObject(m, "interface", (PyObject*)&py_wipi_interface_type) < 0)
     {
         Py_DECREF(&py_wipi_scanner_type);
+        Py_DECREF(&py_wipi_scanner_group_type);
+        Py_DECREF(&py_wipi_capture_type);
+        Py_DECREF(&py_wipi_rogue_type);
+        Py_DECREF(&py_wipi_flood_type);
+        Py_DECREF(&py_wipi_airtime_type);
+        Py_DECREF(&py_wipi_timing_type);
+        Py_DECREF(&py_wipi_jobs_type);
+        Py_DECREF(&py_wipi_snapshot_type);
         Py_DECREF(&py_wipi_beacon_type);
         Py_DECREF(&py_wipi_interface_type);
         Py_DECREF(m);
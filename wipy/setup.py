@@ -1,12 +1,26 @@
 #!/usr/bin/env python3
 
 from distutils.core import setup, Extension
+import glob, subprocess, sys
+
+# The OUI vendor table is generated, from the ieee-data registries when installed, else empty
+subprocess.check_call([sys.executable, "../src/wipi_oui_gen.py", "-o", "../src/wipi_oui_db.h"] +
+	[f for f in glob.glob("/usr/share/ieee-data/*") if f.rsplit("/", 1)[-1] in ("oui.csv", "mam.csv", "oui36.csv", "iab.csv")])
 
 setup(name="wipi", version="1.0.0",
 	ext_modules=[
 		Extension(
-			"wipi", ["pywipi.c", "../src/wipi.c"],
-			extra_link_args=["-liw"],
+			"wipi", ["pywipi.c", "../src/wipi.c", "../src/wipi_stats.c",
+				"../src/wipi_aptable.c", "../src/wipi_group.c",
+				"../src/wipi_ie.c", "../src/wipi_frame.c",
+				"../src/wipi_bpf.c", "../src/wipi_pcapng.c",
+				"../src/wipi_capture.c", "../src/wipi_rogue.c",
+				"../src/wipi_flood.c",
+				"../src/wipi_airtime.c", "../src/wipi_job.c",
+				"../src/wipi_oui.c", "../src/wipi_shm.c",
+				"../src/wipi_enc.c", "../src/wipi_cadence.c",
+				"../src/wipi_timing.c"],
+			extra_link_args=["-liw", "-lpthread", "-lm", "-lrt"],
 			include_dirs=["../src"],
             extra_compile_args=["-Wno-unused-function", "-Wno-unused-variable"]
 		)
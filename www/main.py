@@ -1,18 +1,255 @@
 #!/usr/bin/env python3
 
-import wipi, os, re, time, multiprocessing
+import wipi, os, re, time, asyncio
 from wiapi import wiapi, Request
 from wiapi.auth import WiapiJWT, wraps, auth_required as wiapi_auth_required
 from wiapi.models import *
 from wiapi.db import *
 from wiapi.exceptions import WiapiHTTPException
+from wiapi.metrics import wiapi_prometheus, wiapi_prometheus_cadence, PROMETHEUS_CONTENT_TYPE
+from fastapi.responses import Response
+
+# Any number of uvicorn workers can serve these. What one worker runs (jobs,
+# captures and the detectors they feed) is shared with the others through the
+# database, see wiapi_sync()
+WIAPI_MAX_JOBS = int(os.environ.get('WIPI_MAX_JOBS', 4))
+
+captures = {}
+rogue = wipi.rogue(os.environ.get('WIPI_ALLOW_LIST'))
+flood = wipi.flood()
+airtime = wipi.airtime()
+timing = wipi.timing()
+jobs = wipi.jobs(WIAPI_MAX_JOBS)
+job_tasks = set()
+snapshot = None
+snapshot_info = None
+snapshot_checked = None
+shared = { 'allow': 0, 'rogue': 0, 'flood': 0, 'published': False }
+
+CAPTURE_ROOT = os.path.realpath(os.environ.get('WIPI_CAPTURE_ROOT', '/var/lib/wipi/captures'))
+
+
+WIAPI_SCAN_ALL = {
+    'ssid': None,
+    'match': 'prefix',
+    'bssid': None,
+    'band': None,
+    'channel': 0,
+    'security': None,
+    'sort': 'none',
+    'order': 'asc',
+    'offset': 0,
+    'limit': 0
+}
+
+def wiapi_snapshot_owner(info):
+    # A segment left behind by a daemon that has exited owns nothing
+    try:
+        os.kill(info['pid'], 0)
+    except ProcessLookupError:
+        return False
+    except PermissionError:
+        pass
+
+    return True
+
+def wiapi_snapshot():
+    global snapshot, snapshot_info
+
+    stale = None
+
+    # Re-map if the sensor daemon was restarted (a new segment) or has stopped publishing
+    for _ in range(2):
+        if snapshot is None:
+            try:
+                snapshot = wipi.snapshot(os.environ.get('WIPI_SHM', '/wipi'))
+            except (FileNotFoundError, ValueError):
+                break
+
+        try:
+            info = snapshot.info()
+        except BlockingIOError:
+            # Mid-publish: the radios it last claimed are still the daemon's, never scan them here
+            if snapshot_info is not None and wiapi_snapshot_owner(snapshot_info):
+                return None, snapshot_info
+
+            raise WiapiHTTPException(
+                status_code=503,
+                detail='Sensor daemon snapshot is being rewritten, try again'
+            )
+
+        snapshot_info = info
+
+        # Freshness follows the daemon's own cadence, see snapshot.info()
+        if 0 <= info['age'] <= info['max_age']:
+            return snapshot, info
+
+        stale = info if wiapi_snapshot_owner(info) else None
+        snapshot = None
+
+    # No usable sweep, but a live daemon still holds its radios
+    return None, stale
+
+def wiapi_capture_path(directory, prefix):
+    # Recordings stay under the capture root, a request only picks a directory below it
+    if not prefix or '..' in prefix or not re.fullmatch(r'[A-Za-z0-9_.-]+', prefix):
+        raise ValueError('prefix must be a plain file name')
+
+    path = os.path.realpath(os.path.join(CAPTURE_ROOT, directory.lstrip('/')))
+
+    if os.path.commonpath([path, CAPTURE_ROOT]) != CAPTURE_ROOT:
+        raise ValueError('directory must be inside the capture root')
+
+    os.makedirs(path, mode=0o750, exist_ok=True)
+
+    return path
+
+def wiapi_body_format(request):
+    # Pre-encoded snapshot bodies come in JSON and MessagePack, pick from the Accept header
+    accept = request.headers.get('accept', '').lower()
+
+    if any(t in accept for t in ('application/msgpack', 'application/x-msgpack', 'application/vnd.msgpack')):
+        return 'msgpack', 'application/msgpack'
+
+    return 'json', 'application/json'
+
+def wiapi_job_dict(row, live=None):
+    id, iface, bssid, start, packets, delay, complete, sent, state = row[:9]
+    owner = row[9] if len(row) > 9 else None
+
+    job = {
+        'id': id,
+        'interface': iface,
+        'bssid': bssid,
+        'start': start,
+        'packets': packets,
+        'delay': delay,
+        'sent': sent or 0,
+        'state': state or ('done' if complete else 'unknown'),
+        'complete': bool(complete)
+    }
+
+    if live is not None:
+        job.update(sent=live['sent'], state=live['state'], complete=live['state'] != 'running')
+    elif job['state'] == 'running' and (owner == os.getpid() or not wiapi_alive(owner)):
+        job['state'] = 'lost'   # its worker has exited, or never wrote back how it ended
+
+    return job
+
+async def wiapi_track_job(id):
+    wb = WiapiDatabase()
+
+    # Write progress back once a second until the job finishes, and pass on a
+    # cancel requested through any worker
+    while True:
+        job = await asyncio.to_thread(jobs.wait, id, 1.0)
+
+        if job is None:
+            return
+
+        wb.update_job(id, job['sent'], job['state'], job['state'] != 'running')
+
+        if job['state'] != 'running':
+            return
+
+        row = wb.get_job(id)
+
+        if row and row[0][10]:
+            jobs.cancel(id)
+
+def wiapi_merge(local, others, key, weight):
+    # One record per key across workers, the one built from the most frames wins
+    merged = { r[key]: r for r in local }
+
+    for records in others:
+        for r in records:
+            if r[key] not in merged or r[weight] > merged[r[key]][weight]:
+                merged[r[key]] = r
+
+    return list(merged.values())
+
+def wiapi_merge_stats(local, others, last_id=None):
+    stats = dict(local)
+
+    for other in others:
+        for name, value in other.items():
+            if isinstance(value, int) and not isinstance(value, bool) and name in stats:
+                stats[name] = max(stats[name], value) if name == 'seconds' else stats[name] + value
+
+    if last_id is not None:
+        stats['last_id'] = last_id
+
+    return stats
+
+def wiapi_share_alerts(wb):
+    # Alerts take a shared id as they are copied over, so since= pages across workers
+    for kind, detector in (('rogue', rogue), ('flood', flood)):
+        alerts = detector.alerts(shared[kind])
+
+        if alerts:
+            shared[kind] = alerts[-1]['id']
+            wb.add_alerts(kind, [{ k: v for k, v in a.items() if k != 'id' } for a in alerts])
+
+def wiapi_apply_allow(wb):
+    for id, bssid, ssid, security, channel in wb.get_allow(shared['allow']):
+        try:
+            rogue.allow(bssid, ssid, security, channel)
+        except ValueError:
+            pass
+
+        shared['allow'] = id
+
+def wiapi_publish(wb):
+    wb.publish('rogue', rogue.stats())
+    wb.publish('flood', flood.stats())
+
+    # Only captures feed airtime and timing, an idle worker publishes them once more and stops
+    if not captures and shared['published']:
+        return
+
+    wb.publish('airtime', { 'channels': airtime.channels(), 'bss': airtime.bss(), 'stats': airtime.stats() })
+    wb.publish('timing', { 'bss': timing.bss(), 'stats': timing.stats() })
+
+    shared['published'] = not captures
+
+async def wiapi_sync_captures(wb):
+    for iface, c in list(captures.items()):
+        row = wb.get_capture(iface)
+
+        # A stop request from another worker
+        if row is None or row[4] == 1:
+            captures.pop(iface, None)
+            await asyncio.to_thread(c.stop)
+
+            wb.update_capture(iface, c.stats(), stop=2)
+        else:
+            wb.update_capture(iface, c.stats())
+
+async def wiapi_sync():
+    wb = WiapiDatabase()
+
+    while True:
+        try:
+            wiapi_apply_allow(wb)
+            await wiapi_sync_captures(wb)
+            wiapi_share_alerts(wb)
+            wiapi_publish(wb)
+        except Exception:
+            pass    # the database is busy, try again next round
+
+        await asyncio.sleep(1.0)
+
+@wiapi.on_event('startup')
+async def wiapi_startup():
+    task = asyncio.create_task(wiapi_sync())
+    job_tasks.add(task)
 
 def wiapi_verify_interface(func):
     @wraps(func)
 
     async def wrapper(*args, **kwargs):
         try:
-            interface = kwargs[list(filter(lambda i: type(kwargs[i]) == WiapiInterface or type(kwargs[i]) == WiapiDeauth, kwargs.keys()))[0]]
+            interface = kwargs[list(filter(lambda i: type(kwargs[i]) in (WiapiInterface, WiapiDeauth, WiapiCapture), kwargs.keys()))[0]]
 
             ifaces = wipi.get_interfaces(17)
 
@@ -73,9 +310,56 @@ async def _whoami(request: Request) -> WiapiResponse:
         data={ 'message': raw_token }
     )
 
+@wiapi.get('/metrics')
+@wiapi_auth_required
+async def _metrics(request: Request) -> Response:
+    content = wiapi_prometheus(wipi.stats())
+    snap, info = wiapi_snapshot()
+    wb = WiapiDatabase()
+
+    # Scans are scheduled and timed by the sensor daemon, report its cadence and stats when there is one
+    if info is not None:
+        content += wiapi_prometheus_cadence(info['cadence'])
+
+    if snap is not None:
+        content += wiapi_prometheus(snap.stats(), prefix='wipi_sensord_')
+
+    return Response(
+        content=content,
+        media_type=PROMETHEUS_CONTENT_TYPE
+    )
+
 @wiapi.get('/interfaces')
 @wiapi_auth_required
 async def _interfaces(request: Request) -> WiapiResponse:
+    snap, _ = wiapi_snapshot()
+
+    if snap is not None:
+        fmt, media_type = wiapi_body_format(request)
+        body = snap.body('interfaces', fmt)
+
+        # Encoded once when the sensor daemon published, fall through if it did not fit
+        if body is not None:
+            return Response(content=body, media_type=media_type)
+
+        iface_list = [
+            {
+                iface.name: {
+                    'addr': iface.addr or None,
+                    'mask': iface.mask or None,
+                    'flags': iface.flags,
+                    'monitor_mode': iface.monitor_mode
+                }
+            }
+
+            for iface in snap.interfaces()
+        ]
+
+        return WiapiResponse(
+            success=True,
+            data={ 'message': iface_list }
+        )
+
     sa_family = 2
 
     con_ifaces = wipi.get_interfaces(sa_family) # AF_INET
@@ -108,9 +392,9 @@ async def _interfaces(request: Request) -> WiapiResponse:
     )
 
 @wiapi.post('/interfaces/monitor_mode')
-@wiapi_auth_required
+@wiapi_auth_required(admin=True)
 @wiapi_verify_interface
-async def _interfaces_monitor_mode(request: Request, interface: WiapiInterface, admin_required=True) -> WiapiResponse:
+async def _interfaces_monitor_mode(request: Request, interface: WiapiInterface) -> WiapiResponse:
     res = os.system("scripts/monitor_mode.sh {} {}".format("start" if interface.active else "stop", interface.interface))
 
     if res != 0:
@@ -122,9 +406,9 @@ async def _interfaces_monitor_mode(request: Request, interface: WiapiInterface,
     return WiapiResponse()
 
 @wiapi.post('/interfaces/deauth')
-@wiapi_auth_required
+@wiapi_auth_required(admin=True)
 @wiapi_verify_interface
-async def _interfaces_deauth(request: Request, deauth: WiapiDeauth, admin_required=True) -> WiapiResponse:
+async def _interfaces_deauth(request: Request, deauth: WiapiDeauth) -> WiapiResponse:
     iface = list(filter(lambda i: i.name == deauth.interface, wipi.get_interfaces(17)))[0]
 
     os.system("iwconfig {} channel {}".format(deauth.interface, deauth.channel)) # @wipi_verify_interface prevent cmd injection
@@ -148,18 +432,43 @@ async def _interfaces_deauth(request: Request, deauth: WiapiDeauth, admin_requir
     wb = WiapiDatabase()
 
     try:
-        p = multiprocessing.Process(target=wipi.deauth, args=(deauth.interface, bssid, deauth.packets, deauth.delay,))
-        p.start()
-
-        job = wb.add_job(deauth.interface, bssid, int(time.time()), deauth.packets, deauth.delay)
+        job = wb.add_job(deauth.interface, bssid, int(time.time()), deauth.packets, deauth.delay, max_jobs=WIAPI_MAX_JOBS)
     except Exception as e:
         raise WiapiHTTPException(
             status_code=500,
             detail="Database job failed ({})".format(str(e))
         )
 
+    # The cap counts jobs running in every worker
+    if not job:
+        raise WiapiHTTPException(
+            status_code=429,
+            detail='Too many jobs running'
+        )
+
     job = job[0]
-    id, iface, bssid, start, packets, delay, _ = job
+    id, iface, bssid, start, packets, delay = job[:6]
+
+    try:
+        await asyncio.to_thread(jobs.deauth, id, iface, bssid, packets, delay)
+    except BlockingIOError:
+        wb.update_job(id, 0, 'failed', True)
+
+        raise WiapiHTTPException(
+            status_code=429,
+            detail='Too many jobs running'
+        )
+    except ValueError as e:
+        wb.update_job(id, 0, 'failed', True)
+
+        raise WiapiHTTPException(
+            status_code=400,
+            detail="Could not start job ({})".format(str(e))
+        )
+
+    task = asyncio.create_task(wiapi_track_job(id))
+    job_tasks.add(task)
+    task.add_done_callback(job_tasks.discard)
 
     return WiapiResponse(
         success=True,
@@ -170,7 +479,8 @@ async def _interfaces_deauth(request: Request, deauth: WiapiDeauth, admin_requir
                     'bssid': bssid,
                     'start': start,
                     'packets': packets,
-                    'delay': delay
+                    'delay': delay,
+                    'state': 'running'
                 }
             }
         }
@@ -178,32 +488,363 @@ async def _interfaces_deauth(request: Request, deauth: WiapiDeauth, admin_requir
 
 @wiapi.post('/scan')
 @wiapi_auth_required
-async def _scan(request: Request, scan_info: WiapiInterface) -> WiapiResponse:
+async def _scan(request: Request, scan_info: WiapiScan) -> WiapiResponse:
+    global snapshot_checked
+
+    interfaces = [tuple(i) if isinstance(i, list) else i for i in scan_info.interfaces] or [scan_info.interface]
+    names = [i[0] if isinstance(i, tuple) else i for i in interfaces if i]
+
+    # Filtering, sorting and paging run against the C AP table indexes, only the page becomes Python objects
+    query = {
+        'ssid': scan_info.ssid,
+        'match': scan_info.match,
+        'bssid': scan_info.bssid,
+        'band': scan_info.band or None,
+        'channel': scan_info.channel,
+        'security': scan_info.security or None,
+        'sort': scan_info.sort,
+        'order': scan_info.order,
+        'offset': scan_info.offset,
+        'limit': scan_info.limit
+    }
+
+    if scan_info.min_rssi is not None:
+        query['min_rssi'] = scan_info.min_rssi
+
+    snap, info = wiapi_snapshot()
+    wb = WiapiDatabase()
+
+    # Scanning a radio the daemon is sweeping would take it off-channel under it
+    if info is not None and (not names or set(names) & set(info['radios'])):
+        owned = sorted(set(names) & set(info['radios'])) or info['radios']
+
+        if snap is None:
+            raise WiapiHTTPException(
+                status_code=503,
+                detail="Sensor daemon owns {} but has no fresh snapshot to serve".format(', '.join(owned))
+            )
+
+        if not set(names) <= set(info['radios']):
+            raise WiapiHTTPException(
+                status_code=409,
+                detail="Sensor daemon owns {}, request its radios and the others separately".format(', '.join(owned))
+            )
+
     try:
-        w = wipi.scanner(scan_info.interface)
-        aps = w.scan()
-        ap_list = [
-            {
-                'ssid': ap.ssid,
-                'bssid': ap.bssid,
-                'stats': ap.stats,
-                'frequency': ap.frequency,
-                'quality': ap.quality,
-                'db': ap.db,
-                'channel': ap.channel
-            }
+        # The sensor daemon owns these radios, serve its latest sweep instead of scanning
+        if snap is not None and set(names) <= set(info['radios']):
+            if snapshot_checked != (info['pid'], info['generation']):
+                rogue.check(snap)
+                snapshot_checked = (info['pid'], info['generation'])
 
-            for ap in aps
-        ]
+            # The whole table with no capture running to annotate it is the body the daemon already encoded
+            if not captures and not wb.get_captures() and set(names) in (set(), set(info['radios'])) and query == WIAPI_SCAN_ALL:
+                fmt, media_type = wiapi_body_format(request)
+                body = snap.body('aps', fmt)
+
+                if body is not None:
+                    return Response(content=body, media_type=media_type)
+
+            total, aps = snap.query(radios=names or None, **query)
+        else:
+            w = wipi.scanner_group(interfaces, scan_info.policy)
+
+            await asyncio.to_thread(w.scan)
+            rogue.check(w)
+
+            total, aps = w.query(**query)
+    except ValueError as e:
+        raise WiapiHTTPException(
+            status_code=400,
+            detail="Bad request ({})".format(str(e))
+        )
+    except:
+        raise WiapiHTTPException(
+            status_code=400,
+            detail="Could not initialize scanner with device specified ({})".format(', '.join(map(str, interfaces)))
+        )
+
+    airtime.annotate(aps)
+    timing.annotate(aps)
+
+    ap_list = [
+        {
+            'ssid': ap.ssid,
+            'bssid': ap.bssid,
+            'vendor': ap.vendor,
+            'stats': ap.stats,
+            'frequency': ap.frequency,
+            'quality': ap.quality,
+            'db': ap.db,
+            'channel': ap.channel,
+            'band': ap.band,
+            'radio': ap.radio,
+            'radios': ap.radios,
+            'security': ap.security,
+            'capabilities': ap.capabilities,
+            'airtime': ap.airtime,
+            'utilization': ap.utilization
+        }
+
+        for ap in aps
+    ]
+
+    wiapi_annotate_shared(wb, ap_list)
+
+    return WiapiResponse(
+        success=True,
+        data={ 'message': ap_list, 'total': total }
+    )
+
+@wiapi.get('/capture')
+@wiapi_auth_required
+async def _capture(request: Request) -> WiapiResponse:
+    wb = WiapiDatabase()
+
+    # Other workers' captures as of their last sync, this worker's as they are now
+    stats = { iface: st for iface, owner, start, st, stop in wb.get_captures() if st is not None }
+    stats.update({ iface: c.stats() for iface, c in captures.items() })
+
+    return WiapiResponse(
+        success=True,
+        data={ 'message': stats }
+    )
+
+@wiapi.post('/capture/start')
+@wiapi_auth_required(admin=True)
+@wiapi_verify_interface
+async def _capture_start(request: Request, capture: WiapiCapture) -> WiapiResponse:
+    wb = WiapiDatabase()
+
+    # Claimed in the database first, so two workers cannot both open the radio
+    if capture.interface in captures or not wb.claim_capture(capture.interface, int(time.time())):
+        raise WiapiHTTPException(
+            status_code=400,
+            detail='Bad request (already capturing on {})'.format(capture.interface)
+        )
+
+    try:
+        directory = wiapi_capture_path(capture.directory, capture.prefix) if capture.directory else None
+    except ValueError as e:
+        wb.drop_capture(capture.interface)
+
+        raise WiapiHTTPException(
+            status_code=400,
+            detail="Bad request ({})".format(str(e))
+        )
+
+    try:
+        c = wipi.capture(capture.interface, capture.filter)
+
+        if directory:
+            c.record(directory, capture.prefix, capture.file_size, capture.file_seconds, capture.budget)
+
+        rogue.watch(c)
+        flood.watch(c)
+        airtime.watch(c)
+        timing.watch(c)
+        c.start()
+    except Exception as e:
+        wb.drop_capture(capture.interface)
+
+        raise WiapiHTTPException(
+            status_code=400,
+            detail="Could not start capture on {} ({})".format(capture.interface, str(e))
+        )
+
+    captures[capture.interface] = c
+    wb.update_capture(capture.interface, c.stats())
+
+    return WiapiResponse(
+        success=True,
+        data={ 'message': c.stats() }
+    )
+
+@wiapi.post('/capture/stop')
+@wiapi_auth_required(admin=True)
+@wiapi_verify_interface
+async def _capture_stop(request: Request, interface: WiapiInterface) -> WiapiResponse:
+    wb = WiapiDatabase()
+    c = captures.pop(interface.interface, None)
+
+    if c is not None:
+        await asyncio.to_thread(c.stop)
+        wb.drop_capture(interface.interface)
 
         return WiapiResponse(
             success=True,
-            data={ 'message': ap_list }
+            data={ 'message': c.stats() }
         )
-    except:
+
+    row = wb.get_capture(interface.interface)
+
+    if row is None or row[4] >= 2 or not wiapi_alive(row[1]):
+        raise WiapiHTTPException(
+            status_code=400,
+            detail='Bad request (not capturing on {})'.format(interface.interface)
+        )
+
+    # Another worker runs it, ask it to stop and wait for its final stats
+    wb.stop_capture(interface.interface)
+
+    for _ in range(50):
+        await asyncio.sleep(0.1)
+
+        row = wb.get_capture(interface.interface)
+
+        if row is None or row[4] >= 2:
+            break
+    else:
+        raise WiapiHTTPException(
+            status_code=504,
+            detail='Worker capturing on {} did not stop in time'.format(interface.interface)
+        )
+
+    wb.drop_capture(interface.interface)
+
+    return WiapiResponse(
+        success=True,
+        data={ 'message': row[3] if row else None }
+    )
+
+@wiapi.get('/rogue/alerts')
+@wiapi_auth_required
+async def _rogue_alerts(request: Request, since: int=0) -> WiapiResponse:
+    wb = WiapiDatabase()
+    wiapi_share_alerts(wb)
+
+    alerts = wb.get_alerts('rogue', since)
+    stats = wiapi_merge_stats(rogue.stats(), wb.get_published('rogue'), wb.last_alert('rogue'))
+
+    return WiapiResponse(
+        success=True,
+        data={ 'message': { 'alerts': alerts, 'stats': stats } }
+    )
+
+@wiapi.post('/rogue/allow')
+@wiapi_auth_required(admin=True)
+async def _rogue_allow(request: Request, allow: WiapiAllow) -> WiapiResponse:
+    try:
+        rogue.allow(allow.bssid, allow.ssid, allow.security, allow.channel)
+    except ValueError as e:
         raise WiapiHTTPException(
             status_code=400,
-            detail="Could not initialize scanner with device specified ({})".format(scan_info.interface)
+            detail="Bad request ({})".format(str(e))
         )
 
+    # The other workers pick it up on their next sync
+    wb = WiapiDatabase()
+    wb.add_allow(allow.bssid, allow.ssid, allow.security, allow.channel)
+
+    return WiapiResponse()
+
+@wiapi.get('/flood/alerts')
+@wiapi_auth_required
+async def _flood_alerts(request: Request, since: int=0) -> WiapiResponse:
+    wb = WiapiDatabase()
+    wiapi_share_alerts(wb)
+
+    alerts = wb.get_alerts('flood', since)
+    stats = wiapi_merge_stats(flood.stats(), wb.get_published('flood'), wb.last_alert('flood'))
+
+    return WiapiResponse(
+        success=True,
+        data={ 'message': { 'alerts': alerts, 'stats': stats } }
+    )
+
+def wiapi_airtime_view(wb):
+    others = wb.get_published('airtime')
+
+    return {
+        'channels': wiapi_merge(airtime.channels(), [o['channels'] for o in others], 'frequency', 'frames'),
+        'bss': wiapi_merge(airtime.bss(), [o['bss'] for o in others], 'bssid', 'frames'),
+        'stats': wiapi_merge_stats(airtime.stats(), [o['stats'] for o in others])
+    }
+
+def wiapi_timing_view(wb):
+    others = wb.get_published('timing')
+
+    return {
+        'bss': wiapi_merge(timing.bss(), [o['bss'] for o in others], 'bssid', 'beacons'),
+        'stats': wiapi_merge_stats(timing.stats(), [o['stats'] for o in others])
+    }
+
+def wiapi_annotate_shared(wb, ap_list):
+    # Fill in what captures running in other workers saw, this worker's own come first
+    air = wiapi_airtime_view(wb)
+    bss = { r['bssid'].upper(): r for r in air['bss'] }
+    channels = { r['frequency']: r for r in air['channels'] }
+    names = { r['bssid'].upper(): r['ssid'] for r in wiapi_timing_view(wb)['bss'] if r['ssid'] }
+
+    for ap in ap_list:
+        bssid = ap['bssid'].upper()
+        mhz = int(round(ap['frequency'] * 1000))   # scan results are in GHz
+
+        if ap['airtime'] is None and bssid in bss:
+            ap['airtime'] = bss[bssid]['busy']['10s']
+
+        if ap['utilization'] is None and mhz in channels:
+            ap['utilization'] = channels[mhz]['busy']['10s']
 
+        if not ap['ssid'] and bssid in names:
+            ap['ssid'] = names[bssid]
+
+@wiapi.get('/airtime')
+@wiapi_auth_required
+async def _airtime(request: Request) -> WiapiResponse:
+    return WiapiResponse(
+        success=True,
+        data={ 'message': wiapi_airtime_view(WiapiDatabase()) }
+    )
+
+@wiapi.get('/timing')
+@wiapi_auth_required
+async def _timing(request: Request) -> WiapiResponse:
+    return WiapiResponse(
+        success=True,
+        data={ 'message': wiapi_timing_view(WiapiDatabase()) }
+    )
+
+@wiapi.get('/jobs')
+@wiapi_auth_required
+async def _jobs(request: Request) -> WiapiResponse:
+    live = { job['id']: job for job in jobs.list() }
+    wb = WiapiDatabase()
+
+    return WiapiResponse(
+        success=True,
+        data={ 'message': [wiapi_job_dict(row, live.get(row[0])) for row in wb.get_job(all=True)] }
+    )
+
+@wiapi.delete('/jobs/{id}')
+@wiapi_auth_required(admin=True)
+async def _jobs_cancel(request: Request, id: int) -> WiapiResponse:
+    wb = WiapiDatabase()
+    row = wb.get_job(id)
+
+    if not row:
+        raise WiapiHTTPException(
+            status_code=404,
+            detail='Job {} does not exist'.format(id)
+        )
+
+    if jobs.cancel(id):
+        job = await asyncio.to_thread(jobs.wait, id, 1.0)
+        wb.update_job(id, job['sent'], job['state'], job['state'] != 'running')
+    elif row[0][9] != os.getpid() and wiapi_alive(row[0][9]) and wb.cancel_job(id):
+        # Another worker runs it and checks for a cancel each time it writes progress back
+        for _ in range(30):
+            await asyncio.sleep(0.1)
+
+            if wb.get_job(id)[0][8] != 'running':
+                break
+    else:
+        raise WiapiHTTPException(
+            status_code=400,
+            detail='Bad request (job {} is not running)'.format(id)
+        )
+
+    return WiapiResponse(
+        success=True,
+        data={ 'message': wiapi_job_dict(wb.get_job(id)[0]) }
+    )
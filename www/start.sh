@@ -1,3 +1,14 @@
 #!/bin/bash
 
-sudo uvicorn main:wiapi --reload --host 0.0.0.0 --port 443 --ssl-keyfile keys/ssl_priv.pem --ssl-certfile keys/ssl_cert.crt
+# One scanner per radio, e.g. WIPI_RADIOS="wlan0 wlan1" ./start.sh
+if [ -n "$WIPI_RADIOS" ]; then
+	sudo ../src/wipi-sensord $(printf -- '-i %s ' $WIPI_RADIOS) &
+fi
+
+# Workers share jobs, captures and detector state through the database, e.g. WIPI_WORKERS=4 ./start.sh
+# (--reload only runs with a single worker)
+if [ -n "$WIPI_WORKERS" ]; then
+	sudo uvicorn main:wiapi --workers "$WIPI_WORKERS" --host 0.0.0.0 --port 443 --ssl-keyfile keys/ssl_priv.pem --ssl-certfile keys/ssl_cert.crt
+else
+	sudo uvicorn main:wiapi --reload --host 0.0.0.0 --port 443 --ssl-keyfile keys/ssl_priv.pem --ssl-certfile keys/ssl_cert.crt
+fi
@@ -47,13 +47,16 @@ class WiapiJWT(object):
 
         return jws
 
-def auth_required(func):
+def auth_required(func=None, *, admin=False):
+    # @auth_required, or @auth_required(admin=True) for routes only admins may use
+    if func is None:
+        return lambda f: auth_required(f, admin=admin)
+
     @wraps(func)
 
     async def wrapper(*args, **kwargs):
         try:
             request = kwargs[list(filter(lambda r: type(kwargs[r]) == Request, kwargs.keys()))[0]]
-            admin_required = kwargs.get('admin_required', False)
 
             jwt_token = request.headers.get('Authorization', False)
 
@@ -71,7 +74,7 @@ def auth_required(func):
                     detail='Access token has expired'
                 )
 
-            if admin_required and not message['admin']:
+            if admin and not message['admin']:
                 raise Exception()
         except WiapiHTTPException as e:
             raise e
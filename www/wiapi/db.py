@@ -1,12 +1,59 @@
 import sqlite3
 import hashlib
+import json
+import os
+
+# State every API worker shares: jobs and their cancel requests, captures and
+# their stop requests, the rogue allow-list, detector alerts and the views each
+# worker publishes of the captures it runs
+WIAPI_SHARED_TABLES = [
+    "CREATE TABLE IF NOT EXISTS captures(interface TEXT PRIMARY KEY, owner INTEGER NOT NULL, start INTEGER, stats TEXT, stop INTEGER DEFAULT 0)",
+    "CREATE TABLE IF NOT EXISTS allow(id INTEGER PRIMARY KEY AUTOINCREMENT, bssid TEXT NOT NULL, ssid TEXT, security TEXT, channel INTEGER DEFAULT 0)",
+    "CREATE TABLE IF NOT EXISTS alerts(id INTEGER PRIMARY KEY AUTOINCREMENT, kind TEXT NOT NULL, owner INTEGER, data TEXT NOT NULL)",
+    "CREATE TABLE IF NOT EXISTS published(owner INTEGER NOT NULL, name TEXT NOT NULL, data TEXT NOT NULL, PRIMARY KEY(owner, name))"
+]
+
+WIAPI_ALERTS_KEPT = 1024
+
+def wiapi_alive(pid) -> bool:
+    # Rows left behind by a worker that has exited belong to nobody
+    if not pid:
+        return False
+
+    try:
+        os.kill(pid, 0)
+    except ProcessLookupError:
+        return False
+    except PermissionError:
+        pass
+
+    return True
 
 class WiapiDatabase(object):
     def __init__(self, path="db/wiapi.db"):
         self.path = path
-        self.conn = sqlite3.connect(self.path)
+        self.conn = sqlite3.connect(self.path, timeout=10)
         self.cur = self.conn.cursor()
 
+        # Databases created before job tracking lack the progress and ownership columns
+        try:
+            columns = [c[1] for c in self.cur.execute("PRAGMA table_info(jobs)").fetchall()]
+
+            if columns and 'sent' not in columns:
+                self.cur.execute("ALTER TABLE jobs ADD COLUMN sent INTEGER DEFAULT 0")
+                self.cur.execute("ALTER TABLE jobs ADD COLUMN state TEXT")
+
+            if columns and 'owner' not in columns:
+                self.cur.execute("ALTER TABLE jobs ADD COLUMN owner INTEGER")
+                self.cur.execute("ALTER TABLE jobs ADD COLUMN cancel INTEGER DEFAULT 0")
+
+            for table in WIAPI_SHARED_TABLES:
+                self.cur.execute(table)
+
+            self.conn.commit()
+        except:
+            pass
+
     def clear(self):
         try:
             self.cur.execute("DROP TABLE users")
@@ -18,8 +65,14 @@ class WiapiDatabase(object):
         except:
             pass
 
+        for table in ('captures', 'allow', 'alerts', 'published'):
+            self.cur.execute("DROP TABLE IF EXISTS {}".format(table))
+
         self.cur.execute("CREATE TABLE users(id INTEGER PRIMARY KEY AUTOINCREMENT, username TEXT NOT NULL UNIQUE, password TEXT NOT NULL, admin INTEGER)")
-        self.cur.execute("CREATE TABLE jobs(id INTEGER PRIMARY KEY AUTOINCREMENT, interface TEXT NOT NULL, bssid TEXT NOT NULL, start INTEGER, packets INTEGER NOT NULL, delay INTEGER NOT NULL, complete INTEGER)")
+        self.cur.execute("CREATE TABLE jobs(id INTEGER PRIMARY KEY AUTOINCREMENT, interface TEXT NOT NULL, bssid TEXT NOT NULL, start INTEGER, packets INTEGER NOT NULL, delay INTEGER NOT NULL, complete INTEGER, sent INTEGER DEFAULT 0, state TEXT, owner INTEGER, cancel INTEGER DEFAULT 0)")
+
+        for table in WIAPI_SHARED_TABLES:
+            self.cur.execute(table)
 
         self.conn.commit()
 
@@ -40,31 +93,177 @@ class WiapiDatabase(object):
 
         return False
 
-    def add_job(self, interface: str, bssid: str, start: int, packets: int, delay: int):
+    def add_job(self, interface: str, bssid: str, start: int, packets: int, delay: int, max_jobs: int=0):
+        # Counting and inserting in one write transaction keeps the cap across every worker
+        self.cur.execute("BEGIN IMMEDIATE")
+
         try:
+            if max_jobs:
+                running = self.cur.execute("SELECT owner FROM jobs WHERE state='running'").fetchall()
+
+                if sum(1 for (owner,) in running if wiapi_alive(owner)) >= max_jobs:
+                    self.conn.rollback()
+
+                    return None
+
             self.cur.execute(
-                "INSERT INTO jobs(interface, bssid, start, packets, delay, complete) VALUES(?, ?, ?, ?, ?, ?)",
-                (interface, bssid, start, packets, delay, 0,)
+                "INSERT INTO jobs(interface, bssid, start, packets, delay, complete, sent, state, owner, cancel) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+                (interface, bssid, start, packets, delay, 0, 0, 'running', os.getpid(), 0,)
             )
 
             self.conn.commit()
-            self.cur.execute("SELECT * FROM jobs ORDER BY start DESC LIMIT 1")
+        except Exception as e:
+            self.conn.rollback()
+            raise e
 
-            return self.cur.fetchall()
+        self.cur.execute("SELECT * FROM jobs WHERE id=?", (self.cur.lastrowid,))
+
+        return self.cur.fetchall()
+
+    def update_job(self, id: int, sent: int, state: str, complete: bool=False):
+        self.cur.execute(
+            "UPDATE jobs SET sent=?, state=?, complete=? WHERE id=?",
+            (sent, state, 1 if complete else 0, id,)
+        )
+
+        self.conn.commit()
+
+    def cancel_job(self, id: int):
+        # Picked up by the worker running the job, see wiapi_track_job()
+        self.cur.execute("UPDATE jobs SET cancel=1 WHERE id=? AND state='running'", (id,))
+        self.conn.commit()
+
+        return self.cur.rowcount > 0
+
+    def claim_capture(self, interface: str, start: int) -> bool:
+        # Same as add_job(), the check and the claim are one write transaction
+        self.cur.execute("BEGIN IMMEDIATE")
+
+        try:
+            row = self.cur.execute("SELECT owner, stop FROM captures WHERE interface=?", (interface,)).fetchone()
+
+            if row is not None and row[1] < 2 and wiapi_alive(row[0]):
+                self.conn.rollback()
+
+                return False
+
+            self.cur.execute(
+                "INSERT OR REPLACE INTO captures(interface, owner, start, stats, stop) VALUES(?, ?, ?, ?, ?)",
+                (interface, os.getpid(), start, None, 0,)
+            )
+
+            self.conn.commit()
         except Exception as e:
+            self.conn.rollback()
             raise e
 
-        return None
+        return True
+
+    def update_capture(self, interface: str, stats: dict, stop: int=None):
+        if stop is None:
+            self.cur.execute("UPDATE captures SET stats=? WHERE interface=? AND owner=?", (json.dumps(stats), interface, os.getpid(),))
+        else:
+            self.cur.execute("UPDATE captures SET stats=?, stop=? WHERE interface=? AND owner=?", (json.dumps(stats), stop, interface, os.getpid(),))
+
+        self.conn.commit()
+
+    def stop_capture(self, interface: str):
+        self.cur.execute("UPDATE captures SET stop=1 WHERE interface=? AND stop=0", (interface,))
+        self.conn.commit()
+
+        return self.cur.rowcount > 0
+
+    def drop_capture(self, interface: str):
+        self.cur.execute("DELETE FROM captures WHERE interface=?", (interface,))
+        self.conn.commit()
+
+    def get_captures(self):
+        # interface, owner, start, stats, stop - live captures only
+        rows = self.cur.execute("SELECT * FROM captures").fetchall()
+
+        return [(i, o, s, json.loads(st) if st else None, stop) for i, o, s, st, stop in rows if stop < 2 and wiapi_alive(o)]
+
+    def get_capture(self, interface: str):
+        row = self.cur.execute("SELECT * FROM captures WHERE interface=?", (interface,)).fetchone()
+
+        if row is None:
+            return None
+
+        i, o, s, st, stop = row
+
+        return (i, o, s, json.loads(st) if st else None, stop)
+
+    def add_allow(self, bssid: str, ssid: str, security: str, channel: int) -> int:
+        self.cur.execute(
+            "INSERT INTO allow(bssid, ssid, security, channel) VALUES(?, ?, ?, ?)",
+            (bssid, ssid, security, channel,)
+        )
+
+        self.conn.commit()
+
+        return self.cur.lastrowid
+
+    def get_allow(self, since: int=0):
+        return self.cur.execute("SELECT * FROM allow WHERE id>? ORDER BY id", (since,)).fetchall()
+
+    def add_alerts(self, kind: str, alerts: list):
+        self.cur.executemany(
+            "INSERT INTO alerts(kind, owner, data) VALUES(?, ?, ?)",
+            [(kind, os.getpid(), json.dumps(alert),) for alert in alerts]
+        )
+
+        # Keep as many as a detector's own ring does, and a few more
+        self.cur.execute(
+            "DELETE FROM alerts WHERE kind=? AND id < (SELECT id FROM alerts WHERE kind=? ORDER BY id DESC LIMIT 1 OFFSET ?)",
+            (kind, kind, WIAPI_ALERTS_KEPT,)
+        )
+
+        self.conn.commit()
+
+    def last_alert(self, kind: str) -> int:
+        row = self.cur.execute("SELECT MAX(id) FROM alerts WHERE kind=?", (kind,)).fetchone()
+
+        return row[0] or 0
+
+    def get_alerts(self, kind: str, since: int=0, limit: int=256):
+        rows = self.cur.execute(
+            "SELECT id, data FROM alerts WHERE kind=? AND id>? ORDER BY id DESC LIMIT ?",
+            (kind, since, limit,)
+        ).fetchall()
 
-    def get_job(id=0, all=False):
+        # Alert ids are the shared row ids, so since works whichever worker raised it
+        return [dict(json.loads(data), id=id) for id, data in reversed(rows)]
+
+    def publish(self, name: str, data):
+        self.cur.execute(
+            "INSERT OR REPLACE INTO published(owner, name, data) VALUES(?, ?, ?)",
+            (os.getpid(), name, json.dumps(data),)
+        )
+
+        # Workers that have exited stop counting towards merged views
+        owners = self.cur.execute("SELECT DISTINCT owner FROM published").fetchall()
+        dead = [(owner,) for (owner,) in owners if not wiapi_alive(owner)]
+
+        if dead:
+            self.cur.executemany("DELETE FROM published WHERE owner=?", dead)
+
+        self.conn.commit()
+
+    def get_published(self, name: str):
+        # What every other live worker last published under name
+        rows = self.cur.execute("SELECT owner, data FROM published WHERE name=?", (name,)).fetchall()
+
+        return [json.loads(data) for owner, data in rows if owner != os.getpid() and wiapi_alive(owner)]
+
+    def get_job(self, id=0, all=False):
         if all:
-            self.cur.execute("SELECT * FROM jobs")
+            self.cur.execute("SELECT * FROM jobs ORDER BY id DESC")
 
-            return cur.fetchall()
+            return self.cur.fetchall()
 
         self.cur.execute("SELECT * FROM jobs WHERE id=?", (id,))
 
-        return cur.fetchall()
+        return self.cur.fetchall()
 
     def check_credentials(self, username, password, digest=True) -> list:
         password = password if not digest else hashlib.sha256(password.encode()).digest()
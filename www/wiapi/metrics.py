@@ -0,0 +1,52 @@
+import math
+
+PROMETHEUS_CONTENT_TYPE = 'text/plain; version=0.0.4; charset=utf-8'
+
+def _le(bound: float) -> str:
+    return '+Inf' if math.isinf(bound) else repr(bound)
+
+def wiapi_prometheus(stats: dict, prefix: str='wipi_') -> str:
+    lines = []
+
+    for name, value in stats['counters'].items():
+        lines.append('# TYPE {}{} counter'.format(prefix, name))
+        lines.append('{}{} {}'.format(prefix, name, value))
+
+    for name, hist in stats['histograms'].items():
+        lines.append('# TYPE {}{} histogram'.format(prefix, name))
+
+        cumulative = 0
+
+        for bound, count in hist['buckets']:
+            cumulative += count
+            lines.append('{}{}_bucket{{le="{}"}} {}'.format(prefix, name, _le(bound), cumulative))
+
+        lines.append('{}{}_sum {}'.format(prefix, name, hist['sum']))
+        lines.append('{}{}_count {}'.format(prefix, name, hist['count']))
+
+    return '\n'.join(lines) + '\n'
+
+def wiapi_prometheus_cadence(cadence: dict, prefix: str='wipi_') -> str:
+    gauges = [
+        ('scan_interval_seconds', cadence['interval'] / 1000),
+        ('scan_interval_min_seconds', cadence['min'] / 1000),
+        ('scan_interval_max_seconds', cadence['max'] / 1000),
+        ('scan_churn', cadence['churn']),
+        ('scan_bssids_added', cadence['added']),
+        ('scan_bssids_lost', cadence['lost']),
+        ('scan_rssi_change_db', cadence['rssi_rms']),
+        ('scan_consecutive_failures', cadence['failures'])
+    ]
+
+    lines = []
+
+    for name, value in gauges:
+        lines.append('# TYPE {}{} gauge'.format(prefix, name))
+        lines.append('{}{} {}'.format(prefix, name, value))
+
+    lines.append('# TYPE {}scan_cadence_decisions_total counter'.format(prefix))
+
+    for decision, count in cadence['decisions'].items():
+        lines.append('{}scan_cadence_decisions_total{{decision="{}"}} {}'.format(prefix, decision, count))
+
+    return '\n'.join(lines) + '\n'
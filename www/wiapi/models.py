@@ -15,9 +15,40 @@ class WiapiInterface(BaseModel):
     interface: str
     active: bool=True
 
+class WiapiScan(BaseModel):
+    interface: str=None
+    interfaces: list=[]
+    policy: str='strongest'
+    security: list=[]
+    ssid: str=None
+    match: str='prefix'
+    bssid: str=None
+    band: list=[]
+    channel: int=0
+    min_rssi: int=None
+    sort: str='none'
+    order: str='asc'
+    offset: int=0
+    limit: int=0
+
 class WiapiDeauth(BaseModel):
     interface: str
     bssid: str
     channel: int
     packets: int=200
     delay: int=200
+
+class WiapiCapture(BaseModel):
+    interface: str
+    filter: str=None
+    directory: str=None
+    prefix: str='wipi'
+    file_size: int=0
+    file_seconds: int=0
+    budget: int=0
+
+class WiapiAllow(BaseModel):
+    bssid: str
+    ssid: str=None
+    security: str=None
+    channel: int=0